@@ -333,6 +333,11 @@ protected:
   /// algorithm
   virtual const std::string workspaceMethodOnTypes() const { return ""; }
 
+  /// Returns true if the base processGroups() may execute this algorithm on
+  /// the members of the group(s) at the same time, i.e. if concurrent
+  /// instances of it share no state beyond the ADS
+  virtual bool canProcessGroupEntriesInParallel() const { return false; }
+
   void cacheWorkspaceProperties();
 
   friend class AlgorithmProxy;
@@ -379,7 +384,7 @@ protected:
 
   friend class WorkspaceHistory; // Allow workspace history loading to adjust
                                  // g_execCount
-  static size_t
+  static std::atomic<size_t>
       g_execCount; ///< Counter to keep track of algorithm execution order
 
   virtual void setOtherProperties(IAlgorithm *alg,
@@ -429,6 +434,12 @@ private:
   bool executeAsyncImpl(const Poco::Void &i);
 
   bool doCallProcessGroups(Mantid::Types::Core::DateAndTime &start_time);
+  boost::shared_ptr<Algorithm>
+  createGroupEntryAlgorithm(const size_t entry, const double startProgress,
+                            const double endProgress,
+                            std::vector<std::string> &outputWSNames);
+  void executeGroupEntry(IAlgorithm &alg, const size_t entry) const;
+  bool processGroupEntriesInParallel() const;
 
   // Report that the algorithm has completed.
   void reportCompleted(const double &duration,
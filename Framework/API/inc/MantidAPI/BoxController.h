@@ -9,6 +9,7 @@
 #include <nexus/NeXusFile.hpp>
 
 #include <boost/optional.hpp>
+#include <atomic>
 #include <numeric>
 #include <vector>
 
@@ -67,7 +68,7 @@ public:
 
   //-----------------------------------------------------------------------------------
   /** @return the next available box Id.
-   * Call when creating a MDBox to give it an ID. */
+   * Call when creating a MDBox to give it an ID. This is thread-safe. */
   size_t getNextId() { return m_maxId++; }
 
   //-----------------------------------------------------------------------------------
@@ -83,7 +84,9 @@ public:
   void setMaxId(size_t newMaxId) { m_maxId = newMaxId; }
 
   //-----------------------------------------------------------------------------------
-  /** @return the mutex for avoiding simultaneous assignments of box Ids. */
+  /** @return the mutex for avoiding simultaneous assignments of box Ids.
+   * Ids are assigned atomically, so the mutex is only needed by code that
+   * must keep other threads from assigning Ids for a while. */
   inline std::mutex &getIdMutex() { return m_idMutex; }
 
   //-----------------------------------------------------------------------------------
@@ -435,8 +438,9 @@ private:
   size_t nd;
 
   /** The maximum ID number of any boxes in the workspace (not inclusive,
-   * i.e. maxId = 100 means there the highest ID number is 99.  */
-  size_t m_maxId;
+   * i.e. maxId = 100 means there the highest ID number is 99.
+   * It is atomic so that boxes can be created by many threads at once. */
+  std::atomic<size_t> m_maxId;
 
   /// Splitting threshold
   size_t m_SplitThreshold;
@@ -34,6 +34,10 @@ public:
   virtual CoordTransform *clone() const = 0;
   virtual std::string id() const = 0;
 
+  /// Apply the transformation to several vectors at once
+  virtual void applyBlock(const coord_t *inputVectors, coord_t *outVectors,
+                          const size_t numVectors) const;
+
   /// Wrapper for VMD
   Mantid::Kernel::VMD applyVMD(const Mantid::Kernel::VMD &inputVector) const;
 
@@ -11,8 +11,10 @@
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UsageService.h"
 
@@ -30,7 +32,9 @@
 
 #include <json/json.h>
 
+#include <exception>
 #include <map>
+#include <mutex>
 
 // Index property handling template definitions
 #include "MantidAPI/Algorithm.tcc"
@@ -83,7 +87,7 @@ template MANTID_API_DLL bool Algorithm::isEmpty<std::size_t>(const std::size_t);
 //=============================================================================================
 
 /// Initialize static algorithm counter
-size_t Algorithm::g_execCount = 0;
+std::atomic<size_t> Algorithm::g_execCount(0);
 
 /// Constructor
 Algorithm::Algorithm()
@@ -538,12 +542,15 @@ bool Algorithm::execute() {
   }
   const float timingInputValidation = timer.elapsed(resetTimer);
 
+  // The execution number of this run, taken once so that algorithms running
+  // at the same time, e.g. on the members of a group, record their own
+  size_t execCount = 0;
   if (trackingHistory()) {
     // count used for defining the algorithm execution order
     // If history is being recorded we need to count this as a separate
     // algorithm
     // as the history compares histories by their execution number
-    ++Algorithm::g_execCount;
+    execCount = ++Algorithm::g_execCount;
 
     // populate history record before execution so we can record child
     // algorithms in it
@@ -583,7 +590,7 @@ bool Algorithm::execute() {
       // which has failed
       if (trackingHistory() && m_history) {
         m_history->fillAlgorithmHistory(this, startTime, duration,
-                                        Algorithm::g_execCount);
+                                        execCount);
         fillHistory();
         linkHistoryWithLastChild();
       }
@@ -1306,7 +1313,11 @@ bool Algorithm::doCallProcessGroups(
  *
  * This should be called after checkGroups(), which sets up required members.
  * It goes through each member of the group(s), creates and sets an algorithm
- * for each and executes them one by one.
+ * for each and executes them one by one. If the algorithm allows it (see
+ * canProcessGroupEntriesInParallel()) and the MultiThreaded.ParallelGroups
+ * setting is on, the algorithms of the members are executed at the same time
+ * on a ThreadPool instead. Either way, the output groups list the outputs in
+ * the order of the members.
  *
  * If there are several group input workspaces, then the member of each group
  * is executed pair-wise.
@@ -1330,116 +1341,10 @@ bool Algorithm::processGroups() {
     }
   }
 
-  double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
-  // Go through each entry in the input group(s)
-  for (size_t entry = 0; entry < m_groupSize; entry++) {
-    // use create Child Algorithm that look like this one
-    Algorithm_sptr alg_sptr = this->createChildAlgorithm(
-        this->name(), progress_proportion * static_cast<double>(entry),
-        progress_proportion * (1 + static_cast<double>(entry)),
-        this->isLogging(), this->version());
-    // Don't make the new algorithm a child so that it's workspaces are stored
-    // correctly
-    alg_sptr->setChild(false);
-
-    alg_sptr->setRethrows(true);
-
-    IAlgorithm *alg = alg_sptr.get();
-    // Set all non-workspace properties
-    this->copyNonWorkspaceProperties(alg, int(entry) + 1);
-
-    std::string outputBaseName;
-
-    // ---------- Set all the input workspaces ----------------------------
-    for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
-      std::vector<Workspace_sptr> &thisGroup = m_groups[iwp];
-      if (!thisGroup.empty()) {
-        // By default (for a single group) point to the first/only workspace
-        Workspace_sptr ws = thisGroup[0];
-
-        if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
-          // Either: this is the single group
-          // OR: all inputs are groups
-          // ... so get then entry^th workspace in this group
-          ws = thisGroup[entry];
-        }
-        // Append the names together
-        if (!outputBaseName.empty())
-          outputBaseName += "_";
-        outputBaseName += ws->getName();
-
-        // Set the property using the name of that workspace
-        if (Property *prop =
-                dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
-          if (ws->getName().empty()) {
-            alg->setProperty(prop->name(), ws);
-          } else {
-            alg->setPropertyValue(prop->name(), ws->getName());
-          }
-        } else {
-          throw std::logic_error("Found a Workspace property which doesn't "
-                                 "inherit from Property.");
-        }
-      } // not an empty (i.e. optional) input
-    }   // for each InputWorkspace property
-
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
-    // ---------- Set all the output workspaces ----------------------------
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      if (Property *prop =
-              dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
-        // Default name = "in1_in2_out"
-        const std::string inName = prop->value();
-        if (inName.empty())
-          continue;
-        std::string outName;
-        if (m_groupsHaveSimilarNames) {
-          outName.append(inName).append("_").append(
-              Strings::toString(entry + 1));
-        } else {
-          outName.append(outputBaseName).append("_").append(inName);
-        }
-
-        auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
-                                      m_inputWorkspaceProps.end(),
-                                      WorkspacePropertyValueIs(inName));
-
-        // Overwrite workspaces in any input property if they have the same
-        // name as an output (i.e. copy name button in algorithm dialog used)
-        // (only need to do this for a single input, multiple will be handled
-        // by ADS)
-        if (inputProp != m_inputWorkspaceProps.end()) {
-          const auto &inputGroup =
-              m_groups[inputProp - m_inputWorkspaceProps.begin()];
-          if (!inputGroup.empty())
-            outName = inputGroup[entry]->getName();
-        }
-        // Except if all inputs had similar names, then the name is "out_1"
-
-        // Set in the output
-        alg->setPropertyValue(prop->name(), outName);
-
-        outputWSNames[owp] = outName;
-      } else {
-        throw std::logic_error(
-            "Found a Workspace property which doesn't inherit from Property.");
-      }
-    } // for each OutputWorkspace property
-
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry "
-          << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
-    }
-
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
+  // ------------ Fill in the output workspace group ------------------
+  // this has to be done after execute() because a workspace must exist
+  // when it is added to a group
+  auto addToOutputGroups = [&](const std::vector<std::string> &outputWSNames) {
     for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
       Property *prop =
           dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
@@ -1448,8 +1353,57 @@ bool Algorithm::processGroups() {
       // And add it to the output group
       outGroups[owp]->add(outputWSNames[owp]);
     }
+  };
+
+  const double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
+  if (processGroupEntriesInParallel()) {
+    std::vector<std::vector<std::string>> outputWSNames(m_groupSize);
+    // Set up all the algorithms here, as that uses the ADS, and only run them
+    // on the pool. The progress is reported as the entries complete, one
+    // thread at a time since progress() is not thread-safe.
+    std::vector<Algorithm_sptr> algs(m_groupSize);
+    for (size_t entry = 0; entry < m_groupSize; entry++)
+      algs[entry] =
+          createGroupEntryAlgorithm(entry, -1., -1., outputWSNames[entry]);
+
+    std::vector<std::exception_ptr> errors(m_groupSize);
+    std::mutex progressMutex;
+    size_t completed(0);
+    ThreadPool pool;
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      boost::function<void()> runEntry = [&, entry]() {
+        try {
+          executeGroupEntry(*algs[entry], entry);
+        } catch (...) {
+          errors[entry] = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(progressMutex);
+        progress(progress_proportion * static_cast<double>(++completed));
+      };
+      pool.schedule(new FunctionTask(runEntry));
+    }
+    pool.joinAll();
 
-  } // for each entry in each group
+    // Report the failure of the first entry that failed
+    for (const auto &error : errors) {
+      if (error)
+        std::rethrow_exception(error);
+    }
+    // Deterministic order: the outputs go in the groups by entry
+    for (const auto &names : outputWSNames)
+      addToOutputGroups(names);
+  } else {
+    // Go through each entry in the input group(s)
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      std::vector<std::string> outputWSNames;
+      auto alg = createGroupEntryAlgorithm(
+          entry, progress_proportion * static_cast<double>(entry),
+          progress_proportion * (1 + static_cast<double>(entry)),
+          outputWSNames);
+      executeGroupEntry(*alg, entry);
+      addToOutputGroups(outputWSNames);
+    }
+  }
 
   // restore group notifications
   for (auto &outGroup : outGroups) {
@@ -1459,6 +1413,149 @@ bool Algorithm::processGroups() {
   return true;
 }
 
+//--------------------------------------------------------------------------------------------
+/** Create the algorithm for one entry of the group(s), set up as a copy of
+ * this one with the workspaces of that entry.
+ *
+ * @param entry :: index of the entry in the group(s)
+ * @param startProgress :: progress of this algorithm at the start of the entry,
+ *        or -1 not to report the progress of the entry
+ * @param endProgress :: progress of this algorithm at the end of the entry
+ * @param outputWSNames :: set to the names of the output workspaces of the
+ *        entry, by output workspace property
+ * @return the algorithm, ready to execute
+ */
+Algorithm_sptr
+Algorithm::createGroupEntryAlgorithm(const size_t entry,
+                                     const double startProgress,
+                                     const double endProgress,
+                                     std::vector<std::string> &outputWSNames) {
+  // use create Child Algorithm that look like this one
+  Algorithm_sptr alg_sptr =
+      this->createChildAlgorithm(this->name(), startProgress, endProgress,
+                                 this->isLogging(), this->version());
+  // Don't make the new algorithm a child so that it's workspaces are stored
+  // correctly
+  alg_sptr->setChild(false);
+
+  alg_sptr->setRethrows(true);
+
+  IAlgorithm *alg = alg_sptr.get();
+  // Set all non-workspace properties
+  this->copyNonWorkspaceProperties(alg, int(entry) + 1);
+
+  std::string outputBaseName;
+
+  // ---------- Set all the input workspaces ----------------------------
+  for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
+    std::vector<Workspace_sptr> &thisGroup = m_groups[iwp];
+    if (!thisGroup.empty()) {
+      // By default (for a single group) point to the first/only workspace
+      Workspace_sptr ws = thisGroup[0];
+
+      if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
+        // Either: this is the single group
+        // OR: all inputs are groups
+        // ... so get then entry^th workspace in this group
+        ws = thisGroup[entry];
+      }
+      // Append the names together
+      if (!outputBaseName.empty())
+        outputBaseName += "_";
+      outputBaseName += ws->getName();
+
+      // Set the property using the name of that workspace
+      if (Property *prop =
+              dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
+        if (ws->getName().empty()) {
+          alg->setProperty(prop->name(), ws);
+        } else {
+          alg->setPropertyValue(prop->name(), ws->getName());
+        }
+      } else {
+        throw std::logic_error("Found a Workspace property which doesn't "
+                               "inherit from Property.");
+      }
+    } // not an empty (i.e. optional) input
+  }   // for each InputWorkspace property
+
+  outputWSNames.resize(m_pureOutputWorkspaceProps.size());
+  // ---------- Set all the output workspaces ----------------------------
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    if (Property *prop =
+            dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
+      // Default name = "in1_in2_out"
+      const std::string inName = prop->value();
+      if (inName.empty())
+        continue;
+      std::string outName;
+      if (m_groupsHaveSimilarNames) {
+        outName.append(inName).append("_").append(
+            Strings::toString(entry + 1));
+      } else {
+        outName.append(outputBaseName).append("_").append(inName);
+      }
+
+      auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
+                                    m_inputWorkspaceProps.end(),
+                                    WorkspacePropertyValueIs(inName));
+
+      // Overwrite workspaces in any input property if they have the same
+      // name as an output (i.e. copy name button in algorithm dialog used)
+      // (only need to do this for a single input, multiple will be handled
+      // by ADS)
+      if (inputProp != m_inputWorkspaceProps.end()) {
+        const auto &inputGroup =
+            m_groups[inputProp - m_inputWorkspaceProps.begin()];
+        if (!inputGroup.empty())
+          outName = inputGroup[entry]->getName();
+      }
+      // Except if all inputs had similar names, then the name is "out_1"
+
+      // Set in the output
+      alg->setPropertyValue(prop->name(), outName);
+
+      outputWSNames[owp] = outName;
+    } else {
+      throw std::logic_error(
+          "Found a Workspace property which doesn't inherit from Property.");
+    }
+  } // for each OutputWorkspace property
+
+  return alg_sptr;
+}
+
+/** Execute the algorithm of one entry of the group(s).
+ *
+ * @param alg :: the algorithm of the entry
+ * @param entry :: index of the entry in the group(s)
+ * @throw std::runtime_error if the algorithm fails
+ */
+void Algorithm::executeGroupEntry(IAlgorithm &alg, const size_t entry) const {
+  try {
+    alg.execute();
+  } catch (std::exception &e) {
+    std::ostringstream msg;
+    msg << "Execution of " << this->name() << " for group entry "
+        << (entry + 1) << " failed: ";
+    msg << e.what(); // Add original message
+    throw std::runtime_error(msg.str());
+  }
+}
+
+/**
+ * @return true if the entries of the group(s) should be run at the same time:
+ * the algorithm allows it and the MultiThreaded.ParallelGroups setting is on.
+ */
+bool Algorithm::processGroupEntriesInParallel() const {
+  if (m_groupSize < 2 || !canProcessGroupEntriesInParallel())
+    return false;
+  int enabled(0);
+  int retVal = Kernel::ConfigService::Instance().getValue(
+      "MultiThreaded.ParallelGroups", enabled);
+  return retVal > 0 && enabled > 0;
+}
+
 //--------------------------------------------------------------------------------------------
 /** Copy all the non-workspace properties from this to alg
  *
@@ -35,7 +35,7 @@ BoxController *BoxController::clone() const {
 
 /*Private Copy constructor used in cloning */
 BoxController::BoxController(const BoxController &other)
-    : nd(other.nd), m_maxId(other.m_maxId),
+    : nd(other.nd), m_maxId(other.m_maxId.load()),
       m_SplitThreshold(other.m_SplitThreshold),
       m_significantEventsNumber(other.m_significantEventsNumber),
       m_maxDepth(other.m_maxDepth), m_numEventsAtMax(other.m_numEventsAtMax),
@@ -116,10 +116,7 @@ BoxController::~BoxController() {
  * @returns initial ID to use in the range
  */
 size_t BoxController::claimIDRange(size_t range) {
-  std::lock_guard<std::mutex> lock(m_idMutex);
-  size_t tmp = m_maxId;
-  m_maxId += range;
-  return tmp;
+  return m_maxId.fetch_add(range);
 }
 /** Serialize to an XML string
  * @return XML string
@@ -33,6 +33,22 @@ CoordTransform::CoordTransform(const size_t inD, const size_t outD)
         "CoordTransform: invalid number of input dimensions!");
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to a block of input vectors. Subclasses can
+ * override this to process the whole block in one loop, which avoids a
+ * virtual call per vector and lets the compiler vectorize across vectors.
+ *
+ * @param inputVectors :: numVectors inD-length vectors, one after the other
+ * @param outVectors :: numVectors outD-length vectors, one after the other
+ * @param numVectors :: number of vectors to transform
+ */
+void CoordTransform::applyBlock(const coord_t *inputVectors,
+                                coord_t *outVectors,
+                                const size_t numVectors) const {
+  for (size_t i = 0; i < numVectors; ++i)
+    this->apply(inputVectors + i * inD, outVectors + i * outD);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Apply the transformation to an input vector (as a VMD type).
  * This wraps the apply(in,out) method (and will be slower!)
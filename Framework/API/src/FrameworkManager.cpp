@@ -9,6 +9,7 @@
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyManagerDataService.h"
+#include "MantidKernel/ThreadBudget.h"
 #include "MantidKernel/UsageService.h"
 
 #include <boost/algorithm/string/split.hpp>
@@ -18,6 +19,7 @@
 #include <Poco/ActiveResult.h>
 #include <tbb/task_scheduler_init.h>
 
+#include <algorithm>
 #include <clocale>
 #include <cstdarg>
 
@@ -176,6 +178,7 @@ void FrameworkManagerImpl::setNumOMPThreadsToConfigValue() {
 void FrameworkManagerImpl::setNumOMPThreads(const int nthreads) {
   g_log.debug() << "Setting maximum number of threads to " << nthreads << "\n";
   PARALLEL_SET_NUM_THREADS(nthreads);
+  Kernel::ThreadBudget::setLimit(static_cast<size_t>(std::max(nthreads, 1)));
   static tbb::task_scheduler_init m_init{nthreads};
 }
 
@@ -71,6 +71,30 @@ public:
 };
 DECLARE_ALGORITHM(StubbedWorkspaceAlgorithm)
 
+class ParallelGroupsAlgorithm : public StubbedWorkspaceAlgorithm {
+public:
+  const std::string name() const override { return "ParallelGroupsAlgorithm"; }
+
+protected:
+  bool canProcessGroupEntriesInParallel() const override { return true; }
+};
+DECLARE_ALGORITHM(ParallelGroupsAlgorithm)
+
+class FailingParallelGroupsAlgorithm : public ParallelGroupsAlgorithm {
+public:
+  const std::string name() const override {
+    return "FailingParallelGroupsAlgorithm";
+  }
+
+  void exec() override {
+    const std::string input = getPropertyValue("InputWorkspace1");
+    if (input == "A_3" || input == "A_6")
+      throw std::runtime_error("Cannot process " + input);
+    ParallelGroupsAlgorithm::exec();
+  }
+};
+DECLARE_ALGORITHM(FailingParallelGroupsAlgorithm)
+
 class StubbedWorkspaceAlgorithm2 : public Algorithm {
 public:
   StubbedWorkspaceAlgorithm2() : Algorithm() {}
@@ -792,6 +816,56 @@ public:
     TS_ASSERT_EQUALS(ws3->getTitle(), "A3+D3+D3");
   }
 
+  void test_processGroups_inParallel() {
+    Mantid::API::AnalysisDataService::Instance().clear();
+    auto &config = ConfigService::Instance();
+    const std::string key("MultiThreaded.ParallelGroups");
+    const std::string previous = config.getString(key);
+    config.setString(key, "1");
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4,A_5,A_6,A_7,A_8");
+
+    ParallelGroupsAlgorithm alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace1", "A");
+    alg.setPropertyValue("Number", "234");
+    alg.setPropertyValue("OutputWorkspace1", "D");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    config.setString(key, previous);
+    TS_ASSERT(alg.isExecuted());
+
+    auto group =
+        AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>("D");
+    TS_ASSERT_EQUALS(group->getNumberOfEntries(), 8);
+    for (int i = 0; i < group->getNumberOfEntries(); ++i) {
+      const auto entry = std::to_string(i + 1);
+      auto ws =
+          boost::dynamic_pointer_cast<MatrixWorkspace>(group->getItem(i));
+      TS_ASSERT_EQUALS(ws->getName(), "D_" + entry);
+      TS_ASSERT_EQUALS(ws->getTitle(), "A_" + entry + "++");
+      TS_ASSERT_EQUALS(ws->readY(0)[0], 234);
+    }
+  }
+
+  void test_processGroups_inParallel_reports_the_first_failure() {
+    Mantid::API::AnalysisDataService::Instance().clear();
+    auto &config = ConfigService::Instance();
+    const std::string key("MultiThreaded.ParallelGroups");
+    const std::string previous = config.getString(key);
+    config.setString(key, "1");
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4,A_5,A_6,A_7,A_8");
+
+    FailingParallelGroupsAlgorithm alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace1", "A");
+    alg.setPropertyValue("OutputWorkspace1", "D");
+    TS_ASSERT_THROWS_EQUALS(alg.execute(), const std::runtime_error &e,
+                            std::string(e.what()),
+                            "Execution of FailingParallelGroupsAlgorithm for "
+                            "group entry 3 failed: Cannot process A_3");
+    config.setString(key, previous);
+    TS_ASSERT(!alg.isExecuted());
+  }
+
   /**
    * Test declaring an algorithm property and retrieving as const
    * and non-const
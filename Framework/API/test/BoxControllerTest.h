@@ -2,10 +2,12 @@
 #define BOXPLITCONTROLLER_TEST_H
 
 #include "MantidKernel/DiskBuffer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidAPI/BoxController.h"
 #include "MantidAPI/IBoxControllerIO.h"
 #include "MantidTestHelpers/BoxControllerDummyIO.h"
 #include <cxxtest/TestSuite.h>
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <memory>
@@ -71,6 +73,20 @@ public:
     TS_ASSERT_EQUALS(sc.getMaxDepth(), 6);
   }
 
+  void test_IDs_from_many_threads_are_unique() {
+    BoxController sc(3);
+    std::vector<size_t> ids(2000);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 1000; i++) {
+      ids[2 * i] = sc.getNextId();
+      // The two IDs of a range are consecutive
+      ids[2 * i + 1] = sc.claimIDRange(2) + 1;
+    }
+    TS_ASSERT_EQUALS(sc.getMaxId(), 3000);
+    std::sort(ids.begin(), ids.end());
+    TS_ASSERT(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+  }
+
   void test_maxNumBoxes() {
     BoxController sc(3);
     sc.setSplitInto(10);
@@ -156,7 +156,7 @@ private:
       std::vector<Kernel::TimeSeriesProperty<bool> *> &bool_tsp_name_vector);
 
   template <typename TYPE>
-  void splitTimeSeriesProperty(
+  std::vector<std::unique_ptr<Kernel::Property>> splitTimeSeriesProperty(
       Kernel::TimeSeriesProperty<TYPE> *tsp,
       std::vector<Types::Core::DateAndTime> &split_datetime_vec,
       const int max_target_index);
@@ -81,6 +81,8 @@ protected:
   const std::string workspaceMethodInputProperty() const override {
     return "InputWorkspace";
   }
+  /// Each instance only works on its own input and output workspaces
+  bool canProcessGroupEntriesInParallel() const override { return true; }
 
   // Overridden Algorithm methods
   void init() override;
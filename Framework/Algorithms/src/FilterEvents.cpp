@@ -23,6 +23,7 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidKernel/make_unique.h"
 
 #include <memory>
 #include <sstream>
@@ -655,19 +656,46 @@ void FilterEvents::splitTimeSeriesLogs(
   if (m_useSplittersWorkspace)
     ++max_target_index;
 
-  // deal with integer time series property
-  for (const auto &int_tsp : int_tsp_vector) {
-    splitTimeSeriesProperty(int_tsp, split_datetime_vec, max_target_index);
-  }
-
-  // split double time series property
-  for (const auto &dbl_tsp : dbl_tsp_vector) {
-    splitTimeSeriesProperty(dbl_tsp, split_datetime_vec, max_target_index);
+  // split the integer, double and bool time series properties concurrently
+  const size_t num_int = int_tsp_vector.size();
+  const size_t num_dbl = dbl_tsp_vector.size();
+  const size_t num_logs = num_int + num_dbl + bool_tsp_vector.size();
+  std::vector<std::vector<std::unique_ptr<Kernel::Property>>> split_logs(
+      num_logs);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(num_logs); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto ilog = static_cast<size_t>(i);
+    if (ilog < num_int)
+      split_logs[ilog] = splitTimeSeriesProperty(
+          int_tsp_vector[ilog], split_datetime_vec, max_target_index);
+    else if (ilog < num_int + num_dbl)
+      split_logs[ilog] = splitTimeSeriesProperty(
+          dbl_tsp_vector[ilog - num_int], split_datetime_vec, max_target_index);
+    else
+      split_logs[ilog] = splitTimeSeriesProperty(
+          bool_tsp_vector[ilog - num_int - num_dbl], split_datetime_vec,
+          max_target_index);
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
-  // deal with bool time series property
-  for (const auto &bool_tsp : bool_tsp_vector) {
-    splitTimeSeriesProperty(bool_tsp, split_datetime_vec, max_target_index);
+  // assign to output workspaces, in the order of the logs
+  for (int tindex = 0; tindex <= max_target_index; ++tindex) {
+    // find output workspace
+    std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
+    wsiter = m_outputWorkspacesMap.find(tindex);
+    if (wsiter == m_outputWorkspacesMap.end()) {
+      // unable to find workspace associated with target index
+      g_log.information() << "Workspace target (" << tindex
+                          << ") does not have workspace associated."
+                          << "\n";
+    } else {
+      // add properties to the associated workspace
+      auto &run = wsiter->second->mutableRun();
+      for (auto &split_log : split_logs)
+        run.addProperty(std::move(split_log[tindex]), true);
+    }
   }
 
   // integrate proton charge
@@ -688,8 +716,16 @@ void FilterEvents::splitTimeSeriesLogs(
 }
 
 //----------------------------------------------------------------------------------------------
+/** Split a TimeSeriesProperty sample log. Only the log is touched, so that
+ * several logs can be split concurrently.
+ * @param tsp :: the log to split
+ * @param split_datetime_vec :: the boundaries of the splitters
+ * @param max_target_index :: the maximum target index of the outputs
+ * @return the split logs, indexed by target index
+ */
 template <typename TYPE>
-void FilterEvents::splitTimeSeriesProperty(
+std::vector<std::unique_ptr<Kernel::Property>>
+FilterEvents::splitTimeSeriesProperty(
     Kernel::TimeSeriesProperty<TYPE> *tsp,
     std::vector<Types::Core::DateAndTime> &split_datetime_vec,
     const int max_target_index) {
@@ -697,12 +733,14 @@ void FilterEvents::splitTimeSeriesProperty(
   // get property name and etc
   std::string property_name = tsp->name();
   // generate new propertys for the source to split to
+  std::vector<std::unique_ptr<Kernel::Property>> output_properties;
   std::vector<TimeSeriesProperty<TYPE> *> output_vector;
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
-    TimeSeriesProperty<TYPE> *new_property =
-        new TimeSeriesProperty<TYPE>(property_name);
+    auto new_property =
+        Kernel::make_unique<TimeSeriesProperty<TYPE>>(property_name);
     new_property->setUnits(tsp->units());
-    output_vector.push_back(new_property);
+    output_vector.push_back(new_property.get());
+    output_properties.push_back(std::move(new_property));
   }
 
   // duplicate the time series property if the size is just one
@@ -717,24 +755,7 @@ void FilterEvents::splitTimeSeriesProperty(
                            output_vector);
   }
 
-  // assign to output workspaces
-  for (int tindex = 0; tindex <= max_target_index; ++tindex) {
-    // find output workspace
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
-    wsiter = m_outputWorkspacesMap.find(tindex);
-    if (wsiter == m_outputWorkspacesMap.end()) {
-      // unable to find workspace associated with target index
-      g_log.information() << "Workspace target (" << tindex
-                          << ") does not have workspace associated."
-                          << "\n";
-    } else {
-      // add property to the associated workspace
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
-      ws_i->mutableRun().addProperty(output_vector[tindex], true);
-    }
-  }
-
-  return;
+  return output_properties;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 #include "MantidAPI/RefAxis.h"
 #include "MantidAPI/ScopedWorkspace.h"
 #include "MantidAPI/SpectraAxis.h"
+#include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAlgorithms/CreateWorkspace.h"
 #include "MantidAlgorithms/MaskBins.h"
@@ -14,6 +15,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidHistogramData/LinearGenerator.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidTestHelpers/ParallelAlgorithmCreation.h"
 #include "MantidTestHelpers/ParallelRunner.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
@@ -548,6 +550,45 @@ public:
                                      "Parallel::StorageMode::MasterOnly");
   }
 
+  void test_group_entries_in_parallel() {
+    auto &config = ConfigService::Instance();
+    const std::string key("MultiThreaded.ParallelGroups");
+    const std::string previous = config.getString(key);
+    config.setString(key, "1");
+    auto input = WorkspaceCreationHelper::createWorkspaceGroup(
+        8, 3, 10, "RebinTest_group");
+    for (int i = 0; i < input->getNumberOfEntries(); ++i) {
+      auto ws = boost::dynamic_pointer_cast<MatrixWorkspace>(input->getItem(i));
+      for (size_t hist = 0; hist < ws->getNumberHistograms(); ++hist)
+        ws->mutableY(hist) = static_cast<double>(i + 1);
+    }
+
+    Rebin rebin;
+    rebin.initialize();
+    rebin.setPropertyValue("InputWorkspace", "RebinTest_group");
+    rebin.setPropertyValue("OutputWorkspace", "RebinTest_rebinned");
+    rebin.setPropertyValue("Params", "0,2,10");
+    TS_ASSERT_THROWS_NOTHING(rebin.execute());
+    config.setString(key, previous);
+    TS_ASSERT(rebin.isExecuted());
+
+    // The outputs are in the order of the inputs, each rebinned on its own
+    auto output = AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>(
+        "RebinTest_rebinned");
+    TS_ASSERT_EQUALS(output->getNumberOfEntries(), 8);
+    for (int i = 0; i < output->getNumberOfEntries(); ++i) {
+      auto ws =
+          boost::dynamic_pointer_cast<MatrixWorkspace>(output->getItem(i));
+      TS_ASSERT_EQUALS(ws->blocksize(), 5);
+      for (size_t hist = 0; hist < ws->getNumberHistograms(); ++hist)
+        for (const auto y : ws->y(hist))
+          TS_ASSERT_DELTA(y, 2. * (i + 1), 1e-12);
+    }
+
+    AnalysisDataService::Instance().deepRemoveGroup("RebinTest_group");
+    AnalysisDataService::Instance().deepRemoveGroup("RebinTest_rebinned");
+  }
+
 private:
   Workspace2D_sptr Create1DWorkspace(int size) {
     auto retVal = createWorkspace<Workspace2D>(1, size, size - 1);
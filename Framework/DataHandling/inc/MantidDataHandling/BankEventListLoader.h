@@ -0,0 +1,86 @@
+#ifndef MANTID_DATAHANDLING_BANKEVENTLISTLOADER_H_
+#define MANTID_DATAHANDLING_BANKEVENTLISTLOADER_H_
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataObjects/EventListLoader.h"
+#include "MantidGeometry/IDTypes.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventWorkspace;
+}
+namespace DataHandling {
+
+/** BankEventListLoader : Loads the events of the banks of a NeXus event file
+  on demand. The record of the banks is made by LoadEventNexus when it loads a
+  file lazily; the events of a bank are read the first time the EventWorkspace
+  accesses one of the spectra of the detectors in the bank. The events are
+  parsed like those loaded by LoadEventNexus, with BankEventParser, and the
+  file is opened for each bank under the disk IO mutex of DefaultEventLoader.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAHANDLING_DLL BankEventListLoader
+    : public DataObjects::EventListLoader {
+public:
+  BankEventListLoader(const DataObjects::EventWorkspace &ws,
+                      const std::string &filename,
+                      const std::string &topEntryName,
+                      const std::vector<std::string> &bankNames,
+                      const bool haveWeights, const double tofOffset);
+  ~BankEventListLoader() override;
+
+  size_t numberOfGroups() const override;
+  size_t groupOfSpectrum(const size_t index) const override;
+  void loadGroup(const size_t group,
+                 const std::vector<DataObjects::EventList *> &lists)
+      const override;
+
+private:
+  /// The NeXus file with the events
+  const std::string m_filename;
+  /// Name of the entry with the banks in the file
+  const std::string m_topEntryName;
+  /// Names of the NXevent_data groups of the banks
+  const std::vector<std::string> m_bankNames;
+  /// Whether the events have weights
+  const bool m_haveWeights;
+  /// Offset added to the time-of-flight of all events
+  const double m_tofOffset;
+  /// Index of the bank of each spectrum, the number of banks if none
+  std::vector<size_t> m_bankOfSpectrum;
+  /// Offset of the pixel IDs in m_pixelIDToIndex, set before it
+  detid_t m_pixelIDOffset{0};
+  /// Workspace index of each pixel ID, shifted by m_pixelIDOffset
+  std::vector<size_t> m_pixelIDToIndex;
+  /// Range of the pixel IDs of the detectors of each bank
+  std::vector<std::pair<detid_t, detid_t>> m_pixelIDRange;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_BANKEVENTLISTLOADER_H_ */
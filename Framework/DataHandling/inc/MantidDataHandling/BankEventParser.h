@@ -0,0 +1,182 @@
+#ifndef MANTID_DATAHANDLING_BANKEVENTPARSER_H_
+#define MANTID_DATAHANDLING_BANKEVENTPARSER_H_
+
+#include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidKernel/DateAndTime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** BankEventParser : Turns the fields of an NXevent_data bank, as read from a
+  NeXus event file, into events. It finds the pulse time and period of each
+  event from the event_index, filters the events by detector ID and
+  time-of-flight and adds them to the event vectors of their detector IDs.
+
+  Used by ProcessBankData when a file is loaded and by BankEventListLoader
+  when the events of a bank are loaded on demand, so that both make the same
+  events from a bank.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAHANDLING_DLL BankEventParser {
+public:
+  BankEventParser(const std::vector<uint64_t> &eventIndex,
+                  const BankPulseTimes &pulseTimes, const size_t startAt,
+                  const detid_t minId, const detid_t maxId,
+                  const double tofMin, const double tofMax);
+
+  template <class T, class Cancelled>
+  bool parse(const uint32_t *eventIds, const float *tofs, const float *weights,
+             const size_t first, const size_t last,
+             const std::vector<std::vector<std::vector<T> *>> &eventVectors,
+             std::vector<bool> *usedIds, Cancelled cancelled);
+
+  /// Whether the event_index covers the pulses, so that the events can be
+  /// given their pulse times
+  bool havePulseTimes() const { return m_pulse <= m_numPulses; }
+  /// Whether the pulse times of the events parsed so far never decrease
+  bool pulseTimesIncreasing() const { return m_pulseTimesIncreasing; }
+  /// Shortest time-of-flight of the events parsed so far
+  double shortestTof() const { return m_shortestTof; }
+  /// Longest time-of-flight below 2e8 of the events parsed so far
+  double longestTof() const { return m_longestTof; }
+  /// Number of events with a time-of-flight of 2e8 or more
+  size_t badTofs() const { return m_badTofs; }
+  /// Number of events of detector IDs that have no event vector
+  size_t discardedEvents() const { return m_discardedEvents; }
+
+private:
+  bool findPulse(const size_t i);
+
+  /// Add an event to a vector of TofEvent's, ignoring its weight
+  static void addEvent(std::vector<Types::Event::TofEvent> &events,
+                       const double tof,
+                       const Types::Core::DateAndTime &pulseTime,
+                       const float *) {
+    events.emplace_back(tof, pulseTime);
+  }
+
+  /// Add an event to a vector of WeightedEvent's, with unit weight if none
+  static void addEvent(std::vector<DataObjects::WeightedEvent> &events,
+                       const double tof,
+                       const Types::Core::DateAndTime &pulseTime,
+                       const float *weight) {
+    const double value = weight ? static_cast<double>(*weight) : 1.0;
+    events.emplace_back(tof, pulseTime, value, value * value);
+  }
+
+  /// Index of the first event of each pulse in the bank
+  const std::vector<uint64_t> &m_eventIndex;
+  /// Pulse times and period numbers of the bank
+  const BankPulseTimes &m_pulseTimes;
+  /// Index in the bank of the first event of the arrays
+  const size_t m_startAt;
+  /// Range of detector IDs to keep
+  const detid_t m_minId;
+  const detid_t m_maxId;
+  /// Range of time-of-flight to keep
+  const double m_tofMin;
+  const double m_tofMax;
+  /// Number of pulses
+  int m_numPulses;
+  /// Index of the pulse of the last event parsed
+  int m_pulse{0};
+  /// Pulse time and period of the last event parsed
+  Types::Core::DateAndTime m_pulseTime;
+  int m_periodNumber{1};
+  /// Latest pulse time so far
+  Types::Core::DateAndTime m_lastPulseTime{0};
+  bool m_pulseTimesIncreasing{true};
+  /// Limits of the time-of-flight and counts of the rejected events
+  double m_shortestTof;
+  double m_longestTof{0.};
+  size_t m_badTofs{0};
+  size_t m_discardedEvents{0};
+};
+
+/** Add the events [first, last) of the arrays to the event vectors of their
+ * detector IDs. Events must be parsed in order: each call carries on from the
+ * pulse of the last event of the previous one.
+ * @param eventIds :: detector ID of each event
+ * @param tofs :: time-of-flight of each event, in microseconds
+ * @param weights :: weight of each event, may be null for unit weights
+ * @param first :: index in the arrays of the first event to parse
+ * @param last :: index in the arrays after the last event to parse
+ * @param eventVectors :: event vector of each detector ID, for each period;
+ *        null if the events of a detector ID are to be discarded
+ * @param usedIds :: if not null, the flags of the detector IDs that get
+ *        events are set, offset by the minimum detector ID
+ * @param cancelled :: callable checked at each new pulse
+ * @return false if parsing stopped because cancelled() returned true
+ */
+template <class T, class Cancelled>
+bool BankEventParser::parse(
+    const uint32_t *eventIds, const float *tofs, const float *weights,
+    const size_t first, const size_t last,
+    const std::vector<std::vector<std::vector<T> *>> &eventVectors,
+    std::vector<bool> *usedIds, Cancelled cancelled) {
+  for (size_t i = first; i < last; ++i) {
+    // Check once every new pulse if you need to cancel (checking on every
+    // event might slow things down more)
+    if (m_pulse < m_numPulses - 1 && findPulse(i) && cancelled())
+      return false;
+
+    const detid_t detId = eventIds[i];
+    if (detId < m_minId || detId > m_maxId)
+      continue;
+    const double tof = static_cast<double>(tofs[i]);
+    if (tof < m_tofMin || tof > m_tofMax)
+      continue;
+
+    // NULL eventVector indicates a bad spectrum lookup
+    auto *events = eventVectors[m_periodNumber - 1][detId];
+    if (events)
+      addEvent(*events, tof, m_pulseTime, weights ? weights + i : nullptr);
+    else
+      ++m_discardedEvents;
+
+    if (tof < m_shortestTof)
+      m_shortestTof = tof;
+    // Skip any events that are the cause of bad DAS data (e.g. a negative
+    // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
+    if (tof < 2e8) {
+      if (tof > m_longestTof)
+        m_longestTof = tof;
+    } else
+      ++m_badTofs;
+
+    if (usedIds)
+      (*usedIds)[detId - m_minId] = true;
+  }
+  return true;
+}
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_BANKEVENTPARSER_H_ */
@@ -5,11 +5,17 @@
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidAPI/Axis.h"
 
+#include <boost/shared_ptr.hpp>
+
+#include <mutex>
+
 class BankPulseTimes;
 
 namespace Mantid {
 namespace DataHandling {
+class DirectChunkReader;
 class LoadEventNexus;
+class MemoryMappedNexusFile;
 
 /** Helper class for LoadEventNexus that is specific to the current default
   loading code for NXevent_data entries in Nexus files, in particular
@@ -44,6 +50,8 @@ public:
        const std::vector<int> &periodLog, const std::string &classType,
        std::vector<std::size_t> bankNumEvents, const bool oldNeXusFileNames,
        const bool precount, const int chunk, const int totalChunks);
+  static boost::shared_ptr<std::mutex> diskIOMutex();
+  ~DefaultEventLoader();
 
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
@@ -92,6 +100,12 @@ public:
   /// One entry of pulse times for each preprocessor
   std::vector<boost::shared_ptr<BankPulseTimes>> m_bankPulseTimes;
 
+  /// The file mapped into memory, to use datasets in place when possible.
+  /// Opened once for all banks; used under the disk IO mutex of the tasks.
+  std::unique_ptr<MemoryMappedNexusFile> mappedFile;
+  /// Reader for the compressed chunks of the file, shared like mappedFile
+  std::unique_ptr<DirectChunkReader> chunkReader;
+
 private:
   DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                      bool haveWeights, bool event_id_is_spec,
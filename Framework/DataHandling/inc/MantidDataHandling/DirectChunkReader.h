@@ -0,0 +1,96 @@
+#ifndef MANTID_DATAHANDLING_DIRECTCHUNKREADER_H_
+#define MANTID_DATAHANDLING_DIRECTCHUNKREADER_H_
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <boost/shared_array.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace H5 {
+class H5File;
+}
+
+namespace Mantid {
+namespace DataHandling {
+
+/** CompressedSlab : Part of a 1D dataset of a NeXus (HDF5) file, kept as the
+  chunks compressed with deflate (gzip) that were read from the file.
+  Decompressing needs no access to the file, so it can be done on any thread
+  without holding the lock that serializes access to the file.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename NumT> class MANTID_DATAHANDLING_DLL CompressedSlab {
+public:
+  boost::shared_array<NumT> decompress() const;
+
+  /// Number of values in the slab
+  size_t size() const { return m_count; }
+
+private:
+  friend class DirectChunkReader;
+
+  /// Number of values in a chunk
+  size_t m_chunkSize{0};
+  /// Index of the first value of the slab in the first chunk
+  size_t m_offset{0};
+  /// Number of values in the slab
+  size_t m_count{0};
+  /// The chunks as stored in the file
+  std::vector<std::vector<char>> m_chunks;
+  /// Flags for chunks that are stored without compression
+  std::vector<bool> m_uncompressed;
+};
+
+/** DirectChunkReader : Reads the chunks of 1D datasets of a NeXus (HDF5) file
+  that are compressed with deflate (gzip) as they are stored in the file, with
+  the direct chunk read of HDF5. Only reading is serialized by the HDF5 library;
+  the chunks are decompressed later by CompressedSlab. Datasets that are not
+  chunked, use other filters (e.g. shuffle) or are not stored in the byte order
+  of this machine cannot be read this way and the caller must read them as
+  usual.
+*/
+class MANTID_DATAHANDLING_DLL DirectChunkReader {
+public:
+  explicit DirectChunkReader(const std::string &filename);
+  ~DirectChunkReader();
+
+  /// Whether the file could be opened and chunks can be read at all
+  bool isOpen() const { return static_cast<bool>(m_file); }
+
+  template <typename NumT>
+  std::unique_ptr<CompressedSlab<NumT>> readSlab(const std::string &path,
+                                                 const size_t start,
+                                                 const size_t count) const;
+
+private:
+  /// The file the chunks are read from
+  std::unique_ptr<H5::H5File> m_file;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_DIRECTCHUNKREADER_H_ */
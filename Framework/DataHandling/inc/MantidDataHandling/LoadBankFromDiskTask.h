@@ -6,16 +6,22 @@
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
 
+#include <boost/shared_array.hpp>
 #include <nexus/NeXusFile.hpp>
 
+#include <memory>
+
 class BankPulseTimes;
 
 namespace Mantid {
 namespace DataHandling {
 class DefaultEventLoader;
+template <typename NumT> class CompressedSlab;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
-  disk IO mutex
+  disk IO mutex. Fields compressed with deflate are read as compressed chunks;
+  the task then schedules a copy of itself without the mutex, which
+  decompresses them while other banks are read.
 
   Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
@@ -49,10 +55,13 @@ public:
                        boost::shared_ptr<std::mutex> ioMutex,
                        Kernel::ThreadScheduler &scheduler,
                        const std::vector<int> &framePeriodNumbers);
+  ~LoadBankFromDiskTask() override;
 
   void run() override;
 
 private:
+  LoadBankFromDiskTask(const LoadBankFromDiskTask &other);
+  void loadFromDisk();
   void loadPulseTimes(::NeXus::File &file);
   void loadEventIndex(::NeXus::File &file, std::vector<uint64_t> &event_index);
   void prepareEventId(::NeXus::File &file, size_t &start_event,
@@ -60,6 +69,14 @@ private:
   void loadEventId(::NeXus::File &file);
   void loadTof(::NeXus::File &file);
   void loadEventWeights(::NeXus::File &file);
+  template <typename NumT>
+  boost::shared_array<NumT>
+  loadSlab(::NeXus::File &file, const std::string &fieldName,
+           boost::shared_ptr<CompressedSlab<NumT>> &compressed);
+  bool haveCompressedData() const;
+  void decompress();
+  void findPixelIdRange();
+  void processLoadedEvents();
   int64_t recalculateDataSize(const int64_t &size);
 
   /// Algorithm being run
@@ -82,18 +99,26 @@ private:
   std::vector<int> m_loadStart;
   /// How much to load in the file
   std::vector<int> m_loadSize;
+  /// Index of the first event of each pulse
+  boost::shared_ptr<std::vector<uint64_t>> m_event_index;
   /// Event pixel ID data
-  uint32_t *m_event_id;
+  boost::shared_array<uint32_t> m_event_id;
+  /// Compressed event pixel ID data, not decompressed yet
+  boost::shared_ptr<CompressedSlab<uint32_t>> m_compressed_event_id;
   /// Minimum pixel ID in this data
   uint32_t m_min_id;
   /// Maximum pixel ID in this data
   uint32_t m_max_id;
   /// TOF data
-  float *m_event_time_of_flight;
+  boost::shared_array<float> m_event_time_of_flight;
+  /// Compressed TOF data, not decompressed yet
+  boost::shared_ptr<CompressedSlab<float>> m_compressed_event_time_of_flight;
   /// Flag for simulated data
   bool m_have_weight;
   /// Event weights
-  float *m_event_weight;
+  boost::shared_array<float> m_event_weight;
+  /// Compressed event weights, not decompressed yet
+  boost::shared_ptr<CompressedSlab<float>> m_compressed_event_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
 }; // END-DEF-CLASS LoadBankFromDiskTask
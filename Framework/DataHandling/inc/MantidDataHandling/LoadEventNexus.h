@@ -159,6 +159,14 @@ public:
 
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
+  /// Tolerance in seconds on the wall-clock time when compressing; empty to
+  /// compress all pulse times together.
+  double compressWallClockTolerance;
+  /// Start of the wall-clock time bins when compressing
+  Mantid::Types::Core::DateAndTime compressStartTime;
+  /// Number of events of a bank kept uncompressed at a time when compressing
+  /// while loading. Banks with fewer events are compressed in one pass.
+  size_t eventsPerCompressedBlock;
 
   /// Pulse times for ALL banks, taken from proton_charge log.
   boost::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
@@ -179,6 +187,8 @@ private:
   /// Execution code
   void exec() override;
 
+  std::map<std::string, std::string> validateInputs() override;
+
   bool canUseParallelLoader(const bool haveWeights,
                             const bool oldNeXusFileNames,
                             const std::string &classType) const;
@@ -186,6 +196,11 @@ private:
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
 
   void loadEvents(API::Progress *const prog, const bool monitors);
+  bool selectChunkOfPulses(const std::vector<std::size_t> &bankNumEvents,
+                           const double maxChunkSize);
+  bool loadEventsOnDemand(const bool haveWeights, const bool oldNeXusFileNames,
+                          const std::vector<std::string> &bankNames);
+  void finishLoadingEvents(const std::string &classType);
   void createSpectraMapping(
       const std::string &nxsfile, const bool monitorsOnly,
       const std::vector<std::string> &bankNames = std::vector<std::string>());
@@ -0,0 +1,77 @@
+#ifndef MANTID_DATAHANDLING_MEMORYMAPPEDNEXUSFILE_H_
+#define MANTID_DATAHANDLING_MEMORYMAPPEDNEXUSFILE_H_
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <boost/shared_array.hpp>
+
+#include <memory>
+#include <string>
+
+namespace H5 {
+class DataType;
+class H5File;
+}
+
+namespace Poco {
+class SharedMemory;
+}
+
+namespace Mantid {
+namespace DataHandling {
+
+/** MemoryMappedNexusFile : Maps a NeXus (HDF5) file into memory so that 1D
+  datasets stored contiguously and without compression can be used in place,
+  instead of being copied into buffers through the NeXus API. Datasets that
+  are chunked (and so possibly compressed), or not stored in the byte order of
+  this machine, cannot be mapped and the caller must read them as usual.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAHANDLING_DLL MemoryMappedNexusFile {
+public:
+  explicit MemoryMappedNexusFile(const std::string &filename);
+  ~MemoryMappedNexusFile();
+
+  /// Whether the file could be opened and mapped at all
+  bool isMapped() const { return static_cast<bool>(m_mapping); }
+
+  template <typename NumT>
+  boost::shared_array<NumT> mapSlab(const std::string &path,
+                                    const size_t start,
+                                    const size_t count) const;
+
+private:
+  const char *mapDataset(const std::string &path, const H5::DataType &type,
+                         const size_t start, const size_t count,
+                         const size_t typeSize) const;
+
+  /// The file, used to find where the datasets are stored
+  std::unique_ptr<H5::H5File> m_file;
+  /// Read-only mapping of the whole file
+  std::shared_ptr<Poco::SharedMemory> m_mapping;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_MEMORYMAPPEDNEXUSFILE_H_ */
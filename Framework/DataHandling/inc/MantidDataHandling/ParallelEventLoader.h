@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "MantidDataHandling/DllConfig.h"
+#include "MantidTypes/Core/DateAndTime.h"
 
 namespace Mantid {
 namespace DataObjects {
@@ -13,9 +14,10 @@ class EventWorkspace;
 namespace DataHandling {
 
 /** Loader for event data from Nexus files with parallelism based on multiple
-  processes (MPI) for performance. This class provides integration of the low
-  level loader component Parallel::IO::EventLoader with higher level concepts
-  such as DataObjects::EventWorkspace and the instrument.
+  processes (MPI), or multiple threads in a single process, for performance.
+  This class provides integration of the low level loader component
+  Parallel::IO::EventLoader with higher level concepts such as
+  DataObjects::EventWorkspace and the instrument.
 
   @author Simon Heybrock
   @date 2017
@@ -46,7 +48,9 @@ public:
   static void load(DataObjects::EventWorkspace &ws, const std::string &filename,
                    const std::string &groupName,
                    const std::vector<std::string> &bankNames,
-                   const bool eventIDIsSpectrumNumber);
+                   const bool eventIDIsSpectrumNumber,
+                   const Types::Core::DateAndTime &pulseTimeStart,
+                   const Types::Core::DateAndTime &pulseTimeStop);
 };
 
 } // namespace DataHandling
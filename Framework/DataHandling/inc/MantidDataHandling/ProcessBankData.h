@@ -8,7 +8,13 @@
 
 #include <boost/shared_array.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace Mantid {
+namespace DataObjects {
+class EventList;
+}
 namespace DataHandling {
 class DefaultEventLoader;
 
@@ -47,6 +53,11 @@ public:
 
 private:
   size_t getWorkspaceIndexFromPixelID(const detid_t pixID);
+  void compressEvents(DataObjects::EventList &input,
+                      DataObjects::EventList *output) const;
+  void compressBlock(
+      std::vector<bool> &blockDetIds, std::vector<bool> &usedDetIds,
+      std::vector<std::unique_ptr<DataObjects::EventList>> &compressed);
 
   /// Algorithm being run
   DefaultEventLoader &m_loader;
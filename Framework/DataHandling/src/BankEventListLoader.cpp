@@ -0,0 +1,262 @@
+#include "MantidDataHandling/BankEventListLoader.h"
+#include "MantidDataHandling/BankEventParser.h"
+#include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/make_unique.h"
+
+#include <nexus/NeXusException.hpp>
+#include <nexus/NeXusFile.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+using Mantid::DataObjects::EventList;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("BankEventListLoader");
+
+/// Name of the bank in the instrument for the NXevent_data group of a bank
+std::string instrumentBankName(const std::string &groupName) {
+  const std::string suffix("_events");
+  if (groupName.size() > suffix.size() &&
+      groupName.compare(groupName.size() - suffix.size(), suffix.size(),
+                        suffix) == 0)
+    return groupName.substr(0, groupName.size() - suffix.size());
+  return groupName;
+}
+
+/** Read a field of a bank, if it has the type LoadEventNexus reads.
+ * @param file :: the file, with the group of the bank open
+ * @param bankName :: name of the group of the bank
+ * @param fieldName :: name of the field
+ * @param type :: the type of the field
+ * @param values :: set to the values of the field
+ * @return false, after a warning, if the field has another type
+ */
+template <typename T>
+bool readField(::NeXus::File &file, const std::string &bankName,
+               const std::string &fieldName, const ::NeXus::NXnumtype type,
+               std::vector<T> &values) {
+  file.openData(fieldName);
+  const bool haveType = file.getInfo().type == type;
+  if (haveType)
+    file.getData(values);
+  else
+    g_log.warning() << "Entry " << bankName << "'s " << fieldName
+                    << " field is not of the expected type! The bank will be "
+                       "skipped.\n";
+  file.closeData();
+  return haveType;
+}
+
+/** Parse the events of a bank into the event lists of their pixel IDs.
+ * @param parser :: the parser for the bank
+ * @param pixelLists :: the event list of each pixel ID, null for pixels whose
+ *        events are dropped
+ * @param eventIds :: pixel ID of each event
+ * @param tofs :: time-of-flight of each event
+ * @param weights :: weight of each event, may be null
+ * @param numEvents :: the number of events
+ */
+template <class T>
+void parseEvents(BankEventParser &parser,
+                 const std::vector<EventList *> &pixelLists,
+                 const uint32_t *eventIds, const float *tofs,
+                 const float *weights, const size_t numEvents) {
+  std::vector<std::vector<std::vector<T> *>> eventVectors(
+      1, std::vector<std::vector<T> *>(pixelLists.size(), nullptr));
+  for (size_t id = 0; id < pixelLists.size(); ++id)
+    if (pixelLists[id])
+      getEventsFrom(*pixelLists[id], eventVectors[0][id]);
+  parser.parse(eventIds, tofs, weights, 0, numEvents, eventVectors, nullptr,
+               []() { return false; });
+}
+} // namespace
+
+/** Record the banks of a file and the spectra of their detectors.
+ * @param ws :: the workspace the events will be loaded into, with instrument
+ *        and spectra set up
+ * @param filename :: path of the NeXus file
+ * @param topEntryName :: name of the entry with the banks
+ * @param bankNames :: names of the NXevent_data groups of the banks
+ * @param haveWeights :: whether the events have weights. The event lists of
+ *        the workspace must then hold weighted events.
+ * @param tofOffset :: offset to add to the time-of-flight of all events
+ * @throw std::runtime_error if a bank is not in the instrument or a spectrum
+ *        has detectors of more than one bank
+ */
+BankEventListLoader::BankEventListLoader(
+    const DataObjects::EventWorkspace &ws, const std::string &filename,
+    const std::string &topEntryName, const std::vector<std::string> &bankNames,
+    const bool haveWeights, const double tofOffset)
+    : m_filename(filename), m_topEntryName(topEntryName),
+      m_bankNames(bankNames), m_haveWeights(haveWeights),
+      m_tofOffset(tofOffset),
+      m_bankOfSpectrum(ws.getNumberHistograms(), bankNames.size()),
+      m_pixelIDToIndex(
+          ws.getDetectorIDToWorkspaceIndexVector(m_pixelIDOffset, true)),
+      m_pixelIDRange(bankNames.size(),
+                     {std::numeric_limits<detid_t>::max(), 0}) {
+  const auto instrument = ws.getInstrument();
+  for (size_t bank = 0; bank < m_bankNames.size(); ++bank) {
+    const auto name = instrumentBankName(m_bankNames[bank]);
+    const auto component = instrument->getComponentByName(name);
+    if (!component)
+      throw std::runtime_error("The instrument has no bank " + name);
+    std::vector<Geometry::IDetector_const_sptr> detectors;
+    instrument->getDetectorsInBank(detectors, *component);
+    for (const auto &detector : detectors) {
+      const auto pixel = detector->getID() + m_pixelIDOffset;
+      if (pixel < 0 || pixel >= static_cast<detid_t>(m_pixelIDToIndex.size()))
+        continue;
+      const size_t index = m_pixelIDToIndex[pixel];
+      if (index >= m_bankOfSpectrum.size())
+        continue;
+      if (m_bankOfSpectrum[index] != m_bankNames.size() &&
+          m_bankOfSpectrum[index] != bank)
+        throw std::runtime_error("Workspace index " + std::to_string(index) +
+                                 " has detectors of more than one bank");
+      m_bankOfSpectrum[index] = bank;
+      // Event files store pixel IDs as unsigned integers
+      if (detector->getID() >= 0) {
+        auto &range = m_pixelIDRange[bank];
+        range.first = std::min(range.first, detector->getID());
+        range.second = std::max(range.second, detector->getID());
+      }
+    }
+  }
+}
+
+BankEventListLoader::~BankEventListLoader() = default;
+
+/// Number of banks
+size_t BankEventListLoader::numberOfGroups() const {
+  return m_bankNames.size();
+}
+
+/// Index of the bank of the detectors of a spectrum
+size_t BankEventListLoader::groupOfSpectrum(const size_t index) const {
+  return index < m_bankOfSpectrum.size() ? m_bankOfSpectrum[index]
+                                         : m_bankNames.size();
+}
+
+/** Read the events of a bank and add them to the spectra of its detectors.
+ * Events of pixels in other banks are dropped, since the events of their
+ * spectra may already be in use.
+ * @param group :: index of the bank
+ * @param lists :: the event lists of the workspace
+ */
+void BankEventListLoader::loadGroup(
+    const size_t group, const std::vector<EventList *> &lists) const {
+  const auto &bankName = m_bankNames[group];
+  const detid_t minId = m_pixelIDRange[group].first;
+  const detid_t maxId = m_pixelIDRange[group].second;
+  if (minId > maxId)
+    return;
+
+  std::vector<uint64_t> eventIndex;
+  std::vector<uint32_t> eventIds;
+  std::vector<float> tofs;
+  std::vector<float> weights;
+  std::unique_ptr<BankPulseTimes> pulseTimes;
+  {
+    std::lock_guard<std::mutex> lock(*DefaultEventLoader::diskIOMutex());
+    ::NeXus::File file(m_filename);
+    file.openPath("/" + m_topEntryName + "/" + bankName);
+    if (!readField(file, bankName, "event_id", ::NeXus::UINT32, eventIds) ||
+        eventIds.empty())
+      return;
+    if (!readField(file, bankName, "event_index", ::NeXus::UINT64,
+                   eventIndex))
+      return;
+    pulseTimes = Kernel::make_unique<BankPulseTimes>(file, std::vector<int>());
+    if (!readField(file, bankName, "event_time_offset", ::NeXus::FLOAT32,
+                   tofs))
+      return;
+    file.openData("event_time_offset");
+    std::string units;
+    file.getAttr("units", units);
+    file.closeData();
+    if (units != "microsecond") {
+      g_log.warning() << "Entry " << bankName
+                      << "'s event_time_offset field's units are not "
+                         "microsecond. The bank will be skipped.\n";
+      return;
+    }
+    if (m_haveWeights) {
+      bool haveField = true;
+      try {
+        file.openData("event_weight");
+        file.closeData();
+      } catch (::NeXus::Exception &) {
+        // The events of this bank have unit weight
+        haveField = false;
+      }
+      if (haveField && !readField(file, bankName, "event_weight",
+                                  ::NeXus::FLOAT32, weights))
+        return;
+    }
+  }
+
+  const size_t numEvents = eventIds.size();
+  if (tofs.size() < numEvents ||
+      (!weights.empty() && weights.size() < numEvents)) {
+    g_log.warning() << "Entry " << bankName << " has fewer times-of-flight or "
+                                               "weights than events. The bank "
+                                               "will be skipped.\n";
+    return;
+  }
+
+  // The lists of the pixels of this bank only
+  std::vector<EventList *> pixelLists(maxId + 1, nullptr);
+  for (detid_t id = minId; id <= maxId; ++id) {
+    const auto pixel = id + m_pixelIDOffset;
+    if (pixel < 0 || pixel >= static_cast<detid_t>(m_pixelIDToIndex.size()))
+      continue;
+    const size_t index = m_pixelIDToIndex[pixel];
+    if (groupOfSpectrum(index) == group)
+      pixelLists[id] = lists[index];
+  }
+
+  BankEventParser parser(eventIndex, *pulseTimes, 0, minId, maxId,
+                         std::numeric_limits<double>::lowest(),
+                         std::numeric_limits<double>::max());
+  if (m_haveWeights)
+    parseEvents<WeightedEvent>(parser, pixelLists, eventIds.data(),
+                               tofs.data(),
+                               weights.empty() ? nullptr : weights.data(),
+                               numEvents);
+  else
+    parseEvents<TofEvent>(parser, pixelLists, eventIds.data(), tofs.data(),
+                          nullptr, numEvents);
+
+  // Adding events marks the lists as unsorted. Within a list, the events are
+  // in the order of the pulses in the file. T0 is added as by
+  // LoadEventNexus once the events are loaded.
+  const auto order = parser.pulseTimesIncreasing()
+                         ? DataObjects::PULSETIME_SORT
+                         : DataObjects::UNSORTED;
+  for (size_t index = 0; index < m_bankOfSpectrum.size(); ++index) {
+    if (m_bankOfSpectrum[index] != group)
+      continue;
+    if (m_tofOffset != 0.0)
+      lists[index]->addTof(m_tofOffset);
+    lists[index]->setSortOrder(order);
+  }
+}
+
+} // namespace DataHandling
+} // namespace Mantid
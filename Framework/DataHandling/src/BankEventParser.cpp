@@ -0,0 +1,66 @@
+#include "MantidDataHandling/BankEventParser.h"
+
+#include <limits>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** Constructor
+ * @param eventIndex :: index in the bank of the first event of each pulse
+ * @param pulseTimes :: pulse times and period numbers of the bank
+ * @param startAt :: index in the bank of the first event of the arrays
+ * @param minId :: minimum detector ID to keep
+ * @param maxId :: maximum detector ID to keep
+ * @param tofMin :: minimum time-of-flight to keep
+ * @param tofMax :: maximum time-of-flight to keep
+ */
+BankEventParser::BankEventParser(const std::vector<uint64_t> &eventIndex,
+                                 const BankPulseTimes &pulseTimes,
+                                 const size_t startAt, const detid_t minId,
+                                 const detid_t maxId, const double tofMin,
+                                 const double tofMax)
+    : m_eventIndex(eventIndex), m_pulseTimes(pulseTimes), m_startAt(startAt),
+      m_minId(minId), m_maxId(maxId), m_tofMin(tofMin), m_tofMax(tofMax),
+      m_numPulses(static_cast<int>(pulseTimes.numPulses)),
+      m_shortestTof(static_cast<double>(std::numeric_limits<uint32_t>::max()) *
+                    0.1) {
+  if (m_numPulses > static_cast<int>(m_eventIndex.size())) {
+    // The pulse times cannot be found. This'll make the code skip looking for
+    // any pulse times.
+    m_pulse = m_numPulses + 1;
+  }
+}
+
+/** Find the pulse of an event and save its pulse time and period.
+ * @param i :: index in the arrays of the event
+ * @return true if the event is in a later pulse than the previous one
+ */
+bool BankEventParser::findPulse(const size_t i) {
+  bool newPulse = false;
+  // Go through event_index until you find where the index increases to
+  // encompass the current index. Your pulse = the one before.
+  while ((i + m_startAt < m_eventIndex[m_pulse]) ||
+         (i + m_startAt >= m_eventIndex[m_pulse + 1])) {
+    m_pulse++;
+    newPulse = true;
+    if (m_pulse >= (m_numPulses - 1))
+      break;
+  }
+
+  // Save the pulse time at this index for creating those events
+  m_pulseTime = m_pulseTimes.pulseTimes[m_pulse];
+  const int logPeriodNumber = m_pulseTimes.periodNumbers[m_pulse];
+  // Some historic files have recorded their logperiod numbers as zeros!
+  if (logPeriodNumber > 0)
+    m_periodNumber = logPeriodNumber;
+
+  // Determine if pulse times continue to increase
+  if (m_pulseTime < m_lastPulseTime)
+    m_pulseTimesIncreasing = false;
+  else
+    m_lastPulseTime = m_pulseTime;
+  return newPulse;
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -1,6 +1,8 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/DirectChunkReader.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataHandling/MemoryMappedNexusFile.h"
 #include "MantidAPI/Progress.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
@@ -24,10 +26,20 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
+  // Map the file, to read uncompressed fields in place, and open it to read
+  // compressed fields as chunks. The tasks share them, one task at a time.
+  loader.mappedFile =
+      Kernel::make_unique<MemoryMappedNexusFile>(alg->m_filename);
+  if (!loader.mappedFile->isMapped())
+    loader.mappedFile.reset();
+  loader.chunkReader = Kernel::make_unique<DirectChunkReader>(alg->m_filename);
+  if (!loader.chunkReader->isOpen())
+    loader.chunkReader.reset();
+
   // Make the thread pool
   auto scheduler = new ThreadSchedulerMutexes;
   ThreadPool pool(scheduler);
-  auto diskIOMutex = boost::make_shared<std::mutex>();
+  auto ioMutex = diskIOMutex();
 
   // set up progress bar for the rest of the (multi-threaded) process
   size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
@@ -39,13 +51,25 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
     if (bankNumEvents[i] > 0)
       pool.schedule(new LoadBankFromDiskTask(
           loader, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
-          prog.get(), diskIOMutex, *scheduler, periodLog));
+          prog.get(), ioMutex, *scheduler, periodLog));
   }
   // Start and end all threads
   pool.joinAll();
-  diskIOMutex.reset();
 }
 
+/** Mutex held while reading the events of NeXus event files. The NeXus API
+ * and the HDF5 library under it are not safe to use from several threads at
+ * once, so the tasks of all loads share it with the loading of events on
+ * demand by BankEventListLoader.
+ */
+boost::shared_ptr<std::mutex> DefaultEventLoader::diskIOMutex() {
+  static const auto mutex = boost::make_shared<std::mutex>();
+  return mutex;
+}
+
+// The mapped file and chunk reader are incomplete types in the header
+DefaultEventLoader::~DefaultEventLoader() = default;
+
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
                                        EventWorkspaceCollection &ws,
                                        bool haveWeights, bool event_id_is_spec,
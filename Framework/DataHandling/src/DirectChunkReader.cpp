@@ -0,0 +1,169 @@
+#include "MantidDataHandling/DirectChunkReader.h"
+#include "MantidDataHandling/H5Util.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/make_unique.h"
+
+#include <H5Cpp.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+using namespace H5;
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// static logger object
+Kernel::Logger g_log("DirectChunkReader");
+}
+
+/** Decompress the chunks and return the values of the slab.
+ * @return the values of the slab
+ * @throw std::runtime_error if a chunk cannot be decompressed
+ */
+template <typename NumT>
+boost::shared_array<NumT> CompressedSlab<NumT>::decompress() const {
+  boost::shared_array<NumT> values(new NumT[m_count]);
+  const size_t chunkBytes = m_chunkSize * sizeof(NumT);
+  std::vector<char> buffer;
+  size_t done = 0;
+  for (size_t i = 0; i < m_chunks.size(); ++i) {
+    const size_t first = i == 0 ? m_offset : 0;
+    const size_t count = std::min(m_chunkSize - first, m_count - done);
+    const auto &chunk = m_chunks[i];
+    if (m_uncompressed[i]) {
+      if (chunk.size() != chunkBytes)
+        throw std::runtime_error("CompressedSlab: chunk has wrong size");
+      std::memcpy(values.get() + done, chunk.data() + first * sizeof(NumT),
+                  count * sizeof(NumT));
+    } else {
+      // Whole chunks are decompressed in place, only the chunks at either end
+      // of the slab need a buffer.
+      char *target = reinterpret_cast<char *>(values.get() + done);
+      if (count != m_chunkSize) {
+        buffer.resize(chunkBytes);
+        target = buffer.data();
+      }
+      uLongf size = static_cast<uLongf>(chunkBytes);
+      if (uncompress(reinterpret_cast<Bytef *>(target), &size,
+                     reinterpret_cast<const Bytef *>(chunk.data()),
+                     static_cast<uLong>(chunk.size())) != Z_OK ||
+          size != chunkBytes)
+        throw std::runtime_error("CompressedSlab: failed to decompress chunk");
+      if (count != m_chunkSize)
+        std::memcpy(values.get() + done, buffer.data() + first * sizeof(NumT),
+                    count * sizeof(NumT));
+    }
+    done += count;
+  }
+  return values;
+}
+
+/** Open the file. Failures are not errors: isOpen() returns false and no
+ * dataset can be read.
+ * @param filename :: path to the NeXus file
+ */
+DirectChunkReader::DirectChunkReader(const std::string &filename) {
+#if H5_VERSION_GE(1, 10, 3)
+  try {
+    m_file = Kernel::make_unique<H5File>(filename, H5F_ACC_RDONLY);
+  } catch (H5::Exception &e) {
+    g_log.debug() << "Cannot open " << filename
+                  << " to read chunks: " << e.getDetailMsg() << "\n";
+  }
+#else
+  g_log.debug() << "Cannot read chunks of " << filename
+                << ": direct chunk read requires HDF5 1.10.3 or newer\n";
+#endif
+}
+
+DirectChunkReader::~DirectChunkReader() = default;
+
+/** Read the compressed chunks containing a slab of a 1D dataset.
+ * @param path :: absolute path of the dataset in the file
+ * @param start :: index of the first value
+ * @param count :: number of values
+ * @return the chunks, or nullptr if the dataset is not chunked and compressed
+ *         with deflate only, has another type or is too small
+ */
+template <typename NumT>
+std::unique_ptr<CompressedSlab<NumT>>
+DirectChunkReader::readSlab(const std::string &path, const size_t start,
+                            const size_t count) const {
+#if H5_VERSION_GE(1, 10, 3)
+  if (!m_file || count == 0)
+    return nullptr;
+
+  try {
+    DataSet dataset = m_file->openDataSet(path);
+    // Equality of the types includes the byte order.
+    if (!(dataset.getDataType() == H5Util::getType<NumT>()))
+      return nullptr;
+    DataSpace space = dataset.getSpace();
+    if (space.getSimpleExtentNdims() != 1 ||
+        static_cast<size_t>(space.getSimpleExtentNpoints()) < start + count)
+      return nullptr;
+    DSetCreatPropList properties = dataset.getCreatePlist();
+    if (properties.getLayout() != H5D_CHUNKED ||
+        properties.getNfilters() != 1)
+      return nullptr;
+    unsigned int flags;
+    size_t numParameters = 0;
+    unsigned int filterConfig;
+    if (properties.getFilter(0, flags, numParameters, nullptr, 0, nullptr,
+                             filterConfig) != H5Z_FILTER_DEFLATE)
+      return nullptr;
+    hsize_t chunkSize;
+    properties.getChunk(1, &chunkSize);
+
+    auto slab = Kernel::make_unique<CompressedSlab<NumT>>();
+    slab->m_chunkSize = static_cast<size_t>(chunkSize);
+    slab->m_offset = start % slab->m_chunkSize;
+    slab->m_count = count;
+    for (hsize_t offset = start - slab->m_offset; offset < start + count;
+         offset += chunkSize) {
+      hsize_t storageSize = 0;
+      const herr_t status =
+          H5Dget_chunk_storage_size(dataset.getId(), &offset, &storageSize);
+      // Chunks that were never written have no storage.
+      if (status < 0 || storageSize == 0)
+        return nullptr;
+      std::vector<char> chunk(static_cast<size_t>(storageSize));
+      uint32_t filterMask = 0;
+      if (H5Dread_chunk(dataset.getId(), H5P_DEFAULT, &offset, &filterMask,
+                        chunk.data()) < 0)
+        return nullptr;
+      // The deflate filter may have been skipped for this chunk.
+      slab->m_uncompressed.push_back((filterMask & 1) != 0);
+      slab->m_chunks.push_back(std::move(chunk));
+    }
+    return slab;
+  } catch (H5::Exception &e) {
+    g_log.debug() << "Cannot read chunks of " << path << ": "
+                  << e.getDetailMsg() << "\n";
+    return nullptr;
+  }
+#else
+  static_cast<void>(path);
+  static_cast<void>(start);
+  static_cast<void>(count);
+  return nullptr;
+#endif
+}
+
+template class MANTID_DATAHANDLING_DLL CompressedSlab<uint32_t>;
+template class MANTID_DATAHANDLING_DLL CompressedSlab<float>;
+
+template MANTID_DATAHANDLING_DLL std::unique_ptr<CompressedSlab<uint32_t>>
+DirectChunkReader::readSlab(const std::string &, const size_t,
+                            const size_t) const;
+template MANTID_DATAHANDLING_DLL std::unique_ptr<CompressedSlab<float>>
+DirectChunkReader::readSlab(const std::string &, const size_t,
+                            const size_t) const;
+
+} // namespace DataHandling
+} // namespace Mantid
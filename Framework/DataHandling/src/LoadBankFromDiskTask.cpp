@@ -1,7 +1,9 @@
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/DirectChunkReader.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataHandling/MemoryMappedNexusFile.h"
 #include "MantidDataHandling/ProcessBankData.h"
 
 namespace Mantid {
@@ -27,15 +29,71 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(
     const std::vector<int> &framePeriodNumbers)
     : m_loader(loader), entry_name(entry_name), entry_type(entry_type),
       prog(prog), scheduler(scheduler), m_loadError(false),
-      m_oldNexusFileNames(oldNeXusFileNames), m_event_id(nullptr),
-      m_event_time_of_flight(nullptr), m_have_weight(false),
-      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
+      m_oldNexusFileNames(oldNeXusFileNames), m_have_weight(false),
+      m_framePeriodNumbers(framePeriodNumbers) {
   setMutex(ioMutex);
   m_cost = static_cast<double>(numEvents);
   m_min_id = std::numeric_limits<uint32_t>::max();
   m_max_id = 0;
 }
 
+/** Constructor of the task that decompresses the data read by another task.
+ * It has no mutex, so it does not wait for (or block) the disk IO.
+ * @param other :: the task that has read the compressed data
+ */
+LoadBankFromDiskTask::LoadBankFromDiskTask(const LoadBankFromDiskTask &other)
+    : Kernel::Task(other.m_cost), m_loader(other.m_loader),
+      entry_name(other.entry_name), entry_type(other.entry_type),
+      prog(other.prog), scheduler(other.scheduler),
+      thisBankPulseTimes(other.thisBankPulseTimes), m_loadError(false),
+      m_oldNexusFileNames(other.m_oldNexusFileNames),
+      m_loadStart(other.m_loadStart), m_loadSize(other.m_loadSize),
+      m_event_index(other.m_event_index), m_event_id(other.m_event_id),
+      m_compressed_event_id(other.m_compressed_event_id),
+      m_min_id(other.m_min_id), m_max_id(other.m_max_id),
+      m_event_time_of_flight(other.m_event_time_of_flight),
+      m_compressed_event_time_of_flight(
+          other.m_compressed_event_time_of_flight),
+      m_have_weight(other.m_have_weight), m_event_weight(other.m_event_weight),
+      m_compressed_event_weight(other.m_compressed_event_weight),
+      m_framePeriodNumbers(other.m_framePeriodNumbers) {}
+
+LoadBankFromDiskTask::~LoadBankFromDiskTask() = default;
+
+/** Load the slab [m_loadStart, m_loadStart + m_loadSize) of a field of the
+ * bank. If the field is stored contiguously and uncompressed, it is used in
+ * place in the memory-mapped file instead of being copied into a buffer. If it
+ * is compressed with deflate, only the compressed chunks are read, to be
+ * decompressed later without holding the disk IO mutex.
+ * @param file :: File handle for the NeXus file, with the field open
+ * @param fieldName :: name of the field in the bank
+ * @param compressed :: set to the compressed chunks, if they were read
+ * @return the values of the slab, or nothing if the chunks were read
+ */
+template <typename NumT>
+boost::shared_array<NumT>
+LoadBankFromDiskTask::loadSlab(
+    ::NeXus::File &file, const std::string &fieldName,
+    boost::shared_ptr<CompressedSlab<NumT>> &compressed) {
+  const std::string path = "/" + m_loader.alg->m_top_entry_name + "/" +
+                           entry_name + "/" + fieldName;
+  if (m_loader.mappedFile) {
+    auto data = m_loader.mappedFile->mapSlab<NumT>(path, m_loadStart[0],
+                                                   m_loadSize[0]);
+    if (data)
+      return data;
+  }
+  if (m_loader.chunkReader) {
+    compressed = m_loader.chunkReader->readSlab<NumT>(path, m_loadStart[0],
+                                                      m_loadSize[0]);
+    if (compressed)
+      return boost::shared_array<NumT>();
+  }
+  boost::shared_array<NumT> data(new NumT[m_loadSize[0]]);
+  file.getSlab(data.get(), m_loadStart, m_loadSize);
+  return data;
+}
+
 /** Load the pulse times, if needed. This sets
 * thisBankPulseTimes to the right pointer.
 * */
@@ -184,9 +242,6 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
 
-  // Now we allocate the required arrays
-  m_event_id = new uint32_t[m_loadSize[0]];
-
   // Check that the required space is there in the file.
   if (dim0 < m_loadSize[0] + m_loadStart[0]) {
     m_loader.alg->getLogger().warning()
@@ -202,7 +257,9 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   if (!m_loadError) {
     // Must be uint32
     if (id_info.type == ::NeXus::UINT32)
-      file.getSlab(m_event_id, m_loadStart, m_loadSize);
+      m_event_id = loadSlab<uint32_t>(
+          file, m_oldNexusFileNames ? "event_pixel_id" : "event_id",
+          m_compressed_event_id);
     else {
       m_loader.alg->getLogger().warning()
           << "Entry " << entry_name
@@ -210,50 +267,48 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
       m_loadError = true;
     }
     file.closeData();
+  }
+}
 
-    // determine the range of pixel ids
-    for (auto i = 0; i < m_loadSize[0]; ++i) {
-      uint32_t temp = m_event_id[i];
-      if (temp < m_min_id)
-        m_min_id = temp;
-      if (temp > m_max_id)
-        m_max_id = temp;
-    }
+/** Find the range of pixel IDs of the loaded events, limited to the IDs known
+ * from the instrument. Sets m_loadError if there are no known IDs.
+ */
+void LoadBankFromDiskTask::findPixelIdRange() {
+  for (auto i = 0; i < m_loadSize[0]; ++i) {
+    uint32_t temp = m_event_id[i];
+    if (temp < m_min_id)
+      m_min_id = temp;
+    if (temp > m_max_id)
+      m_max_id = temp;
+  }
 
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
-    // fixup the minimum pixel id in the case that it's lower than the lowest
-    // 'known' id. We test this by checking that when we add the offset we
-    // would not get a negative index into the vector. Note that m_min_id is
-    // a uint so we have to be cautious about adding it to an int which may be
-    // negative.
-    if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
-      m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
-    }
-    // fixup the maximum pixel id in the case that it's higher than the
-    // highest 'known' id
-    if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
-      m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
+  if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
+    // All the detector IDs in the bank are higher than the highest 'known'
+    // (from the IDF)
+    // ID. Setting this will abort the loading of the bank.
+    m_loadError = true;
+  }
+  // fixup the minimum pixel id in the case that it's lower than the lowest
+  // 'known' id. We test this by checking that when we add the offset we
+  // would not get a negative index into the vector. Note that m_min_id is
+  // a uint so we have to be cautious about adding it to an int which may be
+  // negative.
+  if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
+    m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
   }
+  // fixup the maximum pixel id in the case that it's higher than the
+  // highest 'known' id
+  if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
+    m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
 }
 
 /** Open and load the times-of-flight data
 */
 void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
-  // Allocate the array
-  auto temp = new float[m_loadSize[0]];
-  delete[] m_event_time_of_flight;
-  m_event_time_of_flight = temp;
-
   // Get the list of event_time_of_flight's
-  if (!m_oldNexusFileNames)
-    file.openData("event_time_offset");
-  else
-    file.openData("event_time_of_flight");
+  const std::string fieldName =
+      m_oldNexusFileNames ? "event_time_of_flight" : "event_time_offset";
+  file.openData(fieldName);
 
   // Check that the required space is there in the file.
   ::NeXus::Info tof_info = file.getInfo();
@@ -267,7 +322,8 @@ void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (tof_info.type == ::NeXus::FLOAT32)
-    file.getSlab(m_event_time_of_flight, m_loadStart, m_loadSize);
+    m_event_time_of_flight =
+        loadSlab<float>(file, fieldName, m_compressed_event_time_of_flight);
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -302,11 +358,6 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   // OK, we've got them
   m_have_weight = true;
 
-  // Allocate the array
-  auto temp = new float[m_loadSize[0]];
-  delete[] m_event_weight;
-  m_event_weight = temp;
-
   ::NeXus::Info weight_info = file.getInfo();
   int64_t weight_dim0 = recalculateDataSize(weight_info.dims[0]);
   if (weight_dim0 < m_loadSize[0] + m_loadStart[0]) {
@@ -318,7 +369,8 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (weight_info.type == ::NeXus::FLOAT32)
-    file.getSlab(m_event_weight, m_loadStart, m_loadSize);
+    m_event_weight =
+        loadSlab<float>(file, "event_weight", m_compressed_event_weight);
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -331,10 +383,66 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   }
 }
 
+/** Whether any field was read as compressed chunks that are not decompressed
+ * yet
+ */
+bool LoadBankFromDiskTask::haveCompressedData() const {
+  return m_compressed_event_id || m_compressed_event_time_of_flight ||
+         m_compressed_event_weight;
+}
+
+/** Decompress the fields that were read as compressed chunks
+ */
+void LoadBankFromDiskTask::decompress() {
+  if (m_compressed_event_id) {
+    m_event_id = m_compressed_event_id->decompress();
+    m_compressed_event_id.reset();
+  }
+  if (m_compressed_event_time_of_flight) {
+    m_event_time_of_flight = m_compressed_event_time_of_flight->decompress();
+    m_compressed_event_time_of_flight.reset();
+  }
+  if (m_compressed_event_weight) {
+    m_event_weight = m_compressed_event_weight->decompress();
+    m_compressed_event_weight.reset();
+  }
+}
+
 void LoadBankFromDiskTask::run() {
+  if (haveCompressedData()) {
+    // This task was scheduled to decompress the data read by another one
+    try {
+      this->decompress();
+    } catch (std::exception &e) {
+      m_loader.alg->getLogger().error() << "Error while loading bank "
+                                        << entry_name << ":\n";
+      m_loader.alg->getLogger().error() << e.what() << '\n';
+      return;
+    }
+    this->processLoadedEvents();
+    return;
+  }
+
+  this->loadFromDisk();
+  // Abort if anything failed
+  if (m_loadError)
+    return;
+
+  if (haveCompressedData()) {
+    // Decompress in a task that does not hold the disk IO mutex, so that the
+    // next bank can be read meanwhile
+    scheduler.push(new LoadBankFromDiskTask(*this));
+    return;
+  }
+  this->processLoadedEvents();
+}
+
+/** Read the fields of the bank from the file. Sets m_loadError on failure.
+ */
+void LoadBankFromDiskTask::loadFromDisk() {
   // The vectors we will be filling
-  auto event_index_ptr = new std::vector<uint64_t>();
-  std::vector<uint64_t> &event_index = *event_index_ptr;
+  m_event_index = boost::make_shared<std::vector<uint64_t>>();
+  std::vector<uint64_t> &event_index = *m_event_index;
 
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
@@ -342,19 +450,24 @@ void LoadBankFromDiskTask::run() {
   m_loadSize.resize(1, 0);
 
   // Data arrays
-  m_event_id = nullptr;
-  m_event_time_of_flight = nullptr;
-  m_event_weight = nullptr;
+  m_event_id.reset();
+  m_event_time_of_flight.reset();
+  m_event_weight.reset();
+  m_compressed_event_id.reset();
+  m_compressed_event_time_of_flight.reset();
+  m_compressed_event_weight.reset();
 
   m_loadError = false;
   m_have_weight = m_loader.m_haveWeights;
 
   prog->report(entry_name + ": load from disk");
 
-  // Open the file
-  ::NeXus::File file(m_loader.alg->m_filename);
+  // The file opened by the algorithm, used by one task at a time under the
+  // disk IO mutex
+  ::NeXus::File &file = *m_loader.alg->m_file;
   try {
     // Navigate into the file
+    file.openPath("/");
     file.openGroup(m_loader.alg->m_top_entry_name, "NXentry");
     // Open the bankN_event group
     file.openGroup(entry_name, entry_type);
@@ -416,21 +529,30 @@ void LoadBankFromDiskTask::run() {
     m_loadError = true;
   }
 
-  // Close up the file even if errors occured.
-  file.closeGroup();
-  file.close();
+  // Leave the file at its root for the next task, even if errors occured.
+  try {
+    file.openPath("/");
+  } catch (::NeXus::Exception &) {
+    // The next task cannot use the file either and reports the error
+  }
 
-  // Abort if anything failed
   if (m_loadError) {
-    delete[] m_event_id;
-    delete[] m_event_time_of_flight;
-    if (m_have_weight) {
-      delete[] m_event_weight;
-    }
-    delete event_index_ptr;
+    m_event_id.reset();
+    m_event_time_of_flight.reset();
+    m_event_weight.reset();
+    m_compressed_event_id.reset();
+    m_compressed_event_time_of_flight.reset();
+    m_compressed_event_weight.reset();
+    m_event_index.reset();
+  }
+}
 
+/** Schedule the tasks that fill the event lists with the loaded events
+ */
+void LoadBankFromDiskTask::processLoadedEvents() {
+  this->findPixelIdRange();
+  if (m_loadError)
     return;
-  }
 
   const auto bank_size = m_max_id - m_min_id;
   const uint32_t minSpectraToLoad =
@@ -473,22 +595,16 @@ void LoadBankFromDiskTask::run() {
   size_t numEvents = m_loadSize[0];
   size_t startAt = m_loadStart[0];
 
-  // convert things to shared_arrays
-  boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-  boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
-  boost::shared_array<float> event_weight_shrd(m_event_weight);
-  boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
   ProcessBankData *newTask1 = new ProcessBankData(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-      numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
+      m_loader, entry_name, prog, m_event_id, m_event_time_of_flight,
+      numEvents, startAt, m_event_index, thisBankPulseTimes, m_have_weight,
+      m_event_weight, m_min_id, mid_id);
   scheduler.push(newTask1);
   if (m_loader.splitProcessing && (mid_id < m_max_id)) {
     ProcessBankData *newTask2 = new ProcessBankData(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
+        m_loader, entry_name, prog, m_event_id, m_event_time_of_flight,
+        numEvents, startAt, m_event_index, thisBankPulseTimes, m_have_weight,
+        m_event_weight, (mid_id + 1), m_max_id);
     scheduler.push(newTask2);
   }
 }
@@ -1,4 +1,5 @@
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataHandling/BankEventListLoader.h"
 #include "MantidDataHandling/LoadEventNexusIndexSetup.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
@@ -27,6 +28,7 @@
 #include <boost/shared_array.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
 #include <functional>
 
 using Mantid::Types::Core::DateAndTime;
@@ -70,6 +72,64 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
     }
   }
 }
+
+/**
+ * Find the limits of time-of-flight of all events in a workspace, in the same
+ * way as the default loader does while loading (see ProcessBankData).
+ *
+ * @param ws :: workspace with events of type TofEvent
+ * @param shortest :: output, the shortest time-of-flight
+ * @param longest :: output, the longest time-of-flight below 2e8
+ * @param bad :: output, the number of events with time-of-flight of 2e8 or more
+ */
+void findTofLimits(const EventWorkspace &ws, double &shortest, double &longest,
+                   size_t &bad) {
+  const auto numHistograms = static_cast<int64_t>(ws.getNumberHistograms());
+  std::vector<double> shortestInSpectrum(numHistograms, shortest);
+  std::vector<double> longestInSpectrum(numHistograms, longest);
+  std::vector<size_t> badInSpectrum(numHistograms, 0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numHistograms; ++i) {
+    for (const auto &event : ws.getSpectrum(i).getEvents()) {
+      const double tof = event.tof();
+      shortestInSpectrum[i] = std::min(shortestInSpectrum[i], tof);
+      // Skip any events that are the cause of bad DAS data
+      if (tof < 2e8)
+        longestInSpectrum[i] = std::max(longestInSpectrum[i], tof);
+      else
+        ++badInSpectrum[i];
+    }
+  }
+  for (int64_t i = 0; i < numHistograms; ++i) {
+    shortest = std::min(shortest, shortestInSpectrum[i]);
+    longest = std::max(longest, longestInSpectrum[i]);
+    bad += badInSpectrum[i];
+  }
+}
+
+/// Memory needed for an event in an EventWorkspace, in bytes, as estimated by
+/// DetermineChunking
+constexpr double BYTES_PER_EVENT = 48.0;
+constexpr double BYTES_TO_GiB = 1. / 1024. / 1024. / 1024.;
+
+/**
+ * Find the number of chunks needed to load all events using at most the given
+ * memory for each chunk.
+ *
+ * @param bankNumEvents :: number of events in each bank
+ * @param maxChunkSize :: memory for a chunk, in GiB
+ * @return the number of chunks
+ */
+int numberOfChunks(const std::vector<std::size_t> &bankNumEvents,
+                   const double maxChunkSize) {
+  if (maxChunkSize <= 0.0)
+    return 1;
+  const auto totalEvents = std::accumulate(
+      bankNumEvents.cbegin(), bankNumEvents.cend(), static_cast<size_t>(0));
+  const double sizeGiB =
+      static_cast<double>(totalEvents) * BYTES_PER_EVENT * BYTES_TO_GiB;
+  return static_cast<int>(sizeGiB / maxChunkSize) + 1;
+}
 }
 
 //----------------------------------------------------------------------------------------------
@@ -78,7 +138,8 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0),
       longest_tof(0), shortest_tof(0), bad_tofs(0), discarded_events(0),
-      compressTolerance(0), m_instrument_loaded_correctly(false),
+      compressTolerance(0), compressWallClockTolerance(EMPTY_DBL()),
+      eventsPerCompressedBlock(1 << 22), m_instrument_loaded_correctly(false),
       loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
 }
 
@@ -187,6 +248,17 @@ void LoadEventNexus::init() {
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
 
+  auto mustBePositiveDbl = boost::make_shared<BoundedValidator<double>>();
+  mustBePositiveDbl->setLower(0.0);
+  declareProperty("CompressWallClockTolerance", EMPTY_DBL(), mustBePositiveDbl,
+                  "The tolerance (in seconds) on the wall-clock time when "
+                  "compressing while loading, as in CompressEvents. Unset "
+                  "means compressing all wall-clock times together, which "
+                  "drops the pulse times of the events.");
+  setPropertySettings("CompressWallClockTolerance",
+                      make_unique<VisibleWhenProperty>("CompressTolerance",
+                                                       IS_NOT_DEFAULT));
+
   auto mustBePositive = boost::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
   declareProperty("ChunkNumber", EMPTY_INT(), mustBePositive,
@@ -201,11 +273,31 @@ void LoadEventNexus::init() {
   setPropertySettings("TotalChunks", make_unique<VisibleWhenProperty>(
                                          "ChunkNumber", IS_NOT_DEFAULT));
 
+  declareProperty("MaxChunkSize", EMPTY_DBL(), mustBePositiveDbl,
+                  "If set, the file is split into chunks of pulses whose "
+                  "events need at most this many GiB of memory, and the chunk "
+                  "given by ChunkNumber (the first if unset) is loaded with "
+                  "the logs of its pulses. LastChunk tells whether it is the "
+                  "last.");
+  declareProperty(make_unique<PropertyWithValue<bool>>("LastChunk", true,
+                                                       Direction::Output),
+                  "Whether the OutputWorkspace holds the last chunk of the "
+                  "file. Always true if MaxChunkSize is not set.");
+
+  declareProperty(make_unique<PropertyWithValue<bool>>("LoadEventsOnDemand",
+                                                       false, Direction::Input),
+                  "If true, the events of a bank are read from the file the "
+                  "first time a spectrum of the bank is used. The file must "
+                  "not be moved or modified while the workspace exists.");
+
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompressWallClockTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
+  setPropertyGroup("MaxChunkSize", grp3);
+  setPropertyGroup("LoadEventsOnDemand", grp3);
 
   declareProperty(make_unique<PropertyWithValue<bool>>("LoadMonitors", false,
                                                        Direction::Input),
@@ -303,10 +395,16 @@ void LoadEventNexus::init() {
       "Load the Sample/DAS logs from the file (default True).");
 
 #ifdef MPI_EXPERIMENTAL
-  declareProperty(make_unique<PropertyWithValue<bool>>("UseParallelLoader",
-                                                       true, Direction::Input),
-                  "Use experimental parallel loader for loading event data.");
+  const bool useParallelLoader = true;
+#else
+  // Opt in without MPI, since the default loader handles more cases
+  const bool useParallelLoader = false;
 #endif
+  declareProperty(make_unique<PropertyWithValue<bool>>(
+                      "UseParallelLoader", useParallelLoader, Direction::Input),
+                  "Use the parallel loader for loading event data, which "
+                  "parses events with multiple threads (or MPI processes). "
+                  "The default loader is used where it is not supported.");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -384,17 +482,23 @@ void LoadEventNexus::exec() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  compressWallClockTolerance = getProperty("CompressWallClockTolerance");
 
   loadlogs = getProperty("LoadLogs");
 
   // Check to see if the monitors need to be loaded later
   bool load_monitors = this->getProperty("LoadMonitors");
 
-  // this must make absolutely sure that m_file is a valid (and open)
-  // NeXus::File object
-  safeOpenFile(m_filename);
+  // The monitors of a file loaded in chunks come with the first chunk
+  const int chunkNumber = getProperty("ChunkNumber");
+  if (!isDefault("MaxChunkSize") && !isEmpty(chunkNumber) && chunkNumber > 1)
+    load_monitors = false;
+  setProperty("LastChunk", true);
 
-  setTopEntryName();
+  // Nothing is kept from an earlier execution of this algorithm object
+  m_logs_loaded_correctly = false;
+  m_instrument_loaded_correctly = false;
+  m_allBanksPulseTimes.reset();
 
   // Initialize progress reporting.
   int reports = 3;
@@ -402,6 +506,12 @@ void LoadEventNexus::exec() {
     reports++;
   Progress prog(this, 0.0, 0.3, reports);
 
+  // this must make absolutely sure that m_file is a valid (and open)
+  // NeXus::File object
+  safeOpenFile(m_filename);
+
+  setTopEntryName();
+
   // Load the detector events
   m_ws = boost::make_shared<EventWorkspaceCollection>(); // Algorithm currently
                                                          // relies on an
@@ -450,6 +560,39 @@ void LoadEventNexus::exec() {
   m_file->close();
 }
 
+//----------------------------------------------------------------------------------------------
+/** Validate the combination of properties
+ * @return map of property names to problems with them
+ */
+std::map<std::string, std::string> LoadEventNexus::validateInputs() {
+  std::map<std::string, std::string> result;
+  if (!isDefault("MaxChunkSize")) {
+    if (!isDefault("TotalChunks"))
+      result["MaxChunkSize"] = "Cannot be used together with TotalChunks.";
+    const bool logs = getProperty("LoadLogs");
+    if (!logs)
+      result["MaxChunkSize"] = "Needs LoadLogs, for the pulse times.";
+    std::vector<std::string> bankNames = getProperty("BankName");
+    if (!bankNames.empty())
+      result["MaxChunkSize"] = "Cannot be used together with BankName.";
+  }
+  const double tolerance = getProperty("CompressTolerance");
+  if (!isDefault("CompressWallClockTolerance") && tolerance < 0)
+    result["CompressWallClockTolerance"] =
+        "Cannot be used without CompressTolerance.";
+  const bool onDemand = getProperty("LoadEventsOnDemand");
+  if (onDemand) {
+    for (const auto &name :
+         {"FilterByTofMin", "FilterByTofMax", "FilterByTimeStart",
+          "FilterByTimeStop", "CompressTolerance", "ChunkNumber",
+          "MaxChunkSize"})
+      if (!isDefault(name))
+        result["LoadEventsOnDemand"] =
+            std::string("Cannot be used together with ") + name + ".";
+  }
+  return result;
+}
+
 /**
 * Get the number of events in the currently opened group.
 *
@@ -780,6 +923,12 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     }
   }
 
+  // A file loaded in chunks is split into ranges of pulses
+  const double maxChunkSize = getProperty("MaxChunkSize");
+  if (!monitors && !isEmpty(maxChunkSize) &&
+      selectChunkOfPulses(bankNumEvents, maxChunkSize))
+    is_time_filtered = true;
+
   if (is_time_filtered) {
     // Now filter out the run, using the DateAndTime type.
     m_ws->mutableRun().filterByTime(filter_time_start, filter_time_stop);
@@ -856,20 +1005,43 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
+  // The wall-clock time bins start with the run, as in CompressEvents
+  if (!isEmpty(compressWallClockTolerance)) {
+    try {
+      compressStartTime = m_ws->run().startTime();
+    } catch (std::runtime_error &) {
+      compressStartTime = run_start;
+    }
+  }
+
+  const bool onDemand = getProperty("LoadEventsOnDemand");
+  if (onDemand && !monitors &&
+      loadEventsOnDemand(haveWeights, oldNeXusFileNames, bankNames))
+    return;
+
   bool loaded{false};
   if (canUseParallelLoader(haveWeights, oldNeXusFileNames, classType)) {
     auto ws = m_ws->getSingleHeldWorkspace();
     m_file->close();
     try {
       ParallelEventLoader::load(*ws, m_filename, m_top_entry_name, bankNames,
-                                event_id_is_spec);
+                                event_id_is_spec, filter_time_start,
+                                filter_time_stop);
       g_log.information() << "Used ParallelEventLoader.\n";
       loaded = true;
-      shortest_tof = 0.0;
-      longest_tof = 1e10;
-    } catch (const std::runtime_error &) {
+      if (communicator().size() == 1) {
+        findTofLimits(*ws, shortest_tof, longest_tof, bad_tofs);
+      } else {
+        shortest_tof = 0.0;
+        longest_tof = 1e10;
+      }
+    } catch (const std::runtime_error &e) {
       g_log.warning()
-          << "ParallelEventLoader failed, falling back to default loader.\n";
+          << "ParallelEventLoader failed, falling back to default loader: "
+          << e.what() << "\n";
+      // Drop events of banks that were loaded before the failure.
+      for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+        ws->getSpectrum(i).clear(false);
     }
     safeOpenFile(m_filename);
   }
@@ -877,12 +1049,132 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     bool precount = getProperty("Precount");
     int chunk = getProperty("ChunkNumber");
     int totalChunks = getProperty("TotalChunks");
+    // With MaxChunkSize, the chunk is a range of pulses set by the time filter
+    if (!isEmpty(maxChunkSize))
+      chunk = totalChunks = EMPTY_INT();
     DefaultEventLoader::load(this, *m_ws, haveWeights, event_id_is_spec,
                              bankNames, periodLog->valuesAsVector(), classType,
                              bankNumEvents, oldNeXusFileNames, precount, chunk,
                              totalChunks);
   }
 
+  finishLoadingEvents(classType);
+}
+
+//-----------------------------------------------------------------------------
+/**
+* Narrow the time filter to the pulses of the chunk given by ChunkNumber, the
+* first if unset, when the file is loaded in chunks. The pulses within the
+* filter are split into ranges of equal numbers of pulses, as many as needed
+* for the events of a range to need at most maxChunkSize GiB on average.
+* Sets LastChunk.
+* @param bankNumEvents :: The number of events in each bank
+* @param maxChunkSize :: Memory for the events of a chunk, in GiB
+* @return true if the chunk is not the whole run
+* @throw std::runtime_error if there are no increasing pulse times
+* @throw std::out_of_range if ChunkNumber is larger than the number of chunks
+*/
+bool LoadEventNexus::selectChunkOfPulses(
+    const std::vector<std::size_t> &bankNumEvents, const double maxChunkSize) {
+  const auto begin = m_allBanksPulseTimes->pulseTimes;
+  const auto end = begin + m_allBanksPulseTimes->numPulses;
+  if (begin == end || !std::is_sorted(begin, end))
+    throw std::runtime_error("Loading in chunks needs the increasing pulse "
+                             "times of the proton_charge log.");
+  const auto first = std::lower_bound(begin, end, filter_time_start);
+  const auto last = std::upper_bound(first, end, filter_time_stop);
+  const auto numPulses = std::distance(first, last);
+  const int totalChunks = static_cast<int>(std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(numberOfChunks(bankNumEvents, maxChunkSize),
+                                  numPulses)));
+  int chunk = getProperty("ChunkNumber");
+  if (isEmpty(chunk))
+    chunk = 1;
+  if (chunk > totalChunks)
+    throw std::out_of_range("ChunkNumber cannot be larger than the number of "
+                            "chunks, " +
+                            std::to_string(totalChunks));
+  setProperty("LastChunk", chunk == totalChunks);
+  if (totalChunks == 1)
+    return false;
+
+  // The first pulse of a chunk. The filter includes its stop time.
+  const auto chunkStart = [&](const int i) {
+    return *(first + numPulses * (i - 1) / totalChunks);
+  };
+  if (chunk > 1)
+    filter_time_start = chunkStart(chunk);
+  if (chunk < totalChunks)
+    filter_time_stop =
+        DateAndTime(chunkStart(chunk + 1).totalNanoseconds() - 1);
+  g_log.information() << "Loading chunk " << chunk << " of " << totalChunks
+                      << ", the pulses from "
+                      << filter_time_start.toSimpleString() << " to "
+                      << filter_time_stop.toSimpleString() << "\n";
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+/**
+* Set up the workspace to read the events of a bank the first time one of its
+* spectra is accessed, instead of loading the events now. Falls back to
+* loading all events if the file or workspace cannot be loaded on demand.
+* @param haveWeights :: Whether the events have weights
+* @param oldNeXusFileNames :: Whether the file uses the old names of fields
+* @param bankNames :: The NXevent_data groups with the events
+* @return true if the events will be loaded on demand
+*/
+bool LoadEventNexus::loadEventsOnDemand(
+    const bool haveWeights, const bool oldNeXusFileNames,
+    const std::vector<std::string> &bankNames) {
+  if (m_ws->nPeriods() != 1 || oldNeXusFileNames || event_id_is_spec) {
+    g_log.warning() << "Events of multi-period files, old files or files with "
+                       "spectrum numbers cannot be loaded on demand. Loading "
+                       "all events.\n";
+    return false;
+  }
+
+  auto ws = m_ws->getSingleHeldWorkspace();
+  double tofOffset = 0.0;
+  if (ws->getInstrument()->hasParameter("T0")) {
+    const auto instrumentT0 =
+        ws->getInstrument()->getNumberParameter("T0", true);
+    if (!instrumentT0.empty())
+      tofOffset = instrumentT0.front();
+  }
+  // The lists must hold the type of events the loader adds before it is set
+  if (haveWeights) {
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+      ws->getSpectrum(i).switchTo(API::WEIGHTED);
+  }
+  try {
+    ws->setEventListLoader(std::make_shared<BankEventListLoader>(
+        *ws, m_filename, m_top_entry_name, bankNames, haveWeights, tofOffset));
+  } catch (std::runtime_error &e) {
+    g_log.warning() << "Cannot load the events on demand, loading all events: "
+                    << e.what() << "\n";
+    return false;
+  }
+  if (tofOffset != 0.0)
+    m_ws->mutableRun().addProperty<double>("T0", tofOffset, true);
+
+  // finishLoadingEvents is not called: the loader adds T0 to the events it
+  // reads, and the range of time-of-flight is not known without reading all
+  // event_time_offset fields, so the single bin covers every time-of-flight
+  // the loaders accept. A time_of_flight binning in the file is not used.
+  m_ws->setAllX(HistogramData::BinEdges{
+      0.0, static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1});
+  g_log.information() << "The events of " << bankNames.size()
+                      << " banks will be loaded on demand.\n";
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+/**
+* Report on the loaded events and set up the binning of the workspace.
+* @param classType :: The NeXus class of the groups the events were loaded from
+*/
+void LoadEventNexus::finishLoadingEvents(const std::string &classType) {
   // Info reporting
   const std::size_t eventsLoaded = m_ws->getNumberEvents();
   g_log.information() << "Read " << eventsLoaded << " events"
@@ -1672,15 +1964,14 @@ void LoadEventNexus::safeOpenFile(const std::string fname) {
 bool LoadEventNexus::canUseParallelLoader(const bool haveWeights,
                                           const bool oldNeXusFileNames,
                                           const std::string &classType) const {
-#ifndef MPI_EXPERIMENTAL
-  // Actually the parallel loader would work also in non-MPI builds but it is
-  // likely to be slower than the default loader and may also exhibit unusual
-  // behavior for non-standard Nexus files.
-  return false;
-#else
   bool useParallelLoader = getProperty("UseParallelLoader");
   if (!useParallelLoader)
     return false;
+#ifndef MPI_EXPERIMENTAL
+  // Without MPI more than one rank is only emulated by threads, e.g., in tests,
+  // which requires locking of HDF5 that the parallel loader does not support.
+  if (communicator().size() != 1)
+    return false;
 #endif
   if (m_ws->nPeriods() != 1)
     return false;
@@ -1690,13 +1981,11 @@ bool LoadEventNexus::canUseParallelLoader(const bool haveWeights,
     return false;
   if (filter_tof_min != -1e20 || filter_tof_max != 1e20)
     return false;
-  if (filter_time_start != Types::Core::DateAndTime::minimum() ||
-      filter_time_stop != Types::Core::DateAndTime::maximum())
-    return false;
   if (!isDefault("CompressTolerance") || !isDefault("SpectrumMin") ||
       !isDefault("SpectrumMax") || !isDefault("SpectrumList") ||
-      !isDefault("ChunkNumber"))
+      !isDefault("ChunkNumber") || !isDefault("MaxChunkSize"))
     return false;
+  // Monitors have no event_id to map their events to spectra
   if (classType != "NXevent_data")
     return false;
   return true;
@@ -0,0 +1,122 @@
+#include "MantidDataHandling/MemoryMappedNexusFile.h"
+#include "MantidDataHandling/H5Util.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/make_unique.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+#include <Poco/SharedMemory.h>
+
+#include <ostream>
+
+using namespace H5;
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// static logger object
+Kernel::Logger g_log("MemoryMappedNexusFile");
+}
+
+/** Open the file and map it, read-only, into memory. Failures are not
+ * errors: isMapped() returns false and no dataset can be mapped.
+ * @param filename :: path to the NeXus file
+ */
+MemoryMappedNexusFile::MemoryMappedNexusFile(const std::string &filename) {
+  try {
+    m_file = Kernel::make_unique<H5File>(filename, H5F_ACC_RDONLY);
+    m_mapping = std::make_shared<Poco::SharedMemory>(
+        Poco::File(filename), Poco::SharedMemory::AM_READ);
+  } catch (H5::Exception &e) {
+    g_log.debug() << "Cannot open " << filename
+                  << " to map it: " << e.getDetailMsg() << "\n";
+    m_mapping.reset();
+  } catch (std::exception &e) {
+    g_log.debug() << "Cannot map " << filename << ": " << e.what() << "\n";
+    m_mapping.reset();
+  }
+}
+
+MemoryMappedNexusFile::~MemoryMappedNexusFile() = default;
+
+/** Get a slab of a 1D dataset in place in the mapped file.
+ * The returned array points into a read-only mapping and must not be written
+ * to; it keeps the file mapped for as long as it is in use.
+ * @param path :: absolute path of the dataset in the file
+ * @param start :: index of the first value
+ * @param count :: number of values
+ * @return the values, or a null array if the dataset cannot be mapped
+ */
+template <typename NumT>
+boost::shared_array<NumT>
+MemoryMappedNexusFile::mapSlab(const std::string &path, const size_t start,
+                               const size_t count) const {
+  const char *data =
+      mapDataset(path, H5Util::getType<NumT>(), start, count, sizeof(NumT));
+  if (!data)
+    return boost::shared_array<NumT>();
+  auto mapping = m_mapping;
+  return boost::shared_array<NumT>(
+      reinterpret_cast<NumT *>(const_cast<char *>(data)),
+      [mapping](NumT *) {});
+}
+
+/** Find where a slab of a 1D dataset is in the mapped file.
+ * @param path :: absolute path of the dataset in the file
+ * @param type :: the type the values must be stored as (a native type)
+ * @param start :: index of the first value
+ * @param count :: number of values
+ * @param typeSize :: size of one value, in bytes
+ * @return a pointer to the first value, or nullptr if the dataset is not
+ *         stored contiguously, has another type or is too small
+ */
+const char *MemoryMappedNexusFile::mapDataset(const std::string &path,
+                                              const DataType &type,
+                                              const size_t start,
+                                              const size_t count,
+                                              const size_t typeSize) const {
+  if (!m_mapping)
+    return nullptr;
+
+  try {
+    DataSet dataset = m_file->openDataSet(path);
+    // Chunked datasets (the only ones that can be compressed) are stored in
+    // pieces all over the file.
+    if (dataset.getCreatePlist().getLayout() != H5D_CONTIGUOUS)
+      return nullptr;
+    // Equality of the types includes the byte order.
+    if (!(dataset.getDataType() == type))
+      return nullptr;
+    DataSpace space = dataset.getSpace();
+    if (space.getSimpleExtentNdims() != 1 ||
+        static_cast<size_t>(space.getSimpleExtentNpoints()) < start + count)
+      return nullptr;
+    // Space for the data may not have been allocated.
+    const haddr_t offset = dataset.getOffset();
+    if (offset == HADDR_UNDEF)
+      return nullptr;
+
+    const size_t begin = static_cast<size_t>(offset) + start * typeSize;
+    const size_t mappedSize =
+        static_cast<size_t>(m_mapping->end() - m_mapping->begin());
+    // The mapping is page aligned, so this aligns the values too.
+    if (begin % typeSize != 0 || begin + count * typeSize > mappedSize)
+      return nullptr;
+    return m_mapping->begin() + begin;
+  } catch (H5::Exception &e) {
+    g_log.debug() << "Cannot map " << path << ": " << e.getDetailMsg()
+                  << "\n";
+    return nullptr;
+  }
+}
+
+template MANTID_DATAHANDLING_DLL boost::shared_array<uint32_t>
+MemoryMappedNexusFile::mapSlab(const std::string &, const size_t,
+                               const size_t) const;
+template MANTID_DATAHANDLING_DLL boost::shared_array<float>
+MemoryMappedNexusFile::mapSlab(const std::string &, const size_t,
+                               const size_t) const;
+
+} // namespace DataHandling
+} // namespace Mantid
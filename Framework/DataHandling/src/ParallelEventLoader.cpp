@@ -2,15 +2,22 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidIndexing/IndexInfo.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadBudget.h"
+#include "MantidParallel/Communicator.h"
 #include "MantidParallel/IO/EventLoader.h"
 #include "MantidTypes/SpectrumDefinition.h"
 #include "MantidTypes/Event/TofEvent.h"
 
+#include <H5Cpp.h>
+
+#include <stdexcept>
+
 namespace Mantid {
 namespace DataHandling {
 
 /// Return offset between global spectrum index and detector ID for given banks.
-std::vector<int32_t> bankOffsets(const API::ExperimentInfo &ws,
+std::vector<int32_t> bankOffsets(const API::MatrixWorkspace &ws,
                                  const std::string &filename,
                                  const std::string &groupName,
                                  const std::vector<std::string> &bankNames) {
@@ -41,6 +48,9 @@ std::vector<int32_t> bankOffsets(const API::ExperimentInfo &ws,
       spectrumIndex++;
     }
   }
+  if (static_cast<size_t>(spectrumIndex) != ws.indexInfo().globalSize())
+    throw std::runtime_error(
+        "ParallelEventLoader: spectra do not map 1:1 to detectors");
   return bankOffsets;
 }
 
@@ -74,24 +84,59 @@ std::vector<int32_t> bankOffsetsSpectrumNumbers(
   return bankOffsets;
 }
 
-/// Load events from given banks into given EventWorkspace.
+/** Load events from given banks into given EventWorkspace.
+ *
+ * Without MPI the events are parsed by as many threads as the ThreadBudget
+ * has left, up to the number OpenMP may use, while the calling thread reads.
+ * @param ws :: workspace with one spectrum per detector
+ * @param filename :: path to the NeXus file
+ * @param groupName :: the NXentry containing the banks
+ * @param bankNames :: names of the NXevent_data groups to load
+ * @param eventIDIsSpectrumNumber :: if true event IDs are spectrum numbers,
+ * otherwise detector IDs
+ * @param pulseTimeStart :: events with earlier pulse times are not loaded
+ * @param pulseTimeStop :: events with later pulse times are not loaded
+ */
 void ParallelEventLoader::load(DataObjects::EventWorkspace &ws,
                                const std::string &filename,
                                const std::string &groupName,
                                const std::vector<std::string> &bankNames,
-                               const bool eventIDIsSpectrumNumber) {
+                               const bool eventIDIsSpectrumNumber,
+                               const Types::Core::DateAndTime &pulseTimeStart,
+                               const Types::Core::DateAndTime &pulseTimeStop) {
   const size_t size = ws.getNumberHistograms();
   std::vector<std::vector<Types::Event::TofEvent> *> eventLists(size, nullptr);
   for (size_t i = 0; i < size; ++i)
     DataObjects::getEventsFrom(ws.getSpectrum(i), eventLists[i]);
-  const auto offsets =
-      eventIDIsSpectrumNumber
-          ? bankOffsetsSpectrumNumbers(ws, filename, groupName, bankNames)
-          : bankOffsets(ws, filename, groupName, bankNames);
+  // HDF5 errors, e.g., from banks without `event_id`, are reported as
+  // std::runtime_error such that callers can fall back to another loader.
+  try {
+    const auto offsets =
+        eventIDIsSpectrumNumber
+            ? bankOffsetsSpectrumNumbers(ws, filename, groupName, bankNames)
+            : bankOffsets(ws, filename, groupName, bankNames);
 
-  Parallel::IO::EventLoader::load(ws.indexInfo().communicator(), filename,
-                                  groupName, bankNames, offsets,
-                                  std::move(eventLists));
+    const auto &comm = ws.indexInfo().communicator();
+    // The events are parsed on other threads than the calling one, so the
+    // threads are reserved from the ThreadBudget for the whole load.
+    const size_t reserved =
+        comm.size() == 1
+            ? Kernel::ThreadBudget::reserve(
+                  static_cast<size_t>(PARALLEL_GET_MAX_THREADS))
+            : 0;
+    try {
+      Parallel::IO::EventLoader::load(comm, filename, groupName, bankNames,
+                                      offsets, std::move(eventLists),
+                                      static_cast<int>(reserved),
+                                      pulseTimeStart, pulseTimeStop);
+    } catch (...) {
+      Kernel::ThreadBudget::release(reserved);
+      throw;
+    }
+    Kernel::ThreadBudget::release(reserved);
+  } catch (const H5::Exception &e) {
+    throw std::runtime_error("ParallelEventLoader: " + e.getDetailMsg());
+  }
 }
 
 } // namespace DataHandling
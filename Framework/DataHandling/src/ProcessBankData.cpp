@@ -1,6 +1,9 @@
+#include "MantidDataHandling/BankEventParser.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/make_unique.h"
 
 using namespace Mantid::DataObjects;
 
@@ -31,19 +34,25 @@ ProcessBankData::ProcessBankData(
  * FIXME/TODO - split run() into readable methods
  */
 void ProcessBankData::run() { // override {
-  // Local tof limits
-  double my_shortest_tof =
-      static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
-  double my_longest_tof = 0.;
-  // A count of "bad" TOFs that were too high
-  size_t badTofs = 0;
-  size_t my_discarded_events(0);
-
   prog->report(entry_name + ": precount");
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+
+  // Will we need to compress?
+  bool compress = (alg->compressTolerance >= 0);
+  // Large banks are compressed a block of events at a time while they are
+  // parsed. Each compressed block is merged into the events of the earlier
+  // blocks, which are compressed again, so that only one block and the
+  // compressed events are held. This may group events a little differently
+  // from compressing the bank in one pass.
+  const size_t blockSize = alg->eventsPerCompressedBlock;
+  const bool compressInBlocks = compress && blockSize > 0 &&
+                                numEvents > blockSize &&
+                                outputWS.nPeriods() == 1;
+
+  // Reserving space for all events would defeat compressing in blocks
+  if (m_loader.precount && !compressInBlocks) {
 
     std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
@@ -74,127 +83,53 @@ void ProcessBankData::run() { // override {
     return;
   }
 
-  // Default pulse time (if none are found)
-  Mantid::Types::Core::DateAndTime pulsetime;
-  int periodNumber = 1;
-  int periodIndex = 0;
-  Mantid::Types::Core::DateAndTime lastpulsetime(0);
-
-  bool pulsetimesincreasing = true;
-
-  // Index into the pulse array
-  int pulse_i = 0;
-
-  // And there are this many pulses
-  int numPulses = static_cast<int>(thisBankPulseTimes->numPulses);
-  if (numPulses > static_cast<int>(event_index->size())) {
+  BankEventParser parser(*event_index, *thisBankPulseTimes, startAt, m_min_id,
+                         m_max_id, alg->filter_tof_min, alg->filter_tof_max);
+  if (!parser.havePulseTimes()) {
     alg->getLogger().warning()
         << "Entry " << entry_name
         << "'s event_index vector is smaller than the event_time_zero field. "
            "This is inconsistent, so we cannot find pulse times for this "
            "entry.\n";
-    // This'll make the code skip looking for any pulse times.
-    pulse_i = numPulses + 1;
   }
 
   prog->report(entry_name + ": filling events");
 
-  // Will we need to compress?
-  bool compress = (alg->compressTolerance >= 0);
-
   // Which detector IDs were touched? - only matters if compress is on
   std::vector<bool> usedDetIds;
   if (compress)
     usedDetIds.assign(m_max_id - m_min_id + 1, false);
+  // The detector IDs touched by the current block and the compressed events of
+  // the blocks so far, when compressing in blocks
+  std::vector<bool> blockDetIds;
+  std::vector<std::unique_ptr<EventList>> compressed;
+  if (compressInBlocks) {
+    blockDetIds.assign(m_max_id - m_min_id + 1, false);
+    compressed.resize(m_max_id - m_min_id + 1);
+  }
 
-  // Go through all events in the list
-  for (std::size_t i = 0; i < numEvents; i++) {
-    //------ Find the pulse time for this event index ---------
-    if (pulse_i < numPulses - 1) {
-      bool breakOut = false;
-      // Go through event_index until you find where the index increases to
-      // encompass the current index. Your pulse = the one before.
-      while ((i + startAt < event_index->operator[](pulse_i)) ||
-             (i + startAt >= event_index->operator[](pulse_i + 1))) {
-        pulse_i++;
-        // Check once every new pulse if you need to cancel (checking on every
-        // event might slow things down more)
-        if (alg->getCancel())
-          breakOut = true;
-        if (pulse_i >= (numPulses - 1))
-          break;
-      }
-
-      // Save the pulse time at this index for creating those events
-      pulsetime = thisBankPulseTimes->pulseTimes[pulse_i];
-      int logPeriodNumber = thisBankPulseTimes->periodNumbers[pulse_i];
-      periodNumber = logPeriodNumber > 0
-                         ? logPeriodNumber
-                         : periodNumber; // Some historic files have recorded
-                                         // their logperiod numbers as zeros!
-      periodIndex = periodNumber - 1;
-
-      // Determine if pulse times continue to increase
-      if (pulsetime < lastpulsetime)
-        pulsetimesincreasing = false;
-      else
-        lastpulsetime = pulsetime;
-
-      // Flag to break out of the event loop without using goto
-      if (breakOut)
-        break;
-    }
-
-    // We cached a pointer to the vector<tofEvent> -> so retrieve it and add
-    // the event
-    detid_t detId = event_id[i];
-    if (detId >= m_min_id && detId <= m_max_id) {
-      // Create the tofevent
-      double tof = static_cast<double>(event_time_of_flight[i]);
-      if ((tof >= alg->filter_tof_min) && (tof <= alg->filter_tof_max)) {
-        // Handle simulated data if present
-        if (have_weight) {
-          double weight = static_cast<double>(event_weight[i]);
-          double errorSq = weight * weight;
-          auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
-          // NULL eventVector indicates a bad spectrum lookup
-          if (eventVector) {
-            eventVector->emplace_back(tof, pulsetime, weight, errorSq);
-          } else {
-            ++my_discarded_events;
-          }
-        } else {
-          // We have cached the vector of events for this detector ID
-          auto *eventVector = m_loader.eventVectors[periodIndex][detId];
-          // NULL eventVector indicates a bad spectrum lookup
-          if (eventVector) {
-            eventVector->emplace_back(tof, pulsetime);
-          } else {
-            ++my_discarded_events;
-          }
-        }
-
-        // Local tof limits
-        if (tof < my_shortest_tof) {
-          my_shortest_tof = tof;
-        }
-        // Skip any events that are the cause of bad DAS data (e.g. a negative
-        // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
-        if (tof < 2e8) {
-          if (tof > my_longest_tof) {
-            my_longest_tof = tof;
-          }
-        } else
-          badTofs++;
-
-        // Track all the touched wi (only necessary when compressing events,
-        // for thread safety)
-        if (compress)
-          usedDetIds[detId - m_min_id] = true;
-      } // valid time-of-flight
-
-    } // valid detector IDs
-  }   //(for each event)
+  // Go through all events in the list, a block at a time if compressing in
+  // blocks
+  auto cancelled = [alg]() { return alg->getCancel(); };
+  const size_t step = compressInBlocks ? blockSize : numEvents;
+  for (size_t first = 0; first < numEvents; first += step) {
+    const size_t last = std::min(first + step, numEvents);
+    auto *touched = compressInBlocks ? &blockDetIds
+                                     : (compress ? &usedDetIds : nullptr);
+    const bool parsed =
+        have_weight
+            ? parser.parse(event_id.get(), event_time_of_flight.get(),
+                           event_weight.get(), first, last,
+                           m_loader.weightedEventVectors, touched, cancelled)
+            : parser.parse(event_id.get(), event_time_of_flight.get(), nullptr,
+                           first, last, m_loader.eventVectors, touched,
+                           cancelled);
+    if (compressInBlocks)
+      compressBlock(blockDetIds, usedDetIds, compressed);
+    if (!parsed)
+      break;
+  }
+  const bool pulsetimesincreasing = parser.pulseTimesIncreasing();
 
   //------------ Compress Events (or set sort order) ------------------
   // Do it on all the detector IDs we touched
@@ -204,8 +139,12 @@ void ProcessBankData::run() { // override {
         // Find the the workspace index corresponding to that pixel ID
         size_t wi = getWorkspaceIndexFromPixelID(pixID);
         auto &el = outputWS.getSpectrum(wi);
-        if (compress)
-          el.compressEvents(alg->compressTolerance, &el);
+        if (compressInBlocks) {
+          // Move the compressed events of all blocks to the spectrum
+          compressEvents(*compressed[pixID - m_min_id], &el);
+          compressed[pixID - m_min_id].reset();
+        } else if (compress)
+          compressEvents(el, &el);
         else {
           if (pulsetimesincreasing)
             el.setSortOrder(DataObjects::PULSETIME_SORT);
@@ -226,14 +165,14 @@ void ProcessBankData::run() { // override {
   // This is not thread safe, so only one thread at a time runs this.
   {
     std::lock_guard<std::mutex> _lock(alg->m_tofMutex);
-    if (my_shortest_tof < alg->shortest_tof) {
-      alg->shortest_tof = my_shortest_tof;
+    if (parser.shortestTof() < alg->shortest_tof) {
+      alg->shortest_tof = parser.shortestTof();
     }
-    if (my_longest_tof > alg->longest_tof) {
-      alg->longest_tof = my_longest_tof;
+    if (parser.longestTof() > alg->longest_tof) {
+      alg->longest_tof = parser.longestTof();
     }
-    alg->bad_tofs += badTofs;
-    alg->discarded_events += my_discarded_events;
+    alg->bad_tofs += parser.badTofs();
+    alg->discarded_events += parser.discardedEvents();
   }
 
 #ifndef _WIN32
@@ -242,6 +181,59 @@ void ProcessBankData::run() { // override {
 #endif
 } // END-OF-RUN()
 
+/**
+ * Compress events with the tolerances of the algorithm, keeping the pulse
+ * times within the wall-clock tolerance if one is set.
+ *
+ * @param input :: The list with the events to compress
+ * @param output :: The list for the compressed events, may be the input
+ */
+void ProcessBankData::compressEvents(EventList &input,
+                                     EventList *output) const {
+  const auto *alg = m_loader.alg;
+  if (alg->compressWallClockTolerance == EMPTY_DBL())
+    input.compressEvents(alg->compressTolerance, output);
+  else
+    input.compressFatEvents(alg->compressTolerance, alg->compressStartTime,
+                            alg->compressWallClockTolerance, output);
+}
+
+/**
+ * Compress the events added to the spectra since the last block and merge them
+ * into the compressed events of the earlier blocks, compressing those again so
+ * that they do not grow with the number of blocks. The vectors of the spectra
+ * keep their capacity for the events of the next block.
+ *
+ * @param blockDetIds :: Flags for the detector IDs touched by the block, reset
+ * @param usedDetIds :: Flags for the detector IDs touched by all blocks
+ * @param compressed :: The compressed events of each detector ID
+ */
+void ProcessBankData::compressBlock(
+    std::vector<bool> &blockDetIds, std::vector<bool> &usedDetIds,
+    std::vector<std::unique_ptr<EventList>> &compressed) {
+  for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
+    if (!blockDetIds[pixID - m_min_id])
+      continue;
+    blockDetIds[pixID - m_min_id] = false;
+    usedDetIds[pixID - m_min_id] = true;
+    auto &el = m_loader.m_ws.getSpectrum(getWorkspaceIndexFromPixelID(pixID));
+    EventList block;
+    compressEvents(el, &block);
+    if (have_weight)
+      el.getWeightedEvents().clear();
+    else
+      el.getEvents().clear();
+    el.setSortOrder(UNSORTED);
+    auto &events = compressed[pixID - m_min_id];
+    if (events) {
+      *events += block;
+      compressEvents(*events, events.get());
+    } else {
+      events = Kernel::make_unique<EventList>(block);
+    }
+  }
+}
+
 /**
  * Get the workspace index for a given pixel ID. Throws if the pixel ID is
  * not in the expected range.
@@ -0,0 +1,123 @@
+#ifndef MANTID_DATAHANDLING_DIRECTCHUNKREADERTEST_H_
+#define MANTID_DATAHANDLING_DIRECTCHUNKREADERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/DirectChunkReader.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+
+#include <numeric>
+#include <vector>
+
+using namespace H5;
+using Mantid::DataHandling::DirectChunkReader;
+
+class DirectChunkReaderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DirectChunkReaderTest *createSuite() {
+    return new DirectChunkReaderTest();
+  }
+  static void destroySuite(DirectChunkReaderTest *suite) { delete suite; }
+
+  DirectChunkReaderTest() : m_filename("DirectChunkReaderTest.h5") {
+    removeFile();
+    std::vector<uint32_t> ids(1000);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::vector<float> tofs(1000);
+    std::iota(tofs.begin(), tofs.end(), 0.5f);
+    hsize_t dims[] = {1000};
+    DataSpace space(1, dims);
+    hsize_t chunk[] = {128};
+
+    H5File file(m_filename, H5F_ACC_EXCL);
+    Group group = file.createGroup("/entry");
+    DSetCreatPropList deflate;
+    deflate.setChunk(1, chunk);
+    deflate.setDeflate(6);
+    group.createDataSet("event_id", PredType::NATIVE_UINT32, space, deflate)
+        .write(ids.data(), PredType::NATIVE_UINT32);
+    group.createDataSet("event_time_offset", PredType::NATIVE_FLOAT, space,
+                        deflate)
+        .write(tofs.data(), PredType::NATIVE_FLOAT);
+    // Shuffled before compression
+    DSetCreatPropList shuffle;
+    shuffle.setChunk(1, chunk);
+    shuffle.setShuffle();
+    shuffle.setDeflate(6);
+    group.createDataSet("shuffled_id", PredType::NATIVE_UINT32, space, shuffle)
+        .write(ids.data(), PredType::NATIVE_UINT32);
+    // Contiguous
+    group.createDataSet("contiguous_id", PredType::NATIVE_UINT32, space)
+        .write(ids.data(), PredType::NATIVE_UINT32);
+    file.close();
+  }
+
+  ~DirectChunkReaderTest() override { removeFile(); }
+
+  void test_read_and_decompress_slab() {
+    DirectChunkReader reader(m_filename);
+    if (!reader.isOpen())
+      return; // HDF5 library without direct chunk read
+    auto slab = reader.readSlab<uint32_t>("/entry/event_id", 100, 700);
+    TS_ASSERT(slab);
+    TS_ASSERT_EQUALS(slab->size(), 700);
+    const auto ids = slab->decompress();
+    for (size_t i = 0; i < 700; ++i)
+      TS_ASSERT_EQUALS(ids[i], i + 100);
+  }
+
+  void test_slab_within_one_chunk() {
+    DirectChunkReader reader(m_filename);
+    if (!reader.isOpen())
+      return;
+    auto slab = reader.readSlab<float>("/entry/event_time_offset", 130, 10);
+    TS_ASSERT(slab);
+    const auto tofs = slab->decompress();
+    TS_ASSERT_EQUALS(tofs[0], 130.5f);
+    TS_ASSERT_EQUALS(tofs[9], 139.5f);
+  }
+
+  void test_slab_up_to_end_of_dataset() {
+    DirectChunkReader reader(m_filename);
+    if (!reader.isOpen())
+      return;
+    // The last chunk is only partially filled
+    auto slab = reader.readSlab<uint32_t>("/entry/event_id", 0, 1000);
+    TS_ASSERT(slab);
+    const auto ids = slab->decompress();
+    TS_ASSERT_EQUALS(ids[0], 0);
+    TS_ASSERT_EQUALS(ids[999], 999);
+  }
+
+  void test_datasets_that_cannot_be_read() {
+    DirectChunkReader reader(m_filename);
+    // Other filters
+    TS_ASSERT(!reader.readSlab<uint32_t>("/entry/shuffled_id", 0, 10));
+    // Not chunked
+    TS_ASSERT(!reader.readSlab<uint32_t>("/entry/contiguous_id", 0, 10));
+    // Wrong type
+    TS_ASSERT(!reader.readSlab<float>("/entry/event_id", 0, 10));
+    // Past the end
+    TS_ASSERT(!reader.readSlab<uint32_t>("/entry/event_id", 990, 20));
+  }
+
+  void test_missing_file_is_not_open() {
+    DirectChunkReader reader("DirectChunkReaderTest_missing.h5");
+    TS_ASSERT(!reader.isOpen());
+    TS_ASSERT(!reader.readSlab<uint32_t>("/entry/event_id", 0, 10));
+  }
+
+private:
+  void removeFile() {
+    if (Poco::File(m_filename).exists())
+      Poco::File(m_filename).remove();
+  }
+
+  const std::string m_filename;
+};
+
+#endif /* MANTID_DATAHANDLING_DIRECTCHUNKREADERTEST_H_ */
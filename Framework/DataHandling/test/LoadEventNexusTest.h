@@ -42,12 +42,42 @@ load_reference_workspace(const std::string &filename) {
   auto alg = ParallelTestHelpers::create<LoadEventNexus>(comm);
   alg->setProperty("Filename", filename);
   alg->setProperty("LoadLogs", false);
+  alg->setProperty("UseParallelLoader", false);
   TS_ASSERT_THROWS_NOTHING(alg->execute());
   TS_ASSERT(alg->isExecuted());
   Workspace_const_sptr out = alg->getProperty("OutputWorkspace");
   return boost::dynamic_pointer_cast<const EventWorkspace>(out);
 }
 
+void compare_parallel_and_default_loader(const std::string &filename,
+                                         const std::string &filterByTimeStop) {
+  std::vector<EventWorkspace_sptr> workspaces;
+  for (const bool useParallelLoader : {false, true}) {
+    LoadEventNexus alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("Filename", filename);
+    alg.setProperty("OutputWorkspace", "dummy");
+    alg.setProperty("LoadLogs", false);
+    alg.setProperty("UseParallelLoader", useParallelLoader);
+    if (!filterByTimeStop.empty())
+      alg.setPropertyValue("FilterByTimeStop", filterByTimeStop);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    Workspace_sptr out = alg.getProperty("OutputWorkspace");
+    workspaces.push_back(boost::dynamic_pointer_cast<EventWorkspace>(out));
+  }
+  const auto &reference = *workspaces[0];
+  const auto &parallel = *workspaces[1];
+  TS_ASSERT_EQUALS(parallel.getNumberEvents(), reference.getNumberEvents());
+  TS_ASSERT_EQUALS(parallel.getNumberHistograms(),
+                   reference.getNumberHistograms());
+  for (size_t i = 0; i < reference.getNumberHistograms(); ++i)
+    TS_ASSERT_EQUALS(parallel.getSpectrum(i), reference.getSpectrum(i));
+  // Same default binning, i.e., same limits of time-of-flight.
+  TS_ASSERT_EQUALS(parallel.x(0)[0], reference.x(0)[0]);
+  TS_ASSERT_EQUALS(parallel.x(0)[1], reference.x(0)[1]);
+}
+
 void run_MPI_load(const Parallel::Communicator &comm,
                   boost::shared_ptr<std::mutex> mutex,
                   const std::string &filename) {
@@ -142,6 +172,24 @@ private:
                      filteredLogEndTime.toSimpleString());
   }
 
+  /// Load a chunk of CNCS_7860 of at most 0.002 GiB, or the whole file if
+  /// chunkNumber is empty
+  EventWorkspace_sptr loadChunk(const int chunkNumber, bool &lastChunk) {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    if (chunkNumber != EMPTY_INT()) {
+      ld.setProperty("MaxChunkSize", 0.002);
+      ld.setProperty("ChunkNumber", chunkNumber);
+    }
+    TS_ASSERT_THROWS_NOTHING(ld.execute());
+    lastChunk = ld.getProperty("LastChunk");
+    Workspace_sptr out = ld.getProperty("OutputWorkspace");
+    return boost::dynamic_pointer_cast<EventWorkspace>(out);
+  }
+
 public:
   void test_SingleBank_PixelsOnlyInThatBank() { doTestSingleBank(true, false); }
 
@@ -499,6 +547,215 @@ public:
     TS_ASSERT_DELTA(monWS->readE(0)[0], 0, 1e-6);
   }
 
+  void test_load_in_chunks_of_limited_size() {
+    Mantid::API::FrameworkManager::Instance();
+    bool lastChunk = false;
+    const auto whole = loadChunk(EMPTY_INT(), lastChunk);
+    TS_ASSERT(lastChunk);
+    TS_ASSERT(whole);
+    if (!whole)
+      return;
+
+    size_t numEvents = 0;
+    double protonCharge = 0.;
+    int chunkNumber = 0;
+    lastChunk = false;
+    while (!lastChunk && chunkNumber < 10) {
+      const auto ws = loadChunk(++chunkNumber, lastChunk);
+      TS_ASSERT(ws);
+      if (!ws)
+        return;
+      TS_ASSERT_EQUALS(ws->getNumberHistograms(), 51200);
+      TS_ASSERT_LESS_THAN(ws->getNumberEvents(), 112266);
+      numEvents += ws->getNumberEvents();
+      protonCharge += ws->run().getProtonCharge();
+    }
+    // 112266 events need about 0.005 GiB
+    TS_ASSERT_EQUALS(chunkNumber, 3);
+    TS_ASSERT_EQUALS(numEvents, 112266);
+    TS_ASSERT_DELTA(protonCharge, whole->run().getProtonCharge(), 1e-10);
+  }
+
+  void test_chunks_do_not_depend_on_earlier_executions() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("MaxChunkSize", 0.002);
+    ld.setProperty("ChunkNumber", 2);
+    TS_ASSERT_THROWS_NOTHING(ld.execute());
+    Workspace_sptr first = ld.getProperty("OutputWorkspace");
+    TS_ASSERT(!static_cast<bool>(ld.getProperty("LastChunk")));
+    TS_ASSERT_THROWS_NOTHING(ld.execute());
+    Workspace_sptr second = ld.getProperty("OutputWorkspace");
+    TS_ASSERT(!static_cast<bool>(ld.getProperty("LastChunk")));
+
+    auto firstWS = boost::dynamic_pointer_cast<EventWorkspace>(first);
+    auto secondWS = boost::dynamic_pointer_cast<EventWorkspace>(second);
+    TS_ASSERT(firstWS);
+    TS_ASSERT(secondWS);
+    if (!firstWS || !secondWS)
+      return;
+    TS_ASSERT_EQUALS(firstWS->getNumberEvents(), secondWS->getNumberEvents());
+    TS_ASSERT_EQUALS(firstWS->run().getProtonCharge(),
+                     secondWS->run().getProtonCharge());
+  }
+
+  void test_MaxChunkSize_cannot_be_used_with_TotalChunks() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("MaxChunkSize", 0.002);
+    ld.setProperty("ChunkNumber", 1);
+    ld.setProperty("TotalChunks", 2);
+    TS_ASSERT_THROWS(ld.execute(), std::runtime_error);
+  }
+
+  void test_ChunkNumber_beyond_the_last_chunk_throws() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("MaxChunkSize", 0.002);
+    ld.setProperty("ChunkNumber", 4);
+    TS_ASSERT_THROWS(ld.execute(), std::out_of_range);
+  }
+
+  void test_Load_And_CompressEvents_with_wall_clock_tolerance() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("CompressTolerance", 0.05);
+    ld.setProperty("CompressWallClockTolerance", 10.);
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    Workspace_sptr out = ld.getProperty("OutputWorkspace");
+    auto ws = boost::dynamic_pointer_cast<EventWorkspace>(out);
+
+    // The pulse times are kept
+    TS_ASSERT_EQUALS(ws->getEventType(), WEIGHTED);
+    TS_ASSERT_LESS_THAN(ws->getNumberEvents(), 112266);
+    double weight = 0.;
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+      for (const auto &event : ws->getSpectrum(i).getWeightedEvents())
+        weight += event.weight();
+    TS_ASSERT_DELTA(weight, 112266., 1e-6);
+  }
+
+  void test_compressing_in_blocks_matches_CompressEvents() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("CompressTolerance", 0.05);
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    // The banks of the file have a few thousand events
+    ld.eventsPerCompressedBlock = 500;
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    Workspace_sptr out = ld.getProperty("OutputWorkspace");
+    auto ws = boost::dynamic_pointer_cast<EventWorkspace>(out);
+
+    auto load = AlgorithmManager::Instance().createUnmanaged("LoadEventNexus");
+    load->initialize();
+    load->setChild(true);
+    load->setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    load->setPropertyValue("OutputWorkspace", "dummy");
+    load->setProperty<bool>("LoadLogs", false);
+    load->execute();
+    Workspace_sptr uncompressed = load->getProperty("OutputWorkspace");
+    auto compress =
+        AlgorithmManager::Instance().createUnmanaged("CompressEvents");
+    compress->initialize();
+    compress->setChild(true);
+    compress->setProperty("InputWorkspace", uncompressed);
+    compress->setPropertyValue("OutputWorkspace", "dummy");
+    compress->setProperty("Tolerance", 0.05);
+    compress->execute();
+    EventWorkspace_sptr expected = compress->getProperty("OutputWorkspace");
+
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), expected->getNumberEvents());
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 111274);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      const auto &events = ws->getSpectrum(i).getWeightedEventsNoTime();
+      const auto &expectedEvents =
+          expected->getSpectrum(i).getWeightedEventsNoTime();
+      TS_ASSERT_EQUALS(events.size(), expectedEvents.size());
+      if (events.size() != expectedEvents.size())
+        break;
+      for (size_t event = 0; event < events.size(); ++event) {
+        TS_ASSERT_DELTA(events[event].tof(), expectedEvents[event].tof(),
+                        0.05);
+        TS_ASSERT_EQUALS(events[event].weight(),
+                         expectedEvents[event].weight());
+        TS_ASSERT_EQUALS(events[event].errorSquared(),
+                         expectedEvents[event].errorSquared());
+      }
+    }
+  }
+
+  void test_CompressWallClockTolerance_needs_CompressTolerance() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("CompressWallClockTolerance", 10.);
+    TS_ASSERT_THROWS(ld.execute(), std::runtime_error);
+  }
+
+  void test_load_events_on_demand() {
+    Mantid::API::FrameworkManager::Instance();
+    auto load = [](const bool onDemand) {
+      LoadEventNexus ld;
+      ld.initialize();
+      ld.setChild(true);
+      ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+      ld.setPropertyValue("OutputWorkspace", "dummy");
+      ld.setProperty("LoadEventsOnDemand", onDemand);
+      ld.setProperty<bool>("LoadLogs", false); // Time-saver
+      ld.execute();
+      TS_ASSERT(ld.isExecuted());
+      Workspace_sptr out = ld.getProperty("OutputWorkspace");
+      return boost::dynamic_pointer_cast<EventWorkspace>(out);
+    };
+    auto reference = load(false);
+    auto ws = load(true);
+    TS_ASSERT(ws->hasUnloadedEvents());
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 51200);
+
+    // Only the bank of the spectrum is loaded
+    const auto &spectrum = ws->getSpectrum(1000);
+    TS_ASSERT(ws->hasUnloadedEvents());
+    const auto &expected = reference->getSpectrum(1000);
+    TS_ASSERT_EQUALS(spectrum.getNumberEvents(), expected.getNumberEvents());
+    TS_ASSERT_EQUALS(spectrum.getTofMin(), expected.getTofMin());
+    TS_ASSERT_EQUALS(spectrum.getTofMax(), expected.getTofMax());
+    TS_ASSERT_EQUALS(spectrum.getPulseTimeMin(), expected.getPulseTimeMin());
+
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 112266);
+    TS_ASSERT(!ws->hasUnloadedEvents());
+  }
+
+  void test_LoadEventsOnDemand_cannot_be_used_with_filters() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "dummy");
+    ld.setProperty("LoadEventsOnDemand", true);
+    ld.setProperty("FilterByTofMin", 1000.0);
+    TS_ASSERT_THROWS(ld.execute(), std::runtime_error);
+  }
+
   void test_Load_And_CompressEvents() {
     Mantid::API::FrameworkManager::Instance();
     LoadEventNexus ld;
@@ -835,6 +1092,14 @@ public:
     }
   }
 
+  void test_parallel_loader_with_threads() {
+    compare_parallel_and_default_loader("SANS2D00022048.nxs", "");
+  }
+
+  void test_parallel_loader_with_threads_time_filtered() {
+    compare_parallel_and_default_loader("SANS2D00022048.nxs", "100");
+  }
+
   void test_MPI_load() {
     // Note that this and other MPI tests currently work only in non-MPI builds
     // with the default event loader, i.e., ParallelEventLoader is not
@@ -0,0 +1,103 @@
+#ifndef MANTID_DATAHANDLING_MEMORYMAPPEDNEXUSFILETEST_H_
+#define MANTID_DATAHANDLING_MEMORYMAPPEDNEXUSFILETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/MemoryMappedNexusFile.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+
+#include <numeric>
+#include <vector>
+
+using namespace H5;
+using Mantid::DataHandling::MemoryMappedNexusFile;
+
+class MemoryMappedNexusFileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MemoryMappedNexusFileTest *createSuite() {
+    return new MemoryMappedNexusFileTest();
+  }
+  static void destroySuite(MemoryMappedNexusFileTest *suite) { delete suite; }
+
+  MemoryMappedNexusFileTest() : m_filename("MemoryMappedNexusFileTest.h5") {
+    removeFile();
+    std::vector<uint32_t> ids(1000);
+    std::iota(ids.begin(), ids.end(), 0);
+    const std::vector<float> tofs(1000, 2.5f);
+    hsize_t dims[] = {1000};
+    DataSpace space(1, dims);
+
+    H5File file(m_filename, H5F_ACC_EXCL);
+    Group group = file.createGroup("/entry");
+    // Contiguous, in the byte order of this machine
+    group.createDataSet("event_id", PredType::NATIVE_UINT32, space)
+        .write(ids.data(), PredType::NATIVE_UINT32);
+    group.createDataSet("event_time_offset", PredType::NATIVE_FLOAT, space)
+        .write(tofs.data(), PredType::NATIVE_FLOAT);
+    // Compressed
+    DSetCreatPropList properties;
+    hsize_t chunk[] = {100};
+    properties.setChunk(1, chunk);
+    properties.setDeflate(6);
+    group.createDataSet("compressed_id", PredType::NATIVE_UINT32, space,
+                        properties)
+        .write(ids.data(), PredType::NATIVE_UINT32);
+    file.close();
+  }
+
+  ~MemoryMappedNexusFileTest() override { removeFile(); }
+
+  void test_map_contiguous_slab() {
+    MemoryMappedNexusFile file(m_filename);
+    TS_ASSERT(file.isMapped());
+
+    auto ids = file.mapSlab<uint32_t>("/entry/event_id", 10, 20);
+    TS_ASSERT(ids);
+    TS_ASSERT_EQUALS(ids[0], 10);
+    TS_ASSERT_EQUALS(ids[19], 29);
+
+    auto tofs = file.mapSlab<float>("/entry/event_time_offset", 0, 1000);
+    TS_ASSERT(tofs);
+    TS_ASSERT_EQUALS(tofs[999], 2.5f);
+  }
+
+  void test_slab_outlives_file() {
+    boost::shared_array<uint32_t> ids;
+    {
+      MemoryMappedNexusFile file(m_filename);
+      ids = file.mapSlab<uint32_t>("/entry/event_id", 500, 10);
+    }
+    TS_ASSERT(ids);
+    TS_ASSERT_EQUALS(ids[9], 509);
+  }
+
+  void test_datasets_that_cannot_be_mapped() {
+    MemoryMappedNexusFile file(m_filename);
+    // Chunked and compressed
+    TS_ASSERT(!file.mapSlab<uint32_t>("/entry/compressed_id", 0, 10));
+    // Wrong type
+    TS_ASSERT(!file.mapSlab<float>("/entry/event_id", 0, 10));
+    // Past the end
+    TS_ASSERT(!file.mapSlab<uint32_t>("/entry/event_id", 990, 20));
+  }
+
+  void test_missing_file_is_not_mapped() {
+    MemoryMappedNexusFile file("MemoryMappedNexusFileTest_missing.h5");
+    TS_ASSERT(!file.isMapped());
+    TS_ASSERT(!file.mapSlab<uint32_t>("/entry/event_id", 0, 10));
+  }
+
+private:
+  void removeFile() {
+    if (Poco::File(m_filename).exists())
+      Poco::File(m_filename).remove();
+  }
+
+  const std::string m_filename;
+};
+
+#endif /* MANTID_DATAHANDLING_MEMORYMAPPEDNEXUSFILETEST_H_ */
@@ -72,6 +72,11 @@ public:
   void setDataType(const size_t blockSize,
                    const std::string &typeName) override;
   void getDataType(size_t &CoordSize, std::string &typeName) const override;
+  /// Compress the events written to a new file. Must be set before opening
+  /// it; an existing file keeps the encoding it was created with.
+  void setCompressed(const bool compressed) { m_compressed = compressed; }
+  /// @return true if the events written to a new file are compressed
+  bool isCompressed() const { return m_compressed; }
   //------------------------------------------------------------------------------------------------------------------------
   // Auxiliary functions (non-virtual, used for testing)
   int64_t getNDataColums() const { return m_BlockSize[1]; }
@@ -91,6 +96,8 @@ private:
   ::NeXus::File *m_File;
   /// identifier if the file open only for reading or is  in read/write
   bool m_ReadOnly;
+  /// Compress the events in chunks of m_dataChunk events when creating them
+  bool m_compressed;
   /// The size of the events block which can be written in the neXus array at
   /// once (continious part of the data block)
   size_t m_dataChunk;
@@ -6,7 +6,9 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <atomic>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -33,6 +35,14 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/// How the events of an event list are laid out in memory.
+enum EventStorageType {
+  /// One vector of event structures (TofEvent, WeightedEvent...)
+  ROW_STORAGE,
+  /// Separate arrays of tof, pulse time index, weight and error squared
+  COLUMN_STORAGE
+};
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -45,6 +55,21 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can also be held column-wise (COLUMN_STORAGE), with the tofs,
+    pulse times, weights and errors in separate arrays, so that methods that
+    only look at the tof (histogramming, masking, tof conversion) do not have
+    to stream the rest of each event through memory. Methods that need the
+    event structures themselves (e.g. getEvents()) switch the list back to
+    ROW_STORAGE first. A const method doing so keeps the columns until the
+    next non-const method that needs the event structures, since other
+    threads may still be reading them. In COLUMN_STORAGE the pulse time of
+    each event is a 32-bit index into a sorted table of pulse times, which
+    can be shared by all the lists of a workspace (see
+    EventWorkspace::switchStorageType). The tofs stay double, so the columns
+    of a TofEvent take 12 bytes instead of 16. Filtering by time (e.g.
+    FilterEvents, FilterByLogValue) needs the event structures, and so
+    switches back to ROW_STORAGE and its full size.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 
@@ -71,6 +96,11 @@ enum EventSortType {
 
 class DLLExport EventList : public Mantid::API::IEventList {
 public:
+  /// Sorted, distinct pulse times that the pulse time column of
+  /// COLUMN_STORAGE indexes into. May be shared between event lists.
+  using PulseTimeTable =
+      std::shared_ptr<const std::vector<Types::Core::DateAndTime>>;
+
   EventList();
 
   EventList(EventWorkspaceMRU *mru, specnum_t specNo);
@@ -119,6 +149,8 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    if (m_columns)
+      switchToRowStorage();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -129,6 +161,8 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    if (m_columns)
+      switchToRowStorage();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -139,6 +173,8 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    if (m_columns)
+      switchToRowStorage();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
@@ -147,6 +183,14 @@ public:
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  EventStorageType getStorageType() const;
+
+  void setStorageType(const EventStorageType storage,
+                      const PulseTimeTable &pulseTimes = nullptr);
+
+  static PulseTimeTable
+  makePulseTimeTable(std::vector<Types::Core::DateAndTime> times);
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -398,9 +442,19 @@ private:
   /// MRU lists of the parent EventWorkspace
   mutable EventWorkspaceMRU *mru;
 
-  /// Mutex that is locked while sorting an event list
+  /// Mutex that is locked while sorting an event list or switching it to
+  /// row storage
   mutable std::mutex m_sortMutex;
 
+  /// How the events are held. Only set to ROW_STORAGE once the event vectors
+  /// are filled, so that it can be read without the lock.
+  mutable std::atomic<EventStorageType> m_storage{ROW_STORAGE};
+
+  /// Column-wise copy of the events, used in COLUMN_STORAGE mode. The event
+  /// vectors above are then empty. Left in place by a const switch to rows.
+  struct EventColumns;
+  std::unique_ptr<EventColumns> m_columns;
+
   template <class T>
   static typename std::vector<T>::const_iterator
   findFirstEvent(const std::vector<T> &events, const double seek_tof);
@@ -432,6 +486,9 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void switchToRowStorage() const;
+  void switchToRowStorage();
+  void switchToColumnStorage(const PulseTimeTable &pulseTimes);
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
@@ -513,13 +570,13 @@ private:
                          typename std::vector<T> &events) const;
   template <class T>
   void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
-                             std::map<int, EventList *> outputs,
+                             std::map<int, EventList *> &outputs,
                              typename std::vector<T> &events, bool docorrection,
                              double toffactor, double tofshift) const;
   /// Split events by pulse time
   template <class T>
   void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
-                              std::map<int, EventList *> outputs,
+                              std::map<int, EventList *> &outputs,
                               typename std::vector<T> &events) const;
 
   /// Split events (template) by pulse time with matrix splitters
@@ -527,19 +584,19 @@ private:
   void
   splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec_split_times,
                                    const std::vector<int> &vec_split_target,
-                                   std::map<int, EventList *> outputs,
+                                   std::map<int, EventList *> &outputs,
                                    typename std::vector<T> &events) const;
 
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+      std::map<int, EventList *> &outputs, typename std::vector<T> &vecEvents,
       bool docorrection, double toffactor, double tofshift) const;
 
   template <class T>
   std::string splitByFullTimeSparseVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+      std::map<int, EventList *> &outputs, typename std::vector<T> &vecEvents,
       bool docorrection, double toffactor, double tofshift) const;
 
   template <class T>
@@ -0,0 +1,64 @@
+#ifndef MANTID_DATAOBJECTS_EVENTLISTLOADER_H_
+#define MANTID_DATAOBJECTS_EVENTLISTLOADER_H_
+
+#include "MantidKernel/System.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+class EventList;
+
+/** EventListLoader : Interface for loading the events of an EventWorkspace on
+  demand. The spectra are split into groups whose events are stored together,
+  e.g. the banks of a NeXus file. The EventWorkspace loads a group the first
+  time one of its spectra is accessed, so that only the parts of a file that
+  are used are ever read.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport EventListLoader {
+public:
+  virtual ~EventListLoader() = default;
+
+  /// Number of groups of spectra that are loaded together
+  virtual size_t numberOfGroups() const = 0;
+
+  /// Group of the spectrum with the given workspace index, numberOfGroups() if
+  /// the spectrum has no events to load
+  virtual size_t groupOfSpectrum(const size_t index) const = 0;
+
+  /** Add the events of a group to the event lists. This is called at most once
+   * per group and workspace, never concurrently for the same workspace.
+   * @param group :: index of the group to load
+   * @param lists :: the event lists of the workspace, by workspace index
+   */
+  virtual void loadGroup(const size_t group,
+                         const std::vector<EventList *> &lists) const = 0;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTLISTLOADER_H_ */
@@ -6,6 +6,9 @@
 #include "MantidDataObjects/EventList.h"
 #include "MantidKernel/System.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace Mantid {
@@ -14,6 +17,7 @@ class Progress;
 }
 
 namespace DataObjects {
+class EventListLoader;
 class EventWorkspaceMRU;
 
 /** \class EventWorkspace
@@ -123,6 +127,9 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Change how the events are laid out in memory
+  void switchStorageType(const EventStorageType storage);
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -142,6 +149,11 @@ public:
                             const bool entireRange) const override;
   EventWorkspace &operator=(const EventWorkspace &other) = delete;
 
+  // Load the events of the spectra on first access
+  void setEventListLoader(std::shared_ptr<const EventListLoader> loader);
+  bool hasUnloadedEvents() const;
+  void loadAllEvents() const;
+
 protected:
   /// Protected copy constructor. May be used by childs for cloning.
   EventWorkspace(const EventWorkspace &other);
@@ -152,6 +164,8 @@ private:
     return new EventWorkspace(storageMode());
   }
 
+  void loadEvents(const size_t index) const;
+
   /** A vector that holds the event list for each spectrum; the key is
    * the workspace index, which is not necessarily the pixelid.
    */
@@ -159,6 +173,15 @@ private:
 
   /// Container for the MRU lists of the event lists contained.
   mutable EventWorkspaceMRU *mru;
+
+  /// Loads the events of groups of spectra on first access, if set
+  std::shared_ptr<const EventListLoader> m_eventListLoader;
+  /// Flags for the groups of spectra whose events have been loaded
+  std::unique_ptr<std::atomic<bool>[]> m_loadedGroups;
+  /// Number of groups whose events have not been loaded
+  mutable std::atomic<size_t> m_unloadedGroups{0};
+  /// Serializes loading the events of groups
+  mutable std::mutex m_loadMutex;
 };
 
 /// shared pointer to the EventWorkspace class
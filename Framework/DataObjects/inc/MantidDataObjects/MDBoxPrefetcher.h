@@ -0,0 +1,97 @@
+#ifndef MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_
+#define MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_
+
+#include "MantidAPI/IMDNode.h"
+#include "MantidKernel/System.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxPrefetcher : Loads the events of file-backed boxes on a background
+  thread, ahead of their use.
+
+  The boxes are given in the order they will be used, e.g. the order of a
+  MDBoxIterator or of the boxes BinMD bins. While the calling threads work on
+  the events of a box, the next boxes are read from the file. A loaded box
+  is flagged as busy so that the DiskBuffer does not drop its events before
+  it is used, and is handed out by next(). The caller must call
+  releaseEvents() on the box when it is done with it, as after
+  MDBox::getConstEvents().
+
+  The events of the boxes loaded but not yet handed out are limited to the
+  read-ahead buffer size of the DiskBuffer of the box controller. One box is
+  always loaded ahead, whatever its size.
+
+  Boxes that are not file-backed, or whose events are in memory already,
+  are handed out as they are.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MDBoxPrefetcher {
+public:
+  MDBoxPrefetcher(const std::vector<API::IMDNode *> &boxes);
+  MDBoxPrefetcher(const MDBoxPrefetcher &) = delete;
+  MDBoxPrefetcher &operator=(const MDBoxPrefetcher &) = delete;
+  ~MDBoxPrefetcher();
+
+  API::IMDNode *next();
+
+private:
+  void run();
+
+  /// The boxes, in the order of use
+  const std::vector<API::IMDNode *> m_boxes;
+  /// Maximum number of events loaded ahead
+  uint64_t m_bufferSize;
+  /// Loaded boxes not handed out yet, with their number of events loaded
+  std::deque<std::pair<API::IMDNode *, uint64_t>> m_loaded;
+  /// Number of events of the loaded boxes
+  uint64_t m_bufferUsed;
+  /// Number of boxes handed out
+  size_t m_numHandedOut;
+  /// Set to stop loading
+  bool m_stop;
+  /// Error raised while loading, rethrown by next()
+  std::exception_ptr m_error;
+  /// Guards the members above
+  std::mutex m_mutex;
+  /// Signals a box was loaded
+  std::condition_variable m_loadedCondition;
+  /// Signals a box was handed out
+  std::condition_variable m_handedOutCondition;
+  /// The loading thread
+  std::thread m_thread;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_ */
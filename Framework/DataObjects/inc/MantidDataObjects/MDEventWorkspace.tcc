@@ -592,6 +592,28 @@ TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
   return data->addEvents(events);
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a vector of MDEvents to the workspace using many threads. The events
+ * are shared between the threads by the top-level box they fall in, so that
+ * no locking is needed. No other thread may add events at the same time.
+ * As with addEvent(), no bounds checking is done and automatic splitting is
+ * not performed after adding (call splitAllIfNeeded).
+ *
+ * @param events :: const ref. to a vector of events; they will be copied into
+ *        the MDBox'es contained within.
+ * @return the number of events that were added
+ */
+TMDE(size_t MDEventWorkspace)::addEventsInParallel(
+    const std::vector<MDE> &events) {
+  auto gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data);
+  if (gridBox)
+    return gridBox->addEventsInParallel(events);
+  size_t numAdded = 0;
+  for (const auto &event : events)
+    numAdded += data->addEventUnsafe(event);
+  return numAdded;
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Split the contained MDBox into a MDGridBox or MDSplitBox, if it is not
  * that already.
@@ -129,6 +129,7 @@ public:
   //----------------------------------------------------------------------------------------------------------------------
   size_t addEvent(const MDE &event) override;
   size_t addEventUnsafe(const MDE &event) override;
+  size_t addEventsInParallel(const std::vector<MDE> &events);
 
   /*--------------->  EVENTS from event data
    * <-------------------------------------------------------------*/
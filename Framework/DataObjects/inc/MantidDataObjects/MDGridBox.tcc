@@ -1,6 +1,7 @@
 #include "MantidKernel/Task.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -11,6 +12,8 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
+#include <numeric>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -1683,6 +1686,62 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add many events to the grid box. The events are sorted by the child box
+ * they fall in, keeping their order, and the events of each child are then
+ * added by a single thread without locking.
+ *
+ * Warning! As in addEvent(), no bounds checking is done. Events that are
+ * outside of all the child boxes are dropped.
+ *
+ * Warning! Only one thread may add events to this box, in any way, while this
+ * is running.
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: the events to add
+ * @return the number of events that were added
+ * */
+TMDE(size_t MDGridBox)::addEventsInParallel(const std::vector<MDE> &events) {
+  const auto numEvents = static_cast<int64_t>(events.size());
+  // Threads are not worth starting for a few events
+  const bool inParallel = numEvents > 10000;
+
+  // Child box of each event, numBoxes for events that are dropped
+  std::vector<size_t> childOfEvent(events.size());
+  PRAGMA_OMP(parallel for if (inParallel))
+  for (int64_t i = 0; i < numEvents; ++i) {
+    size_t cindex = calculateChildIndex(events[i]);
+    // As in addEvent(), events on the upper boundary of the last child box go
+    // into that box
+    if (cindex == numBoxes)
+      cindex = numBoxes - 1;
+    childOfEvent[i] = std::min(cindex, numBoxes);
+  }
+
+  // Counting sort of the event indices by child box
+  std::vector<size_t> childStart(numBoxes + 2, 0);
+  for (const auto child : childOfEvent)
+    ++childStart[child + 1];
+  std::partial_sum(childStart.begin(), childStart.end(), childStart.begin());
+  std::vector<size_t> sortedEvents(events.size());
+  {
+    std::vector<size_t> position(childStart.begin(), childStart.end() - 1);
+    for (size_t i = 0; i < events.size(); ++i)
+      sortedEvents[position[childOfEvent[i]]++] = i;
+  }
+
+  const auto numChildren = static_cast<int64_t>(numBoxes);
+  PRAGMA_OMP(parallel for schedule(dynamic) if (inParallel))
+  for (int64_t child = 0; child < numChildren; ++child) {
+    auto box = m_Children[child];
+    for (size_t i = childStart[child]; i < childStart[child + 1]; ++i)
+      box->addEventUnsafe(events[sortedEvents[i]]);
+  }
+  return childStart[numBoxes];
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
@@ -278,6 +278,33 @@ void CoordTransformAffine::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of vectors. The loop over
+ * the vectors is innermost but one, so that the compiler can vectorize it.
+ * The result is the same as calling apply() on each vector.
+ *
+ * @param inputVectors :: numVectors input vectors of size inD, one after the
+ *        other
+ * @param outVectors :: numVectors output vectors of size outD, one after the
+ *        other
+ * @param numVectors :: number of vectors to transform
+ */
+void CoordTransformAffine::applyBlock(const coord_t *inputVectors,
+                                      coord_t *outVectors,
+                                      const size_t numVectors) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *rawMatrixRow = m_rawMatrix[out];
+    const coord_t translation = rawMatrixRow[inD];
+    for (size_t i = 0; i < numVectors; ++i) {
+      const coord_t *inputVector = inputVectors + i * inD;
+      coord_t outVal = 0.0;
+      for (size_t in = 0; in < inD; ++in)
+        outVal += rawMatrixRow[in] * inputVector[in];
+      outVectors[i * outD + out] = outVal + translation;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
 *
@@ -133,6 +133,28 @@ void CoordTransformAligned::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of vectors, one output
+ * dimension at a time.
+ *
+ * @param inputVectors :: numVectors input vectors of size inD, one after the
+ *        other
+ * @param outVectors :: numVectors output vectors of size outD, one after the
+ *        other
+ * @param numVectors :: number of vectors to transform
+ */
+void CoordTransformAligned::applyBlock(const coord_t *inputVectors,
+                                       coord_t *outVectors,
+                                       const size_t numVectors) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *x = inputVectors + m_dimensionToBinFrom[out];
+    const coord_t origin = m_origin[out];
+    const coord_t scaling = m_scaling[out];
+    for (size_t i = 0; i < numVectors; ++i)
+      outVectors[i * outD + out] = (x[i * inD] - origin) * scaling;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
@@ -7,6 +7,7 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/make_unique.h"
 
 #ifdef _MSC_VER
 // qualifier applied to function type has no meaning; ignored
@@ -17,10 +18,15 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cfloat>
 #include <cmath>
+#include <cstring>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <numeric>
 #include <stdexcept>
 
 using std::ostream;
@@ -85,6 +91,138 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/**
+ * Bin boundaries that are evenly spaced in tof or in log(tof), so that the
+ * bin of an event can be computed instead of searched for.
+ */
+struct RegularBins {
+  enum Type { IRREGULAR, LINEAR, LOGARITHMIC };
+  Type type;
+  /// X[0] for linear bins, log(X[0]) for logarithmic bins
+  double offset;
+  /// 1/dx for linear bins, 1/log(X[i+1]/X[i]) for logarithmic bins
+  double inverseStep;
+};
+
+/**
+ * Check whether the bin boundaries were made by a linear or logarithmic
+ * generator (e.g. Rebin with a constant positive or negative step). Small
+ * deviations, from accumulating the step, are allowed; they are corrected
+ * for when binning.
+ * @param X :: bin boundaries
+ * @return the type of binning and the parameters needed to compute a bin
+ */
+RegularBins findRegularBins(const MantidVec &X) {
+  RegularBins bins{RegularBins::IRREGULAR, 0., 0.};
+  // With a single bin there is nothing to search for anyway.
+  if (X.size() < 3)
+    return bins;
+  const size_t numBins = X.size() - 1;
+  const double tolerance = 1e-6;
+
+  const double step = (X.back() - X.front()) / static_cast<double>(numBins);
+  if (step > 0.) {
+    size_t i = 0;
+    while (i < numBins && std::abs(X[i + 1] - X[i] - step) <= tolerance * step)
+      ++i;
+    if (i == numBins)
+      return {RegularBins::LINEAR, X.front(), 1. / step};
+  }
+
+  if (X.front() > 0. && X.back() > X.front()) {
+    const double logStep =
+        std::log(X.back() / X.front()) / static_cast<double>(numBins);
+    const double ratio = std::exp(logStep);
+    size_t i = 0;
+    while (i < numBins &&
+           std::abs(X[i + 1] - X[i] * ratio) <=
+               tolerance * X[i] * (ratio - 1.))
+      ++i;
+    if (i == numBins)
+      return {RegularBins::LOGARITHMIC, std::log(X.front()), 1. / logStep};
+  }
+  return bins;
+}
+
+/**
+ * Histogram events into regular bins, computing the bin of each event from
+ * its tof. The events do not need to be sorted. They are processed in blocks:
+ * the bin estimate is computed in a branch-free loop the compiler can
+ * vectorize, then corrected against the actual bin boundaries so that the
+ * result is exactly what a search of X would give.
+ * @param bins :: the regular binning found by findRegularBins(X)
+ * @param X :: bin boundaries
+ * @param numEvents :: number of events to histogram
+ * @param tofOf :: functor returning the tof of the i-th event
+ * @param addToBin :: functor adding the i-th event to a bin
+ */
+template <typename TofFunction, typename AddFunction>
+void histogramRegularBins(const RegularBins &bins, const MantidVec &X,
+                          const size_t numEvents, TofFunction tofOf,
+                          AddFunction addToBin) {
+  const size_t numBins = X.size() - 1;
+  const double lastBin = static_cast<double>(numBins - 1);
+  const double xMin = X.front();
+  const double xMax = X.back();
+  const double offset = bins.offset;
+  const double inverseStep = bins.inverseStep;
+
+  constexpr size_t blockSize = 256;
+  double tofs[blockSize];
+  double estimates[blockSize];
+  for (size_t start = 0; start < numEvents; start += blockSize) {
+    const size_t count = std::min(blockSize, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = tofOf(start + i);
+
+    if (bins.type == RegularBins::LINEAR) {
+      for (size_t i = 0; i < count; ++i)
+        estimates[i] = (tofs[i] - offset) * inverseStep;
+    } else {
+      for (size_t i = 0; i < count; ++i)
+        estimates[i] = (std::log(tofs[i]) - offset) * inverseStep;
+    }
+    // Clamp to valid bins. Written so that NaN (log of a negative tof) ends
+    // up in bin 0.
+    for (size_t i = 0; i < count; ++i) {
+      const double estimate = estimates[i] > 0. ? estimates[i] : 0.;
+      estimates[i] = estimate < lastBin ? estimate : lastBin;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      const double tof = tofs[i];
+      // Events outside the binning range are not counted.
+      if (!(tof >= xMin && tof < xMax))
+        continue;
+      auto bin = static_cast<size_t>(estimates[i]);
+      // Fix estimates that are off because of rounding or uneven steps
+      while (tof < X[bin])
+        --bin;
+      while (tof >= X[bin + 1])
+        ++bin;
+      addToBin(start + i, bin);
+    }
+  }
+}
+
+/**
+ * Append a range of events to an event list, as addEventQuickly() does for
+ * each event but growing the list at most once.
+ * @param output :: the event list to append to. It is only used if the range
+ * is not empty.
+ * @param first :: the first event to append
+ * @param last :: one past the last event to append
+ */
+template <typename InputIt>
+void addEventsQuickly(EventList *output, InputIt first, InputIt last) {
+  if (first == last)
+    return;
+  std::vector<typename std::iterator_traits<InputIt>::value_type> *events;
+  getEventsFrom(*output, events);
+  events->insert(events->end(), first, last);
+  output->setSortOrder(UNSORTED);
+}
 }
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -151,6 +289,507 @@ struct comparePulseTimeTOFDelta {
   int64_t deltaNano;
 };
 
+//==========================================================================
+/// --------------------- Radix sorting
+/// ----------------------------------
+//==========================================================================
+namespace {
+
+/// Lists with fewer events are sorted by comparison. Radix sorting has a
+/// fixed cost per pass that only pays off for longer lists.
+const size_t RADIX_SORT_THRESHOLD = 2048;
+
+/** Key of a time-of-flight that sorts as the time-of-flight when compared as
+ * an unsigned integer: the sign bit of positive values is set and all the
+ * bits of negative values are flipped.
+ * @param tof :: time-of-flight
+ * @return the key
+ */
+uint64_t tofKey(const double tof) {
+  uint64_t bits;
+  std::memcpy(&bits, &tof, sizeof(bits));
+  const uint64_t signBit = uint64_t(1) << 63;
+  return (bits & signBit) ? ~bits : bits | signBit;
+}
+
+/** Key of a time in nanoseconds that sorts as the time when compared as an
+ * unsigned integer.
+ * @param nanoseconds :: the time
+ * @return the key
+ */
+uint64_t timeKey(const int64_t nanoseconds) {
+  return static_cast<uint64_t>(nanoseconds) ^ (uint64_t(1) << 63);
+}
+
+/** Stable least-significant-digit radix sort of values by 64-bit keys, one
+ * byte at a time. Bytes that are the same for all the keys are skipped, e.g.
+ * the exponent of times-of-flight of the same order of magnitude or the high
+ * bytes of the pulse times of a run.
+ * @param keys :: the key of each value, reordered with the values
+ * @param values :: the values to sort
+ */
+template <typename T>
+void radixSort(std::vector<uint64_t> &keys, std::vector<T> &values) {
+  const size_t numValues = keys.size();
+  if (numValues < 2)
+    return;
+  // Count the values with each value of each byte in a single pass
+  std::vector<std::array<size_t, 256>> counts(8);
+  for (const auto key : keys)
+    for (size_t byte = 0; byte < 8; ++byte)
+      ++counts[byte][(key >> (8 * byte)) & 0xff];
+
+  std::vector<uint64_t> sortedKeys;
+  std::vector<T> sortedValues;
+  for (size_t byte = 0; byte < 8; ++byte) {
+    const size_t shift = 8 * byte;
+    auto &offsets = counts[byte];
+    if (offsets[(keys.front() >> shift) & 0xff] == numValues)
+      continue;
+    size_t offset = 0;
+    for (auto &count : offsets) {
+      const size_t numWithByte = count;
+      count = offset;
+      offset += numWithByte;
+    }
+    sortedKeys.resize(numValues);
+    sortedValues.resize(numValues);
+    for (size_t i = 0; i < numValues; ++i) {
+      const size_t position = offsets[(keys[i] >> shift) & 0xff]++;
+      sortedKeys[position] = keys[i];
+      sortedValues[position] = values[i];
+    }
+    keys.swap(sortedKeys);
+    values.swap(sortedValues);
+  }
+}
+
+/** Radix sort events by a 64-bit key of each event
+ * @param events :: the events to sort
+ * @param eventKey :: function returning the key of an event
+ */
+template <typename EventType, typename KeyFunction>
+void radixSortEvents(std::vector<EventType> &events, KeyFunction eventKey) {
+  std::vector<uint64_t> keys;
+  keys.reserve(events.size());
+  for (const auto &event : events)
+    keys.push_back(eventKey(event));
+  radixSort(keys, events);
+}
+
+/// Sort events by time-of-flight
+template <typename EventType>
+void sortEventsByTof(std::vector<EventType> &events) {
+  if (events.size() < RADIX_SORT_THRESHOLD) {
+    tbb::parallel_sort(events.begin(), events.end(),
+                       compareEventTof<EventType>);
+    return;
+  }
+  radixSortEvents(events,
+                  [](const EventType &event) { return tofKey(event.tof()); });
+}
+
+/// Sort events by pulse time. Events of the same pulse keep their order when
+/// radix sorted.
+template <typename EventType>
+void sortEventsByPulseTime(std::vector<EventType> &events) {
+  if (events.size() < RADIX_SORT_THRESHOLD) {
+    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    return;
+  }
+  radixSortEvents(events, [](const EventType &event) {
+    return timeKey(event.pulseTime().totalNanoseconds());
+  });
+}
+
+/// Sort events by pulse time and then time-of-flight. The radix sort is
+/// stable, so sorting by time-of-flight and then by pulse time is enough.
+template <typename EventType>
+void sortEventsByPulseTimeTof(std::vector<EventType> &events) {
+  if (events.size() < RADIX_SORT_THRESHOLD) {
+    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    return;
+  }
+  sortEventsByTof(events);
+  sortEventsByPulseTime(events);
+}
+
+/// Sort events by the time they reached the sample
+template <typename EventType>
+void sortEventsByTimeAtSample(std::vector<EventType> &events,
+                              const double tofFactor, const double tofShift) {
+  if (events.size() < RADIX_SORT_THRESHOLD) {
+    tbb::parallel_sort(events.begin(), events.end(),
+                       CompareTimeAtSample<EventType>(tofFactor, tofShift));
+    return;
+  }
+  radixSortEvents(events, [tofFactor, tofShift](const EventType &event) {
+    return timeKey(calculateCorrectedFullTime(event, tofFactor, tofShift));
+  });
+}
+
+} // namespace
+
+//==========================================================================
+/// --------------------- Column storage
+/// ----------------------------------
+//==========================================================================
+/** The events of an EventList held column-wise. The weight and error columns
+ * are empty for TOF lists and the pulse time column is empty for
+ * WEIGHTED_NOTIME lists.
+ */
+struct EventList::EventColumns {
+  /// Time-of-flight (or whatever the x unit is) of each event
+  std::vector<double> tof;
+  /// Sorted, distinct pulse times; may be shared with other event lists
+  PulseTimeTable pulseTable;
+  /// Pulse time of each event, as an index into pulseTable. Since the table
+  /// is sorted, ordering by index is ordering by pulse time.
+  std::vector<uint32_t> pulseIndex;
+  /// Weight of each event
+  std::vector<float> weight;
+  /// Square of the error of each event
+  std::vector<float> errorSquared;
+
+  /// Number of events held
+  size_t size() const { return tof.size(); }
+
+  /// Memory used by the columns, in bytes. A pulse table shared with other
+  /// lists is not counted.
+  size_t capacityInBytes() const {
+    size_t bytes =
+        tof.capacity() * sizeof(double) +
+        pulseIndex.capacity() * sizeof(uint32_t) +
+        (weight.capacity() + errorSquared.capacity()) * sizeof(float);
+    if (pulseTable && pulseTable.use_count() == 1)
+      bytes += pulseTable->capacity() * sizeof(DateAndTime);
+    return bytes;
+  }
+
+  /// Pulse time of the i-th event
+  const DateAndTime &pulseTime(const size_t i) const {
+    return (*pulseTable)[pulseIndex[i]];
+  }
+
+  /** Fill the pulse time column.
+   * @param times :: the pulse time of each event
+   * @param table :: sorted pulse times to index into. If null, or if it lacks
+   *        some of the times, a table is made from the times themselves.
+   */
+  void setPulseTimes(const std::vector<DateAndTime> &times,
+                     const PulseTimeTable &table) {
+    pulseTable = table ? table : EventList::makePulseTimeTable(times);
+    pulseIndex.clear();
+    pulseIndex.reserve(times.size());
+    const auto &pulses = *pulseTable;
+    for (const auto &time : times) {
+      // Consecutive events usually come from the same pulse
+      if (!pulseIndex.empty() && pulses[pulseIndex.back()] == time) {
+        pulseIndex.push_back(pulseIndex.back());
+        continue;
+      }
+      const auto it = std::lower_bound(pulses.cbegin(), pulses.cend(), time);
+      if (it == pulses.cend() || *it != time) {
+        setPulseTimes(times, nullptr);
+        return;
+      }
+      pulseIndex.push_back(static_cast<uint32_t>(it - pulses.cbegin()));
+    }
+  }
+
+  /// Pulse times of all the events, used to re-index them
+  std::vector<DateAndTime> pulseTimes() const {
+    std::vector<DateAndTime> times;
+    times.reserve(pulseIndex.size());
+    for (const auto index : pulseIndex)
+      times.push_back((*pulseTable)[index]);
+    return times;
+  }
+
+  /// Fill the columns from a vector of TofEvent's
+  void assign(const std::vector<TofEvent> &events,
+              const PulseTimeTable &table) {
+    std::vector<DateAndTime> times;
+    tof.reserve(events.size());
+    times.reserve(events.size());
+    for (const auto &event : events) {
+      tof.push_back(event.tof());
+      times.push_back(event.pulseTime());
+    }
+    setPulseTimes(times, table);
+  }
+
+  /// Fill the columns from a vector of WeightedEvent's
+  void assign(const std::vector<WeightedEvent> &events,
+              const PulseTimeTable &table) {
+    std::vector<DateAndTime> times;
+    tof.reserve(events.size());
+    times.reserve(events.size());
+    weight.reserve(events.size());
+    errorSquared.reserve(events.size());
+    for (const auto &event : events) {
+      tof.push_back(event.tof());
+      times.push_back(event.pulseTime());
+      weight.push_back(event.m_weight);
+      errorSquared.push_back(event.m_errorSquared);
+    }
+    setPulseTimes(times, table);
+  }
+
+  /// Fill the columns from a vector of WeightedEventNoTime's
+  void assign(const std::vector<WeightedEventNoTime> &events) {
+    tof.reserve(events.size());
+    weight.reserve(events.size());
+    errorSquared.reserve(events.size());
+    for (const auto &event : events) {
+      tof.push_back(event.tof());
+      weight.push_back(event.m_weight);
+      errorSquared.push_back(event.m_errorSquared);
+    }
+  }
+
+  /// Rebuild a vector of TofEvent's from the columns
+  void copyTo(std::vector<TofEvent> &events) const {
+    events.clear();
+    events.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(tof[i], pulseTime(i));
+  }
+
+  /// Rebuild a vector of WeightedEvent's from the columns
+  void copyTo(std::vector<WeightedEvent> &events) const {
+    events.clear();
+    events.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(tof[i], pulseTime(i), weight[i], errorSquared[i]);
+  }
+
+  /// Rebuild a vector of WeightedEventNoTime's from the columns
+  void copyTo(std::vector<WeightedEventNoTime> &events) const {
+    events.clear();
+    events.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(tof[i], weight[i], errorSquared[i]);
+  }
+
+  /// Reorder every non-empty column following the given permutation
+  template <typename T>
+  static void permute(std::vector<T> &column,
+                      const std::vector<size_t> &indices) {
+    if (column.empty())
+      return;
+    std::vector<T> sorted;
+    sorted.reserve(column.size());
+    for (const auto index : indices)
+      sorted.push_back(column[index]);
+    column.swap(sorted);
+  }
+
+  /// Sort all the columns by tof
+  void sortTof() {
+    if (std::is_sorted(tof.cbegin(), tof.cend()))
+      return;
+    std::vector<size_t> indices(size());
+    std::iota(indices.begin(), indices.end(), 0);
+    if (size() < RADIX_SORT_THRESHOLD) {
+      const auto &tofs = tof;
+      tbb::parallel_sort(indices.begin(), indices.end(),
+                         [&tofs](const size_t a, const size_t b) {
+                           return tofs[a] < tofs[b];
+                         });
+    } else {
+      std::vector<uint64_t> keys;
+      keys.reserve(size());
+      for (const auto value : tof)
+        keys.push_back(tofKey(value));
+      radixSort(keys, indices);
+    }
+    permute(tof, indices);
+    permute(pulseIndex, indices);
+    permute(weight, indices);
+    permute(errorSquared, indices);
+  }
+
+  /** Sort all the columns by pulse time, keeping the order of events from
+   * the same pulse. The pulse table is shared by the whole workspace, so a
+   * counting sort on the pulse index is only used when the pulses of the
+   * list span few pulses compared with its number of events. Otherwise the
+   * pulse indices are sorted as in sortTof().
+   */
+  void sortPulseTime() {
+    if (std::is_sorted(pulseIndex.cbegin(), pulseIndex.cend()))
+      return;
+    const auto minMax =
+        std::minmax_element(pulseIndex.cbegin(), pulseIndex.cend());
+    const uint32_t firstPulse = *minMax.first;
+    const size_t numPulses = *minMax.second - firstPulse + 1;
+    std::vector<size_t> indices(size());
+    if (numPulses <= 2 * size()) {
+      // Position of the first event of each pulse in the sorted columns
+      std::vector<size_t> offsets(numPulses + 1, 0);
+      for (const auto index : pulseIndex)
+        ++offsets[index - firstPulse + 1];
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (size_t i = 0; i < pulseIndex.size(); ++i)
+        indices[offsets[pulseIndex[i] - firstPulse]++] = i;
+    } else if (size() < RADIX_SORT_THRESHOLD) {
+      std::iota(indices.begin(), indices.end(), 0);
+      const auto &pulses = pulseIndex;
+      std::stable_sort(indices.begin(), indices.end(),
+                       [&pulses](const size_t a, const size_t b) {
+                         return pulses[a] < pulses[b];
+                       });
+    } else {
+      std::iota(indices.begin(), indices.end(), 0);
+      std::vector<uint64_t> keys(pulseIndex.cbegin(), pulseIndex.cend());
+      radixSort(keys, indices);
+    }
+    permute(tof, indices);
+    permute(pulseIndex, indices);
+    permute(weight, indices);
+    permute(errorSquared, indices);
+  }
+
+  /** Find the earliest and latest pulse times of the (non-empty) columns.
+   * Events without pulse times are all at DateAndTime(0), as in
+   * WeightedEventNoTime.
+   * @param tMin :: earliest pulse time
+   * @param tMax :: latest pulse time
+   */
+  void pulseTimeMinMax(DateAndTime &tMin, DateAndTime &tMax) const {
+    if (pulseIndex.empty()) {
+      tMin = DateAndTime(0);
+      tMax = DateAndTime(0);
+      return;
+    }
+    const auto minMax =
+        std::minmax_element(pulseIndex.cbegin(), pulseIndex.cend());
+    tMin = (*pulseTable)[*minMax.first];
+    tMax = (*pulseTable)[*minMax.second];
+  }
+
+  /// Reverse the order of the events in all the columns
+  void reverse() {
+    std::reverse(tof.begin(), tof.end());
+    std::reverse(pulseIndex.begin(), pulseIndex.end());
+    std::reverse(weight.begin(), weight.end());
+    std::reverse(errorSquared.begin(), errorSquared.end());
+  }
+
+  /** Remove the events in [first, last) from all the columns
+   * @param first :: index of the first event to remove
+   * @param last :: one past the index of the last event to remove
+   */
+  void erase(const size_t first, const size_t last) {
+    tof.erase(tof.begin() + first, tof.begin() + last);
+    if (!pulseIndex.empty())
+      pulseIndex.erase(pulseIndex.begin() + first, pulseIndex.begin() + last);
+    if (!weight.empty()) {
+      weight.erase(weight.begin() + first, weight.begin() + last);
+      errorSquared.erase(errorSquared.begin() + first,
+                         errorSquared.begin() + last);
+    }
+  }
+
+  /** Histogram the (tof-sorted) events. Events without a weight column count
+   * as 1 with an error of 1.
+   * @param X :: bin boundaries
+   * @param Y :: counts returned
+   * @param E :: errors returned
+   * @param skipError :: skip calculating the errors of unweighted events
+   */
+  void histogram(const MantidVec &X, MantidVec &Y, MantidVec &E,
+                 const bool skipError) const {
+    if (X.size() <= 1) {
+      // X was not set. Return an empty array.
+      Y.resize(0, 0);
+      return;
+    }
+    const size_t numBins = X.size() - 1;
+    Y.assign(numBins, 0.0);
+    const bool weighted = !weight.empty();
+    if (weighted)
+      E.assign(numBins, 0.0);
+
+    const RegularBins bins = findRegularBins(X);
+    if (bins.type != RegularBins::IRREGULAR) {
+      const auto tofOf = [this](size_t i) { return tof[i]; };
+      if (weighted) {
+        histogramRegularBins(bins, X, tof.size(), tofOf,
+                             [this, &Y, &E](size_t i, size_t bin) {
+                               Y[bin] += double(weight[i]);
+                               E[bin] += double(errorSquared[i]);
+                             });
+      } else {
+        histogramRegularBins(bins, X, tof.size(), tofOf,
+                             [&Y](size_t, size_t bin) { Y[bin]++; });
+      }
+    } else {
+      // Skip to the first event inside the binning range
+      size_t i =
+          std::lower_bound(tof.cbegin(), tof.cend(), X[0]) - tof.cbegin();
+      size_t bin = 0;
+      for (; i < tof.size(); ++i) {
+        // Events and X are both sorted: advance the bin until the event fits
+        while (bin < numBins && tof[i] >= X[bin + 1])
+          ++bin;
+        if (bin == numBins)
+          break;
+        if (weighted) {
+          Y[bin] += double(weight[i]);
+          E[bin] += double(errorSquared[i]);
+        } else {
+          Y[bin]++;
+        }
+      }
+    }
+
+    if (weighted) {
+      std::transform(E.begin(), E.end(), E.begin(),
+                     static_cast<double (*)(double)>(sqrt));
+    } else if (!skipError) {
+      E.resize(Y.size(), 0);
+      std::transform(Y.begin(), Y.end(), E.begin(),
+                     static_cast<double (*)(double)>(sqrt));
+    }
+  }
+
+  /** Integrate the weights of the (tof-sorted) events in a range of tof.
+   * @param minX :: minimum tof to include
+   * @param maxX :: maximum tof to include
+   * @param entireRange :: ignore minX and maxX and use all the events
+   * @param sum :: the integrated weight
+   * @param error :: the error on the sum
+   */
+  void integrate(const double minX, const double maxX, const bool entireRange,
+                 double &sum, double &error) const {
+    sum = 0;
+    error = 0;
+    if (tof.empty())
+      return;
+    size_t first = 0;
+    size_t last = tof.size();
+    if (!entireRange) {
+      // If a silly range was given, return 0.
+      if (maxX < minX)
+        return;
+      first = std::lower_bound(tof.cbegin(), tof.cend(), minX) - tof.cbegin();
+      last = std::upper_bound(tof.cbegin() + first, tof.cend(), maxX) -
+             tof.cbegin();
+    }
+    if (weight.empty()) {
+      sum = static_cast<double>(last - first);
+      error = sum;
+    } else {
+      for (size_t i = first; i < last; ++i) {
+        sum += weight[i];
+        error += errorSquared[i];
+      }
+    }
+    error = std::sqrt(error);
+  }
+};
+
 /// Constructor (empty)
 // EventWorkspace is always histogram data and so is thus EventList
 EventList::EventList()
@@ -232,6 +871,13 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  if (m_storage == COLUMN_STORAGE) {
+    sink.m_columns = Kernel::make_unique<EventColumns>(*m_columns);
+    sink.m_storage = COLUMN_STORAGE;
+  } else {
+    sink.m_columns.reset();
+    sink.m_storage = ROW_STORAGE;
+  }
   sink.eventType = eventType;
   sink.order = order;
 }
@@ -342,6 +988,13 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  if (rhs.m_storage == COLUMN_STORAGE) {
+    m_columns = Kernel::make_unique<EventColumns>(*rhs.m_columns);
+    m_storage = COLUMN_STORAGE;
+  } else {
+    m_columns.reset();
+    m_storage = ROW_STORAGE;
+  }
   eventType = rhs.eventType;
   order = rhs.order;
   return *this;
@@ -353,6 +1006,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  this->switchToRowStorage();
 
   switch (this->eventType) {
   case TOF:
@@ -381,6 +1035,8 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->switchToRowStorage();
+
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -421,6 +1077,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  this->switchToRowStorage();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -437,6 +1094,8 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->switchToRowStorage();
+
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -474,6 +1133,8 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->switchToRowStorage();
+
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -502,6 +1163,7 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  more_events.switchToRowStorage();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -571,6 +1233,9 @@ EventList &EventList::operator-=(const EventList &more_events) {
     return *this;
   }
 
+  this->switchToRowStorage();
+  more_events.switchToRowStorage();
+
   // We'll let the -= operator for the given vector of event lists handle it
   switch (this->getEventType()) {
   case TOF:
@@ -624,6 +1289,8 @@ bool EventList::operator==(const EventList &rhs) const {
     return false;
   if (this->eventType != rhs.eventType)
     return false;
+  this->switchToRowStorage();
+  rhs.switchToRowStorage();
   // Check all event lists; The empty ones will compare equal
   if (events != rhs.events)
     return false;
@@ -649,6 +1316,8 @@ bool EventList::equals(const EventList &rhs, const double tolTof,
     return false;
   if (this->eventType != rhs.eventType)
     return false;
+  this->switchToRowStorage();
+  rhs.switchToRowStorage();
 
   // loop over the events
   size_t numEvents = this->getNumberEvents();
@@ -692,6 +1361,8 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  if (newType != eventType)
+    this->switchToRowStorage();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -772,6 +1443,126 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Return how the events are laid out in memory.
+ * @return :: ROW_STORAGE or COLUMN_STORAGE
+ */
+EventStorageType EventList::getStorageType() const {
+  return m_storage;
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Switch the EventList to hold its events as a vector of event structures
+ * (ROW_STORAGE) or as separate arrays of tof, pulse time, weight and error
+ * (COLUMN_STORAGE). The event type and sort order are kept.
+ * @param storage :: the storage to switch to.
+ * @param pulseTimes :: table of pulse times, from makePulseTimeTable(), that
+ *        the pulse time column indexes into. Sharing one table between the
+ *        lists of a workspace saves memory. If null, or if it lacks some of
+ *        the pulse times, the list makes its own.
+ */
+void EventList::setStorageType(const EventStorageType storage,
+                               const PulseTimeTable &pulseTimes) {
+  if (storage == COLUMN_STORAGE)
+    this->switchToColumnStorage(pulseTimes);
+  else
+    this->switchToRowStorage();
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Make a table of pulse times for column storage.
+ * @param times :: pulse times, in any order and with repeats
+ * @return the sorted, distinct pulse times
+ * @throw std::range_error if there are too many pulse times to index
+ */
+EventList::PulseTimeTable
+EventList::makePulseTimeTable(std::vector<DateAndTime> times) {
+  tbb::parallel_sort(times.begin(), times.end());
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+  if (times.size() > std::numeric_limits<uint32_t>::max())
+    throw std::range_error("Too many distinct pulse times for the pulse time "
+                           "table of an EventList");
+  times.shrink_to_fit();
+  return std::make_shared<const std::vector<DateAndTime>>(std::move(times));
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Copy the events from the columns back into the event vector matching the
+ * event type. Does nothing if the list is not in COLUMN_STORAGE.
+ * This is const since methods that only read the events may need to call it.
+ * Other threads may still be reading the columns, so they are kept until the
+ * next call of the non-const overload. The storage type only changes once the
+ * event vector is filled, so a reader that finds COLUMN_STORAGE can use the
+ * columns and one that finds ROW_STORAGE can use the event vector.
+ */
+void EventList::switchToRowStorage() const {
+  if (m_storage == ROW_STORAGE)
+    return;
+
+  // Avoid converting from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // If the list was converted while waiting for the lock, return.
+  if (m_storage == ROW_STORAGE)
+    return;
+
+  switch (eventType) {
+  case TOF:
+    m_columns->copyTo(events);
+    break;
+  case WEIGHTED:
+    m_columns->copyTo(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns->copyTo(weightedEventsNoTime);
+    break;
+  }
+  m_storage = ROW_STORAGE;
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Switch to ROW_STORAGE as the const overload does, then free the columns.
+ * Being non-const, this cannot run while other threads read the list.
+ */
+void EventList::switchToRowStorage() {
+  static_cast<const EventList *>(this)->switchToRowStorage();
+  m_columns.reset();
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Move the events into separate tof, pulse time, weight and error columns.
+ * If the list is already in COLUMN_STORAGE, only re-index the pulse times
+ * into the given table.
+ * @param pulseTimes :: table of pulse times to index into, may be null
+ */
+void EventList::switchToColumnStorage(const PulseTimeTable &pulseTimes) {
+  if (m_storage == COLUMN_STORAGE) {
+    if (pulseTimes && m_columns->pulseTable &&
+        m_columns->pulseTable != pulseTimes)
+      m_columns->setPulseTimes(m_columns->pulseTimes(), pulseTimes);
+    return;
+  }
+
+  auto columns = Kernel::make_unique<EventColumns>();
+  switch (eventType) {
+  case TOF:
+    columns->assign(events, pulseTimes);
+    break;
+  case WEIGHTED:
+    columns->assign(weightedEvents, pulseTimes);
+    break;
+  case WEIGHTED_NOTIME:
+    columns->assign(weightedEventsNoTime);
+    break;
+  }
+  m_columns = std::move(columns);
+  m_storage = COLUMN_STORAGE;
+
+  // Free the event vectors; clearUnused() only frees the other types.
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -784,6 +1575,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -814,6 +1606,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->events;
 }
 
@@ -829,6 +1622,7 @@ std::vector<TofEvent> &EventList::getEvents() {
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->events;
 }
 
@@ -844,6 +1638,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
                              "getEvents() or getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->weightedEvents;
 }
 
@@ -859,6 +1654,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
                              "getEvents() or getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->weightedEvents;
 }
 
@@ -872,6 +1668,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
                              "getEvents() or getWeightedEvents().");
+  this->switchToRowStorage();
   return this->weightedEventsNoTime;
 }
 
@@ -886,6 +1683,7 @@ EventList::getWeightedEventsNoTime() const {
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
                              "Use getEvents() or getWeightedEvents().");
+  this->switchToRowStorage();
   return this->weightedEventsNoTime;
 }
 
@@ -895,6 +1693,8 @@ EventList::getWeightedEventsNoTime() const {
 void EventList::clear(const bool removeDetIDs) {
   if (mru)
     mru->deleteIndex(this);
+  m_columns.reset();
+  m_storage = ROW_STORAGE;
   this->events.clear();
   std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
   this->weightedEvents.clear();
@@ -946,7 +1746,10 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  this->switchToRowStorage();
+  this->events.reserve(num);
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -1034,17 +1837,21 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns->sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<TofEvent>);
+    sortEventsByTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventTof<WeightedEvent>);
+    sortEventsByTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       compareEventTof<WeightedEventNoTime>);
+    sortEventsByTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1067,6 +1874,8 @@ void EventList::sortTimeAtSample(const double &tofFactor,
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
 
+  this->switchToRowStorage();
+
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
@@ -1075,20 +1884,15 @@ void EventList::sortTimeAtSample(const double &tofFactor,
 
   // Perform sort.
   switch (eventType) {
-  case TOF: {
-    CompareTimeAtSample<TofEvent> comparitor(tofFactor, tofShift);
-    tbb::parallel_sort(events.begin(), events.end(), comparitor);
-  } break;
-  case WEIGHTED: {
-    CompareTimeAtSample<WeightedEvent> comparitor(tofFactor, tofShift);
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       comparitor);
-  } break;
-  case WEIGHTED_NOTIME: {
-    CompareTimeAtSample<WeightedEventNoTime> comparitor(tofFactor, tofShift);
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       comparitor);
-  } break;
+  case TOF:
+    sortEventsByTimeAtSample(events, tofFactor, tofShift);
+    break;
+  case WEIGHTED:
+    sortEventsByTimeAtSample(weightedEvents, tofFactor, tofShift);
+    break;
+  case WEIGHTED_NOTIME:
+    sortEventsByTimeAtSample(weightedEventsNoTime, tofFactor, tofShift);
+    break;
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TIMEATSAMPLE_SORT;
@@ -1106,14 +1910,19 @@ void EventList::sortPulseTime() const {
   if (this->order == PULSETIME_SORT)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns->sortPulseTime();
+    this->order = PULSETIME_SORT;
+    return;
+  }
+
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    sortEventsByPulseTime(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    sortEventsByPulseTime(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1131,6 +1940,8 @@ void EventList::sortPulseTimeTOF() const {
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
+  this->switchToRowStorage();
+
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
@@ -1139,11 +1950,10 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    sortEventsByPulseTimeTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    sortEventsByPulseTimeTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1163,6 +1973,8 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  this->switchToRowStorage();
+
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1205,7 +2017,9 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof() && m_storage == COLUMN_STORAGE) {
+    m_columns->reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1232,6 +2046,9 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (m_storage == COLUMN_STORAGE)
+    return m_columns->size();
+
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1247,6 +2064,9 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (m_storage == COLUMN_STORAGE)
+    return m_columns->tof.empty();
+
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1266,15 +2086,22 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  // Columns kept after a const switch to rows still take memory
+  const size_t columnBytes =
+      m_columns ? m_columns->capacityInBytes() + sizeof(EventColumns) : 0;
+  if (m_storage == COLUMN_STORAGE)
+    return columnBytes + sizeof(EventList);
+
   switch (eventType) {
   case TOF:
-    return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
+    return this->events.capacity() * sizeof(TofEvent) + columnBytes +
+           sizeof(EventList);
   case WEIGHTED:
     return this->weightedEvents.capacity() * sizeof(WeightedEvent) +
-           sizeof(EventList);
+           columnBytes + sizeof(EventList);
   case WEIGHTED_NOTIME:
     return this->weightedEventsNoTime.capacity() * sizeof(WeightedEventNoTime) +
-           sizeof(EventList);
+           columnBytes + sizeof(EventList);
   }
   throw std::runtime_error("EventList: invalid event type value was found.");
 }
@@ -1748,6 +2575,8 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  this->switchToRowStorage();
+  destination->switchToRowStorage();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1804,6 +2633,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  this->switchToRowStorage();
+  destination->switchToRowStorage();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1983,11 +2814,16 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
     std::fill(E.begin(), E.end(), 0.0);
   }
 
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!events.empty()) {
+  const RegularBins bins = findRegularBins(X);
+  if (bins.type != RegularBins::IRREGULAR) {
+    histogramRegularBins(bins, X, events.size(),
+                         [&events](size_t i) { return events[i].tof(); },
+                         [&events, &Y, &E](size_t i, size_t bin) {
+                           Y[bin] += double(events[i].m_weight);
+                           E[bin] += double(events[i].m_errorSquared);
+                         });
+  } else if (!events.empty()) {
+    //---------------------- Histogram with a search of X
     // Iterate through all events (sorted by tof)
     auto itev = findFirstEvent(events, X[0]);
     auto itev_end = events.cend();
@@ -2126,6 +2962,11 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
 
   this->sortTof();
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns->histogram(X, Y, E, skipError);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     // Make the single ones
@@ -2232,6 +3073,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  this->switchToRowStorage();
 
   if (this->events.empty())
     return;
@@ -2350,6 +3192,14 @@ void EventList::generateCountsHistogram(const MantidVec &X,
   // Clear the Y data, assign all to 0.
   Y.resize(x_size - 1, 0);
 
+  const RegularBins bins = findRegularBins(X);
+  if (bins.type != RegularBins::IRREGULAR) {
+    histogramRegularBins(bins, X, events.size(),
+                         [this](size_t i) { return events[i].tof(); },
+                         [&Y](size_t, size_t bin) { Y[bin]++; });
+    return;
+  }
+
   //---------------------- Histogram without weights
   //---------------------------------
 
@@ -2518,6 +3368,11 @@ void EventList::integrate(const double minX, const double maxX,
     this->sortTof();
   }
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns->integrate(minX, maxX, entireRange, sum, error);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2562,6 +3417,12 @@ void EventList::convertTof(std::function<double(double)> func,
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    std::transform(m_columns->tof.begin(), m_columns->tof.end(),
+                   m_columns->tof.begin(), func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2606,6 +3467,12 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    for (double &tof : m_columns->tof)
+      tof = tof * factor + offset;
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2677,6 +3544,7 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
 void EventList::addPulsetime(const double seconds) {
   if (this->getNumberEvents() <= 0)
     return;
+  this->switchToRowStorage();
 
   // Convert the list
   switch (eventType) {
@@ -2757,19 +3625,31 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
-  switch (eventType) {
-  case TOF:
-    numOrig = this->events.size();
-    numDel = this->maskTofHelper(this->events, tofMin, tofMax);
-    break;
-  case WEIGHTED:
-    numOrig = this->weightedEvents.size();
-    numDel = this->maskTofHelper(this->weightedEvents, tofMin, tofMax);
-    break;
-  case WEIGHTED_NOTIME:
-    numOrig = this->weightedEventsNoTime.size();
-    numDel = this->maskTofHelper(this->weightedEventsNoTime, tofMin, tofMax);
-    break;
+  if (m_storage == COLUMN_STORAGE) {
+    const auto &tofs = m_columns->tof;
+    numOrig = tofs.size();
+    const size_t first =
+        std::lower_bound(tofs.cbegin(), tofs.cend(), tofMin) - tofs.cbegin();
+    const size_t last =
+        std::upper_bound(tofs.cbegin() + first, tofs.cend(), tofMax) -
+        tofs.cbegin();
+    numDel = last - first;
+    m_columns->erase(first, last);
+  } else {
+    switch (eventType) {
+    case TOF:
+      numOrig = this->events.size();
+      numDel = this->maskTofHelper(this->events, tofMin, tofMax);
+      break;
+    case WEIGHTED:
+      numOrig = this->weightedEvents.size();
+      numDel = this->maskTofHelper(this->weightedEvents, tofMin, tofMax);
+      break;
+    case WEIGHTED_NOTIME:
+      numOrig = this->weightedEventsNoTime.size();
+      numDel = this->maskTofHelper(this->weightedEventsNoTime, tofMin, tofMax);
+      break;
+    }
   }
 
   if (numDel >= numOrig)
@@ -2797,6 +3677,11 @@ void EventList::getTofs(std::vector<double> &tofs) const {
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
+  if (m_storage == COLUMN_STORAGE) {
+    tofs.assign(m_columns->tof.cbegin(), m_columns->tof.cend());
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2843,6 +3728,11 @@ void EventList::getWeights(std::vector<double> &weights) const {
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
+  if (m_storage == COLUMN_STORAGE && eventType != TOF) {
+    weights.assign(m_columns->weight.cbegin(), m_columns->weight.cend());
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case WEIGHTED:
@@ -2890,6 +3780,13 @@ void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
+  if (m_storage == COLUMN_STORAGE && eventType != TOF) {
+    weightErrors.clear();
+    for (const float errorSquared : m_columns->errorSquared)
+      weightErrors.push_back(std::sqrt(double(errorSquared)));
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case WEIGHTED:
@@ -2940,6 +3837,14 @@ std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
 
+  if (m_storage == COLUMN_STORAGE) {
+    if (m_columns->pulseIndex.empty())
+      times.assign(m_columns->size(), DateAndTime(0));
+    for (const auto index : m_columns->pulseIndex)
+      times.push_back((*m_columns->pulseTable)[index]);
+    return times;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2967,6 +3872,13 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_storage == COLUMN_STORAGE) {
+    const auto &tofs = m_columns->tof;
+    if (this->order == TOF_SORT)
+      return tofs.front();
+    return *std::min_element(tofs.cbegin(), tofs.cend());
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3013,6 +3925,13 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_storage == COLUMN_STORAGE) {
+    const auto &tofs = m_columns->tof;
+    if (this->order == TOF_SORT)
+      return tofs.back();
+    return *std::max_element(tofs.cbegin(), tofs.cend());
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3058,6 +3977,12 @@ DateAndTime EventList::getPulseTimeMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_storage == COLUMN_STORAGE) {
+    DateAndTime tMax;
+    m_columns->pulseTimeMinMax(tMin, tMax);
+    return tMin;
+  }
+
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3102,6 +4027,12 @@ DateAndTime EventList::getPulseTimeMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_storage == COLUMN_STORAGE) {
+    DateAndTime tMin;
+    m_columns->pulseTimeMinMax(tMin, tMax);
+    return tMax;
+  }
+
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3146,6 +4077,11 @@ void EventList::getPulseTimeMinMax(
   if (this->empty())
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns->pulseTimeMinMax(tMin, tMax);
+    return;
+  }
+
   // when events are ordered by pulse time just need the first/last values
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3188,6 +4124,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->switchToRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3235,6 +4172,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->switchToRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3309,6 +4247,12 @@ void EventList::setTofsHelper(std::vector<T> &events,
 void EventList::setTofs(const MantidVec &tofs) {
   this->order = UNSORTED;
 
+  if (m_storage == COLUMN_STORAGE) {
+    if (!tofs.empty() && tofs.size() == m_columns->size())
+      m_columns->tof.assign(tofs.cbegin(), tofs.cend());
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -3409,6 +4353,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  this->switchToRowStorage();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3532,6 +4477,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3669,6 +4615,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3717,6 +4664,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  this->switchToRowStorage();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3802,6 +4750,7 @@ void EventList::filterByTimeAtSampleHelper(std::vector<T> &events,
  */
 void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
                                   EventList &output) const {
+  this->switchToRowStorage();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3836,6 +4785,7 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
                                      Types::Core::DateAndTime stop,
                                      double tofFactor, double tofOffset,
                                      EventList &output) const {
+  this->switchToRowStorage();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3951,6 +4901,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  this->switchToRowStorage();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4042,6 +4993,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  this->switchToRowStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4093,76 +5045,72 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
  */
 template <class T>
 void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
-                                      std::map<int, EventList *> outputs,
+                                      std::map<int, EventList *> &outputs,
                                       typename std::vector<T> &events,
                                       bool docorrection, double toffactor,
                                       double tofshift) const {
+  // Time of an event at the detector or, with the correction, at the sample.
+  // The corrected time is rounded differently when looking for the events
+  // before a splitter and for those in it. Both are kept so that no event
+  // moves across a splitter boundary.
+  auto getTimeBefore = [docorrection, toffactor, tofshift](const T &event) {
+    if (docorrection)
+      return calculateCorrectedFullTime(event, toffactor, tofshift);
+    return event.m_pulsetime.totalNanoseconds() +
+           static_cast<int64_t>(event.m_tof * 1000);
+  };
+  auto getTimeIn = [docorrection, toffactor, tofshift](const T &event) {
+    if (docorrection)
+      return event.m_pulsetime.totalNanoseconds() +
+             static_cast<int64_t>(toffactor * event.m_tof * 1000 +
+                                  tofshift * 1.0E9);
+    return event.m_pulsetime.totalNanoseconds() +
+           static_cast<int64_t>(event.m_tof * 1000);
+  };
+
   // 1. Prepare to Iterate through the splitter at the same time
   auto itspl = splitter.begin();
   auto itspl_end = splitter.end();
 
-  // 2. Prepare to Iterate through all events (sorted by tof)
+  // 2. Prepare to Iterate through all events (sorted by pulse time)
   auto itev = events.begin();
   auto itev_end = events.end();
 
-  // 3. This is the time of the first section. Anything before is thrown out.
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination
-    int64_t start = itspl->start().totalNanoseconds();
-    int64_t stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
-
-    // a) Skip the events before the start of the time
-    // TODO This step can be
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      int64_t fulltime;
-      if (docorrection)
-        fulltime = calculateCorrectedFullTime(*itev, toffactor, tofshift);
-      else
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(itev->m_tof * 1000);
-      if (fulltime < start) {
-        // a1) Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        itev++;
-      } else {
-        break;
-      }
-    }
+  // 3. Sweep the events and the splitters together. Anything after the last
+  // splitter is thrown out.
+  EventList *unfiltered = outputs[-1];
+  while (itspl != itspl_end && itev != itev_end) {
+    // Get the splitting interval times
+    const int64_t start = itspl->start().totalNanoseconds();
+    const int64_t stop = itspl->stop().totalNanoseconds();
+
+    // a) The events before the start of the time go to index = -1
+    auto first = itev;
+    while (itev != itev_end && getTimeBefore(*itev) < start)
+      ++itev;
+    addEventsQuickly(unfiltered, first, itev);
 
-    // b) Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-      int64_t fulltime;
-      if (docorrection)
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(toffactor * itev->m_tof * 1000 +
-                                        tofshift * 1.0E9);
-      else
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(itev->m_tof * 1000);
-      if (fulltime < stop) {
-        // b1) Copy the event into another
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        break;
-      }
-    }
+    // b) The events in the interval (if any) go to its destination
+    first = itev;
+    while (itev != itev_end && getTimeIn(*itev) < stop)
+      ++itev;
+    if (first != itev)
+      addEventsQuickly(outputs[itspl->index()], first, itev);
 
-    // Go to the next interval
+    // c) Go to the next interval, skipping those that would get no events:
+    // the next event is neither before them nor in them
     ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
-
-    // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
-      break;
+    if (itspl != itspl_end && itev != itev_end) {
+      const int64_t timeBefore = getTimeBefore(*itev);
+      const int64_t timeIn = getTimeIn(*itev);
+      auto getsNoEvents = [timeBefore,
+                           timeIn](const Kernel::SplittingInterval &interval) {
+        return interval.start().totalNanoseconds() <= timeBefore &&
+               interval.stop().totalNanoseconds() <= timeIn;
+      };
+      if (getsNoEvents(*itspl))
+        itspl = std::partition_point(itspl, itspl_end, getsNoEvents);
+    }
   } // END-WHILE Splitter
 }
 
@@ -4182,6 +5130,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
                                 std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  this->switchToRowStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4245,7 +5194,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
 template <class T>
 std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+    std::map<int, EventList *> &outputs, typename std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
   // Define variables for events
   // size_t numevents = events.size();
@@ -4317,82 +5266,82 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
 template <class T>
 std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+    std::map<int, EventList *> &outputs, typename std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  // typename std::vector<T>::iterator eviter;
-  std::stringstream msgss;
-
-  size_t num_splitters = vecgroups.size();
-  // prepare to Iterate through all events (sorted by tof)
+  // Time of an event at the detector or, with the correction, at the sample
+  auto getFullTime = [docorrection, toffactor, tofshift](const T &event) {
+    if (docorrection)
+      return event.m_pulsetime.totalNanoseconds() +
+             static_cast<int64_t>(toffactor * event.m_tof * 1000 +
+                                  tofshift * 1.0E9);
+    return event.m_pulsetime.totalNanoseconds() +
+           static_cast<int64_t>(event.m_tof * 1000);
+  };
+
+  const size_t num_splitters = vecgroups.size();
+  auto vectimes_end = vectimes.begin() + num_splitters + 1;
+  // prepare to Iterate through all events (sorted by pulse time)
   auto iter_events = vecEvents.begin();
   auto iter_events_end = vecEvents.end();
 
-  // std::stringstream debug_ss;
-  // debug_ss << "\nFilter events...:\n";
-
-  for (size_t i = 0; i < num_splitters; ++i) {
+  size_t i = 0;
+  while (i < num_splitters && iter_events != iter_events_end) {
     // get one splitter
-    int64_t start_i64 = vectimes[i];
-    int64_t stop_i64 = vectimes[i + 1];
-    int group = vecgroups[i];
-    // debug_ss << "working on splitter: " << i << " from " << start_i64 << " to
-    // " << stop_i64 << "\n";
+    const int64_t start_i64 = vectimes[i];
+    const int64_t stop_i64 = vectimes[i + 1];
+    const int group = vecgroups[i];
+
+    // copy a run of events in the splitter to its group
+    EventList *myOutput = nullptr;
+    auto copyToGroup = [&](decltype(iter_events) first,
+                           decltype(iter_events) last) {
+      if (first == last)
+        return;
+      if (!myOutput)
+        myOutput = outputs[group];
+      if (!myOutput) {
+        // there is no such group defined. quit for this group
+        std::stringstream errss;
+        errss << "Group " << group << " has a NULL output EventList. "
+              << "\n";
+        throw std::runtime_error(errss.str());
+      }
+      addEventsQuickly(myOutput, first, last);
+    };
 
     // go over events
+    auto first = iter_events;
     while (iter_events != iter_events_end) {
-      int64_t absolute_time;
-      if (docorrection)
-        absolute_time =
-            iter_events->m_pulsetime.totalNanoseconds() +
-            static_cast<int64_t>(toffactor * iter_events->m_tof * 1000 +
-                                 tofshift * 1.0E9);
-      else
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() +
-                        static_cast<int64_t>(iter_events->m_tof * 1000);
-
-      // debug_ss << "  event " << iter_events - vecEvents.begin() << " abs.time
-      // = " << absolute_time << "\n";
-
+      const int64_t absolute_time = getFullTime(*iter_events);
+      if (absolute_time >= stop_i64) {
+        // event occurs after the stop time, it should belonged to the next
+        // splitter
+        break;
+      }
       if (absolute_time < start_i64) {
         // event occurs before the splitter. only can happen with first
         // splitter. Then ignore and move to next
-        ++iter_events;
-        continue;
-      }
-
-      if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
-          // there is no such group defined. quit for this group
-          std::stringstream errss;
-          errss << "Group " << group << " has a NULL output EventList. "
-                << "\n";
-          msgss << errss.str();
-          throw std::runtime_error(errss.str());
-        }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++iter_events;
+        copyToGroup(first, iter_events);
+        first = ++iter_events;
       } else {
-        // event occurs after the stop time, it should belonged to the next
-        // splitter
-        break;
+        ++iter_events;
       }
-    } // while
-
-    // quit the loop if there is no more event left
-    if (iter_events == iter_events_end)
-      break;
-  } // for splitter
-
-  // std::cout << debug_ss.str();
+    }
+    copyToGroup(first, iter_events);
+
+    // the next event belongs to the next splitter, or to a later one if the
+    // splitters in between end before it
+    ++i;
+    if (i < num_splitters && iter_events != iter_events_end) {
+      const int64_t absolute_time = getFullTime(*iter_events);
+      if (vectimes[i + 1] <= absolute_time)
+        i = std::upper_bound(vectimes.begin() + i + 1, vectimes_end,
+                             absolute_time) -
+            vectimes.begin() - 1;
+    }
+  } // while splitter
 
-  return (msgss.str());
+  return std::string();
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4413,6 +5362,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  this->switchToRowStorage();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4484,64 +5434,51 @@ std::string EventList::splitByFullTimeMatrixSplitter(
  */
 template <class T>
 void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
-                                       std::map<int, EventList *> outputs,
+                                       std::map<int, EventList *> &outputs,
                                        typename std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   auto itspl = splitter.begin();
   auto itspl_end = splitter.end();
-  Types::Core::DateAndTime start, stop;
 
-  // Prepare to Events Iterate through all events (sorted by tof)
+  // Prepare to Events Iterate through all events (sorted by pulse time)
   auto itev = events.begin();
   auto itev_end = events.end();
 
-  // Iterate (loop) on all splitters
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination group
-    start = itspl->start().totalNanoseconds();
-    stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
+  // Iterate (loop) on all splitters. As the events are sorted by pulse time,
+  // the ends of the ranges of events are found by binary search.
+  EventList *unfiltered = outputs[-1];
+  while (itspl != itspl_end && itev != itev_end) {
+    // Get the splitting interval times
+    const DateAndTime start = itspl->start();
+    const DateAndTime stop = itspl->stop();
 
     // Skip the events before the start of the time and put to 'unfiltered'
     // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
+    auto first = itev;
+    itev = std::partition_point(itev, itev_end, [&start](const T &event) {
+      return event.m_pulsetime < start;
+    });
+    addEventsQuickly(unfiltered, first, itev);
 
     // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        // Duplicate event
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
-
-    // Go to the next interval
+    first = itev;
+    itev = std::partition_point(itev, itev_end, [&stop](const T &event) {
+      return event.m_pulsetime < stop;
+    });
+    if (first != itev)
+      addEventsQuickly(outputs[itspl->index()], first, itev);
+
+    // Go to the next interval, skipping those ending before the next event
     ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
-
-    // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
-      break;
+    if (itspl != itspl_end && itev != itev_end &&
+        itspl->stop() <= itev->m_pulsetime) {
+      const DateAndTime pulsetime = itev->m_pulsetime;
+      itspl = std::partition_point(
+          itspl, itspl_end,
+          [&pulsetime](const Kernel::SplittingInterval &interval) {
+            return interval.stop() <= pulsetime;
+          });
+    }
   } // END-WHILE Splitter
 }
 
@@ -4550,6 +5487,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  this->switchToRowStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4595,6 +5533,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  this->switchToRowStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4639,7 +5578,8 @@ template <class T>
 void EventList::splitByPulseTimeWithMatrixHelper(
     const std::vector<int64_t> &vec_split_times,
     const std::vector<int> &vec_split_target,
-    std::map<int, EventList *> outputs, typename std::vector<T> &events) const {
+    std::map<int, EventList *> &outputs,
+    typename std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   if (vec_split_times.size() != vec_split_target.size() + 1)
     throw std::runtime_error("Splitter time vector size and splitter target "
@@ -4778,6 +5718,7 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
  */
 void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
                                    Mantid::Kernel::Unit *toUnit) {
+  this->switchToRowStorage();
   // Check for initialized
   if (!fromUnit || !toUnit)
     throw std::runtime_error(
@@ -4826,6 +5767,7 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
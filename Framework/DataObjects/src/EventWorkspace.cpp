@@ -7,6 +7,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventListLoader.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
@@ -16,9 +17,11 @@
 #include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/IPropertyManager.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -43,6 +46,9 @@ EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
 
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
     : IEventWorkspace(other), mru(new EventWorkspaceMRU) {
+  // The copy gets all the events, so that it does not share the loader with
+  // the other workspace
+  other.loadAllEvents();
   for (const auto &el : other.data) {
     // Create a new event list, copying over the events
     auto newel = new EventList(*el);
@@ -178,6 +184,7 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::getSpectrum, workspace index out of range");
+  loadEvents(index);
   return *data[index];
 }
 
@@ -392,6 +399,7 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 /// The total number of events across all of the spectra.
 /// @returns The total number of events
 size_t EventWorkspace::getNumberEvents() const {
+  loadAllEvents();
   return std::accumulate(data.begin(), data.end(), size_t{0},
                          [](size_t total, EventList *list) {
                            return total + list->getNumberEvents();
@@ -403,6 +411,7 @@ size_t EventWorkspace::getNumberEvents() const {
  * @return the EventType of the most-specialized EventList in the workspace
  */
 Mantid::API::EventType EventWorkspace::getEventType() const {
+  loadAllEvents();
   Mantid::API::EventType out = Mantid::API::TOF;
   for (auto list : this->data) {
     Mantid::API::EventType thisType = list->getEventType();
@@ -421,10 +430,50 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
  * @param type :: EventType to switch to
  */
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
+  loadAllEvents();
   for (auto &eventList : this->data)
     eventList->switchTo(type);
 }
 
+/** Switch all event lists to hold their events as event structures
+ * (ROW_STORAGE) or as separate tof/pulse time/weight/error arrays
+ * (COLUMN_STORAGE). In COLUMN_STORAGE all the lists share one table of
+ * pulse times.
+ *
+ * @param storage :: EventStorageType to switch to
+ */
+void EventWorkspace::switchStorageType(const EventStorageType storage) {
+  loadAllEvents();
+  const int numHistograms = static_cast<int>(this->getNumberHistograms());
+
+  // Make one table of pulse times for all the spectra to index into
+  EventList::PulseTimeTable pulseTimes;
+  if (storage == COLUMN_STORAGE) {
+    std::vector<std::vector<DateAndTime>> spectrumTimes(numHistograms);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wksp_index = 0; wksp_index < numHistograms; wksp_index++) {
+      const auto &eventList = *this->data[wksp_index];
+      if (eventList.getEventType() == Mantid::API::WEIGHTED_NOTIME)
+        continue;
+      auto times = eventList.getPulseTimes();
+      std::sort(times.begin(), times.end());
+      times.erase(std::unique(times.begin(), times.end()), times.end());
+      spectrumTimes[wksp_index].swap(times);
+    }
+    std::vector<DateAndTime> times;
+    for (auto &spectrum : spectrumTimes) {
+      times.insert(times.end(), spectrum.cbegin(), spectrum.cend());
+      std::vector<DateAndTime>().swap(spectrum);
+    }
+    pulseTimes = EventList::makePulseTimeTable(std::move(times));
+  }
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < numHistograms; wksp_index++) {
+    this->data[wksp_index]->setStorageType(storage, pulseTimes);
+  }
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -442,6 +491,7 @@ void EventWorkspace::clearMRU() const { mru->clear(); }
 /// Returns the amount of memory used in bytes
 size_t EventWorkspace::getMemorySize() const {
   // TODO: Add the MRU buffer
+  loadAllEvents();
 
   // Add the memory from all the event lists
   size_t total = std::accumulate(data.begin(), data.end(), size_t{0},
@@ -543,6 +593,7 @@ void EventWorkspace::generateHistogram(const std::size_t index,
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::generateHistogram, histogram number out of range");
+  loadEvents(index);
   this->data[index]->generateHistogram(X, Y, E, skipError);
 }
 
@@ -563,6 +614,7 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   if (index >= data.size())
     throw std::range_error("EventWorkspace::generateHistogramPulseTime, "
                            "histogram number out of range");
+  loadEvents(index);
   this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
 }
 
@@ -580,22 +632,28 @@ void EventWorkspace::setAllX(const HistogramData::BinEdges &x) {
   this->clearMRU();
 }
 
-/** Task for sorting an event list */
+/** Task for sorting the event lists of blocks of spectra */
 class EventSortingTask {
 public:
   /// ctor
   EventSortingTask(const EventWorkspace *WS, EventSortType sortType,
+                   const std::vector<size_t> &blockStarts,
                    Mantid::API::Progress *prog)
-      : m_sortType(sortType), m_WS(WS), prog(prog) {}
+      : m_sortType(sortType), m_WS(WS), m_blockStarts(blockStarts),
+        prog(prog) {}
 
   // Execute the sort as specified.
   void operator()(const tbb::blocked_range<size_t> &range) const {
-    for (size_t wi = range.begin(); wi < range.end(); ++wi) {
-      m_WS->getSpectrum(wi).sort(m_sortType);
+    for (size_t block = range.begin(); block < range.end(); ++block) {
+      for (size_t wi = m_blockStarts[block]; wi < m_blockStarts[block + 1];
+           ++wi) {
+        m_WS->getSpectrum(wi).sort(m_sortType);
+      }
+      // Report progress
+      if (prog)
+        prog->reportIncrement(m_blockStarts[block + 1] - m_blockStarts[block],
+                              "Sorting");
     }
-    // Report progress
-    if (prog)
-      prog->report("Sorting");
   }
 
 private:
@@ -603,6 +661,8 @@ private:
   EventSortType m_sortType;
   /// EventWorkspace on which to sort
   const EventWorkspace *m_WS;
+  /// First workspace index of each block, followed by the number of spectra
+  const std::vector<size_t> &m_blockStarts;
   /// Optional Progress dialog.
   Mantid::API::Progress *prog;
 };
@@ -612,6 +672,7 @@ private:
  * If any 2 have different order type, then be unsorted
  */
 EventSortType EventWorkspace::getSortType() const {
+  loadAllEvents();
   size_t size = this->data.size();
   EventSortType order = data[0]->getSortType();
   for (size_t i = 1; i < size; i++) {
@@ -621,13 +682,16 @@ EventSortType EventWorkspace::getSortType() const {
   return order;
 }
 
-/*** Sort all event lists. Uses a parallelized algorithm
+/*** Sort all event lists. Uses a parallelized algorithm, sharing the spectra
+ * between the threads by their number of events.
  * @param sortType :: How to sort the event lists.
- * @param prog :: a progress report object. If the pointer is not NULL, each
- * event list will call prog.report() once.
+ * @param prog :: a progress report object. If the pointer is not NULL, it is
+ * incremented once per event list.
  */
 void EventWorkspace::sortAll(EventSortType sortType,
                              Mantid::API::Progress *prog) const {
+  // The loader sets the order of the lists it fills, so load before checking
+  loadAllEvents();
   if (this->getSortType() == sortType) {
     if (prog != nullptr) {
       prog->reportIncrement(this->data.size());
@@ -635,9 +699,31 @@ void EventWorkspace::sortAll(EventSortType sortType,
     return;
   }
 
-  // Create the thread pool, and optimize by doing the longest sorts first.
-  EventSortingTask task(this, sortType, prog);
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, data.size()), task);
+  // Split the spectra into blocks with about the same number of events, so
+  // that a few long lists do not keep one thread busy while the others are
+  // idle. Each list counts as a few events for the cost of sorting it.
+  const size_t listCost = 16;
+  size_t totalCost = 0;
+  for (const auto list : data)
+    totalCost += list->getNumberEvents() + listCost;
+  const size_t numBlocks =
+      std::min(data.size(), 8 * ThreadPool::getNumPhysicalCores());
+  const size_t blockCost = totalCost / std::max(numBlocks, size_t(1)) + 1;
+  std::vector<size_t> blockStarts{0};
+  size_t cost = 0;
+  for (size_t wi = 0; wi < data.size(); ++wi) {
+    cost += data[wi]->getNumberEvents() + listCost;
+    if (cost >= blockCost) {
+      blockStarts.push_back(wi + 1);
+      cost = 0;
+    }
+  }
+  if (blockStarts.back() != data.size())
+    blockStarts.push_back(data.size());
+
+  EventSortingTask task(this, sortType, blockStarts, prog);
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, blockStarts.size() - 1, 1), task);
 }
 
 /** Integrate all the spectra in the matrix workspace within the range given.
@@ -655,6 +741,7 @@ void EventWorkspace::sortAll(EventSortType sortType,
 void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
                                           const double minX, const double maxX,
                                           const bool entireRange) const {
+  loadAllEvents();
   // Start with empty vector
   out.resize(this->getNumberHistograms(), 0.0);
 
@@ -670,6 +757,61 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   }
 }
 
+/** Set the loader of the events of the spectra. The event lists must be empty
+ * and set to the event type and sort order of the events that the loader will
+ * add. The events of a group of spectra are loaded the first time one of the
+ * spectra is accessed.
+ * @param loader :: loads the events of groups of spectra on demand
+ */
+void EventWorkspace::setEventListLoader(
+    std::shared_ptr<const EventListLoader> loader) {
+  std::lock_guard<std::mutex> lock(m_loadMutex);
+  m_eventListLoader = std::move(loader);
+  const size_t numGroups =
+      m_eventListLoader ? m_eventListLoader->numberOfGroups() : 0;
+  m_loadedGroups.reset(new std::atomic<bool>[numGroups]);
+  for (size_t group = 0; group < numGroups; ++group)
+    m_loadedGroups[group] = false;
+  m_unloadedGroups = numGroups;
+}
+
+/// Returns true if the events of some spectra have not been loaded yet
+bool EventWorkspace::hasUnloadedEvents() const { return m_unloadedGroups > 0; }
+
+/// Load the events of all spectra that have not been loaded yet
+void EventWorkspace::loadAllEvents() const {
+  if (m_unloadedGroups == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_loadMutex);
+  for (size_t group = 0; group < m_eventListLoader->numberOfGroups();
+       ++group) {
+    if (!m_loadedGroups[group]) {
+      m_eventListLoader->loadGroup(group, data);
+      m_loadedGroups[group] = true;
+      --m_unloadedGroups;
+    }
+  }
+}
+
+/** Load the events of the group of a spectrum, if they have not been loaded
+ * yet. Spectra of groups that have been loaded can be accessed while another
+ * group is loading.
+ * @param index :: workspace index of the spectrum
+ */
+void EventWorkspace::loadEvents(const size_t index) const {
+  if (m_unloadedGroups == 0)
+    return;
+  const size_t group = m_eventListLoader->groupOfSpectrum(index);
+  if (group >= m_eventListLoader->numberOfGroups() || m_loadedGroups[group])
+    return;
+  std::lock_guard<std::mutex> lock(m_loadMutex);
+  if (!m_loadedGroups[group]) {
+    m_eventListLoader->loadGroup(group, data);
+    m_loadedGroups[group] = true;
+    --m_unloadedGroups;
+  }
+}
+
 } // namespace DataObjects
 } // namespace Mantid
 
@@ -8,7 +8,7 @@
 #include "MantidDataObjects/MDEventInserter.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/Utils.h"
 
 #include <boost/random/uniform_int.hpp>
@@ -18,7 +18,7 @@ namespace Mantid {
 namespace DataObjects {
 
 using Kernel::ThreadPool;
-using Kernel::ThreadSchedulerFIFO;
+using Kernel::ThreadSchedulerWorkStealing;
 
 /**
  * Constructor
@@ -142,7 +142,7 @@ void FakeMD::addFakePeak(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   }
 
   ws->splitBox();
-  auto *ts = new ThreadSchedulerFIFO();
+  auto *ts = new ThreadSchedulerWorkStealing();
   ThreadPool tp(ts);
   ws->splitAllIfNeeded(ts);
   tp.joinAll();
@@ -206,7 +206,7 @@ void FakeMD::addFakeUniformData(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     addFakeRegularData<MDE, nd>(m_uniformParams, ws);
 
   ws->splitBox();
-  auto *ts = new ThreadSchedulerFIFO();
+  auto *ts = new ThreadSchedulerWorkStealing();
   ThreadPool tp(ts);
   ws->splitAllIfNeeded(ts);
   tp.joinAll();
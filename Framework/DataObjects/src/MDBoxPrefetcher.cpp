@@ -0,0 +1,114 @@
+#include "MantidDataObjects/MDBoxPrefetcher.h"
+#include "MantidAPI/BoxController.h"
+#include "MantidKernel/ISaveable.h"
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Constructor. Starts loading the boxes.
+ *
+ * @param boxes :: the boxes, in the order they will be used. They must
+ *        outlive the prefetcher.
+ */
+MDBoxPrefetcher::MDBoxPrefetcher(const std::vector<API::IMDNode *> &boxes)
+    : m_boxes(boxes), m_bufferSize(0), m_bufferUsed(0), m_numHandedOut(0),
+      m_stop(false) {
+  if (!m_boxes.empty()) {
+    auto fileIO = m_boxes.front()->getBoxController()->getFileIO();
+    if (fileIO)
+      m_bufferSize = fileIO->getReadAheadBufferSize();
+  }
+  m_thread = std::thread(&MDBoxPrefetcher::run, this);
+}
+
+/** Destructor. Stops loading, and releases the boxes loaded but not handed
+ * out so that the DiskBuffer may drop their events.
+ */
+MDBoxPrefetcher::~MDBoxPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_handedOutCondition.notify_all();
+  m_thread.join();
+  for (const auto &loaded : m_loaded) {
+    auto saveable = loaded.first->getISaveable();
+    if (saveable)
+      saveable->setBusy(false);
+  }
+}
+
+/** Get the next box, waiting for its events to be loaded if needed.
+ *
+ * This may be called from several threads at once. The events of the box
+ * are in memory and flagged as busy: call releaseEvents() on the box when
+ * done with them.
+ *
+ * @return the next box, or nullptr after the last one
+ * @throw any error raised while loading the events
+ */
+API::IMDNode *MDBoxPrefetcher::next() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_loadedCondition.wait(lock, [this] {
+    return !m_loaded.empty() || m_error || m_numHandedOut == m_boxes.size();
+  });
+  if (m_loaded.empty()) {
+    if (m_error)
+      std::rethrow_exception(m_error);
+    return nullptr;
+  }
+  const auto loaded = m_loaded.front();
+  m_loaded.pop_front();
+  m_bufferUsed -= loaded.second;
+  const bool last = ++m_numHandedOut == m_boxes.size();
+  lock.unlock();
+  m_handedOutCondition.notify_one();
+  // The other waiting threads have nothing left to wait for
+  if (last)
+    m_loadedCondition.notify_all();
+  return loaded.first;
+}
+
+/** Load the boxes in order, while the events of the boxes loaded ahead fit
+ * in the read-ahead buffer. Run on the loading thread.
+ */
+void MDBoxPrefetcher::run() {
+  try {
+    for (auto box : m_boxes) {
+      auto saveable = box->getISaveable();
+      const bool needsLoading =
+          saveable && saveable->wasSaved() && !saveable->isLoaded();
+      const uint64_t size = needsLoading ? box->getNPoints() : 0;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_handedOutCondition.wait(lock, [this, size] {
+          return m_stop || m_loaded.empty() ||
+                 m_bufferUsed + size <= m_bufferSize;
+        });
+        if (m_stop)
+          return;
+      }
+
+      // Keep the events in memory until used. The DiskBuffer must not write
+      // out the box while this thread loads it.
+      if (saveable)
+        box->getBoxController()->getFileIO()->loadBusy(saveable);
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loaded.emplace_back(box, size);
+        m_bufferUsed += size;
+      }
+      m_loadedCondition.notify_one();
+    }
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_error = std::current_exception();
+    }
+    m_loadedCondition.notify_all();
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
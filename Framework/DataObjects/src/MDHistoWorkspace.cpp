@@ -7,6 +7,7 @@
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
 #include "MantidGeometry/MDGeometry/MDGeometryXMLBuilder.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/VMD.h"
@@ -24,6 +25,27 @@ using namespace Mantid::API;
 
 namespace Mantid {
 namespace DataObjects {
+
+namespace {
+/// Number of bins from which the element-wise operations run in parallel
+const int64_t MIN_BINS_FOR_PARALLEL = 1 << 16;
+
+/** Apply a function to the index of every bin of a workspace. The bins are
+ * shared between threads for large workspaces. The function is inlined in the
+ * loop so that simple operations are vectorized by the compiler.
+ *
+ * @param length :: number of bins
+ * @param function :: called with the index of each bin
+ */
+template <typename Function>
+void forEachBin(const size_t length, const Function &function) {
+  const auto numBins = static_cast<int64_t>(length);
+  PARALLEL_FOR_IF(numBins >= MIN_BINS_FOR_PARALLEL)
+  for (int64_t i = 0; i < numBins; ++i)
+    function(static_cast<size_t>(i));
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor given the 4 dimensions
  * @param dimX :: X dimension binning parameters
@@ -774,11 +796,11 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] += b.m_signals[i];
     m_errorsSquared[i] += b.m_errorsSquared[i];
     m_numEvents[i] += b.m_numEvents[i];
-  }
+  });
   m_nEventsContributed += b.m_nEventsContributed;
 }
 
@@ -790,10 +812,10 @@ void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] += signal;
     m_errorsSquared[i] += errorSquared;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -813,11 +835,11 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] -= b.m_signals[i];
     m_errorsSquared[i] += b.m_errorsSquared[i];
     m_numEvents[i] += b.m_numEvents[i];
-  }
+  });
   m_nEventsContributed += b.m_nEventsContributed;
 }
 
@@ -829,10 +851,10 @@ void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] -= signal;
     m_errorsSquared[i] += errorSquared;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -861,7 +883,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "multiply");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -873,7 +895,7 @@ void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -892,7 +914,7 @@ void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
   signal_t b = signal;
   signal_t db2 = error * error;
 
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -901,7 +923,7 @@ void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -930,7 +952,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "divide");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -942,7 +964,7 @@ void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -961,7 +983,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
   signal_t b = signal;
   signal_t db2 = error * error;
   signal_t db2_relative = db2 / (b * b);
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -970,7 +992,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -980,7 +1002,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
  * \f$ df^2 = a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
     if (a <= 0) {
@@ -990,7 +1012,7 @@ void MDHistoWorkspace::log(double filler) {
       m_signals[i] = std::log(a);
       m_errorsSquared[i] = da2 / (a * a);
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1000,7 +1022,7 @@ void MDHistoWorkspace::log(double filler) {
  * \f$ df^2 = (ln(10)^-2) * a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log10(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
     if (a <= 0) {
@@ -1010,7 +1032,7 @@ void MDHistoWorkspace::log10(double filler) {
       m_signals[i] = std::log10(a);
       m_errorsSquared[i] = 0.1886117 * da2 / (a * a); // 0.1886117  = ln(10)^-2
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1020,12 +1042,12 @@ void MDHistoWorkspace::log10(double filler) {
  * \f$ df^2 = f^2 * da^2 \f$
  */
 void MDHistoWorkspace::exp() {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t f = std::exp(m_signals[i]);
     signal_t da2 = m_errorsSquared[i];
     m_signals[i] = f;
     m_errorsSquared[i] = f * f * da2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1037,13 +1059,13 @@ void MDHistoWorkspace::exp() {
  */
 void MDHistoWorkspace::power(double exponent) {
   double exponent_squared = exponent * exponent;
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t f = std::pow(a, exponent);
     signal_t da2 = m_errorsSquared[i];
     m_signals[i] = f;
     m_errorsSquared[i] = f * f * exponent_squared * da2 / (a * a);
-  }
+  });
 }
 
 //==============================================================================================
@@ -1061,13 +1083,13 @@ void MDHistoWorkspace::power(double exponent) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "&= (and)");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) &&
                     (b.m_signals[i] != 0 && !b.m_masks[i]))
                        ? 1.0
                        : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
   return *this;
 }
 
@@ -1080,13 +1102,13 @@ MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "|= (or)");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ||
                     (b.m_signals[i] != 0 && !b.m_masks[i]))
                        ? 1.0
                        : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
   return *this;
 }
 
@@ -1100,13 +1122,13 @@ MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "^= (xor)");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ^
                     (b.m_signals[i] != 0 && !b.m_masks[i]))
                        ? 1.0
                        : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
   return *this;
 }
 
@@ -1117,10 +1139,10 @@ MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
  * 0.0 is "false", all other values are "true". All errors are set to 0.
  */
 void MDHistoWorkspace::operatorNot() {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] == 0.0 || m_masks[i]);
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1133,10 +1155,10 @@ void MDHistoWorkspace::operatorNot() {
  */
 void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "lessThan");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1148,10 +1170,10 @@ void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::lessThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] < signal) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1164,10 +1186,10 @@ void MDHistoWorkspace::lessThan(const signal_t signal) {
  */
 void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "greaterThan");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1179,10 +1201,10 @@ void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] > signal) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1197,11 +1219,11 @@ void MDHistoWorkspace::greaterThan(const signal_t signal) {
 void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b,
                                const signal_t tolerance) {
   checkWorkspaceSize(b, "equalTo");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t diff = fabs(m_signals[i] - b.m_signals[i]);
     m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1215,11 +1237,11 @@ void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b,
  */
 void MDHistoWorkspace::equalTo(const signal_t signal,
                                const signal_t tolerance) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t diff = fabs(m_signals[i] - signal);
     m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1242,12 +1264,12 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
                                     const MDHistoWorkspace &values) {
   checkWorkspaceSize(mask, "setUsingMask");
   checkWorkspaceSize(values, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
-    if (mask.m_signals[i] != 0.0) {
-      m_signals[i] = values.m_signals[i];
-      m_errorsSquared[i] = values.m_errorsSquared[i];
-    }
-  }
+  forEachBin(m_length, [&](const size_t i) {
+    // A select rather than a branch, so that the loop can be vectorized
+    const bool set = mask.m_signals[i] != 0.0;
+    m_signals[i] = set ? values.m_signals[i] : m_signals[i];
+    m_errorsSquared[i] = set ? values.m_errorsSquared[i] : m_errorsSquared[i];
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1272,12 +1294,11 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
                                     const signal_t error) {
   signal_t errorSquared = error * error;
   checkWorkspaceSize(mask, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
-    if (mask.m_signals[i] != 0.0) {
-      m_signals[i] = signal;
-      m_errorsSquared[i] = errorSquared;
-    }
-  }
+  forEachBin(m_length, [&](const size_t i) {
+    const bool set = mask.m_signals[i] != 0.0;
+    m_signals[i] = set ? signal : m_signals[i];
+    m_errorsSquared[i] = set ? errorSquared : m_errorsSquared[i];
+  });
 }
 
 /**
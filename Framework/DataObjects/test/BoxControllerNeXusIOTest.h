@@ -226,6 +226,42 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_compressed_WriteRead() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    TS_ASSERT(!pSaver->isCompressed());
+    pSaver->setCompressed(true);
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    std::string FullPathFile = pSaver->getFileName();
+
+    // Blocks spanning several compression chunks, written out of order
+    const size_t nEvents = 15000;
+    const size_t nColumns = pSaver->getNDataColums();
+    std::vector<float> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < toWrite.size(); i++)
+      toWrite[i] = static_cast<float>(i % 97);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 2 * nEvents));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    // Any block can be read back on its own
+    std::unique_ptr<BoxControllerNeXusIO> pLoader(createTestBoxController());
+    pLoader->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pLoader->openFile(FullPathFile, "r"));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(
+        pLoader->loadBlock(toRead, 2 * nEvents + 9990, 20));
+    TS_ASSERT_EQUALS(toRead.size(), 20 * nColumns);
+    for (size_t i = 0; i < toRead.size(); i++)
+      TS_ASSERT_EQUALS(toRead[i], toWrite[9990 * nColumns + i]);
+    TS_ASSERT_THROWS_NOTHING(pLoader->closeFile());
+
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
 private:
   /// Create a test box controller. Ownership is passed to the caller
   Mantid::DataObjects::BoxControllerNeXusIO *createTestBoxController() {
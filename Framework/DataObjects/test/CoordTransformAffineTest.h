@@ -159,6 +159,35 @@ public:
     compare(3, out, expected);
   }
 
+  /** applyBlock() gives the same result as apply() on each vector */
+  void test_applyBlock() {
+    CoordTransformAffine ct(3, 2);
+    Matrix<coord_t> mat(3, 4);
+    mat[0][0] = 0.5f;
+    mat[0][1] = -1.5f;
+    mat[0][2] = 2.0f;
+    mat[0][3] = 3.0f;
+    mat[1][0] = 0.25f;
+    mat[1][1] = 1.0f;
+    mat[1][2] = -0.75f;
+    mat[1][3] = -2.0f;
+    mat[2][3] = 1.0f;
+    ct.setMatrix(mat);
+
+    const size_t numVectors = 37;
+    std::vector<coord_t> in(numVectors * 3);
+    for (size_t i = 0; i < in.size(); ++i)
+      in[i] = static_cast<coord_t>(i) * 0.3f - 5.0f;
+    std::vector<coord_t> out(numVectors * 2);
+    ct.applyBlock(in.data(), out.data(), numVectors);
+    for (size_t i = 0; i < numVectors; ++i) {
+      coord_t expected[2];
+      ct.apply(in.data() + i * 3, expected);
+      TS_ASSERT_EQUALS(out[i * 2], expected[0]);
+      TS_ASSERT_EQUALS(out[i * 2 + 1], expected[1]);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test a case of a rotation 0.1 radians around +Z,
    * and a projection into the XY plane */
@@ -71,6 +71,22 @@ public:
     TS_ASSERT_DELTA(output[2], 3.0, 1e-6);
   }
 
+  void test_applyBlock() {
+    size_t dimToBinFrom[3] = {3, 1, 0};
+    coord_t origin[3] = {5, 10, 15};
+    coord_t scaling[3] = {1, 2, 3};
+    CoordTransformAligned ct(4, 3, dimToBinFrom, origin, scaling);
+
+    coord_t input[8] = {16, 11, 0, 6, 17, 12, 0, 7};
+    coord_t output[6];
+    ct.applyBlock(input, output, 2);
+    for (size_t i = 0; i < 2; ++i) {
+      TS_ASSERT_DELTA(output[i * 3], 1.0 + double(i), 1e-6);
+      TS_ASSERT_DELTA(output[i * 3 + 1], 2.0 + 2.0 * double(i), 1e-6);
+      TS_ASSERT_DELTA(output[i * 3 + 2], 3.0 + 3.0 * double(i), 1e-6);
+    }
+  }
+
   /// Clone the transform, check that it still works
   void test_clone() {
     size_t dimToBinFrom[3] = {3, 1, 0};
@@ -5,6 +5,8 @@
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidHistogramData/LinearGenerator.h"
+#include "MantidHistogramData/LogarithmicGenerator.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/CPUTimer.h"
@@ -12,7 +14,9 @@
 #include "MantidKernel/make_unique.h"
 
 #include <boost/scoped_ptr.hpp>
+#include <algorithm>
 #include <cmath>
+#include <thread>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -787,6 +791,61 @@ public:
     }
   }
 
+  /// Long lists are radix sorted
+  void test_Sort_long_lists_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      for (auto sortType : {TOF_SORT, PULSETIME_SORT, PULSETIMETOF_SORT}) {
+        el = fake_long_list(static_cast<EventType>(this_type));
+        const double tofSum = sumOfTofs();
+        el.sort(sortType);
+        TS_ASSERT_EQUALS(el.getNumberEvents(), 10000);
+        TS_ASSERT_DELTA(sumOfTofs(), tofSum, 1e-6);
+        for (size_t i = 1; i < el.getNumberEvents(); i++) {
+          const auto previous = el.getEvent(i - 1);
+          const auto event = el.getEvent(i);
+          if (sortType == TOF_SORT) {
+            TS_ASSERT_LESS_THAN_EQUALS(previous.tof(), event.tof());
+          } else {
+            TS_ASSERT_LESS_THAN_EQUALS(previous.pulseTime(),
+                                       event.pulseTime());
+          }
+          // Events without pulse times are not sorted by tof
+          if (sortType == PULSETIMETOF_SORT && this_type != WEIGHTED_NOTIME &&
+              previous.pulseTime() == event.pulseTime()) {
+            TS_ASSERT_LESS_THAN_EQUALS(previous.tof(), event.tof());
+          }
+        }
+      }
+    }
+  }
+
+  void test_Sort_long_list_by_pulse_time_keeps_order_within_pulse() {
+    el = fake_long_list();
+    el.sort(TOF_SORT);
+    el.sort(PULSETIME_SORT);
+    // A stable sort by pulse time of a list sorted by tof
+    for (size_t i = 1; i < el.getNumberEvents(); i++) {
+      const auto previous = el.getEvent(i - 1);
+      const auto event = el.getEvent(i);
+      if (previous.pulseTime() == event.pulseTime()) {
+        TS_ASSERT_LESS_THAN_EQUALS(previous.tof(), event.tof());
+      }
+    }
+  }
+
+  void test_SortTOF_long_list_in_columns() {
+    el = fake_long_list(WEIGHTED);
+    const EventList rows(el);
+    el.setStorageType(COLUMN_STORAGE);
+    el.sortTof();
+    TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+    const auto tofs = el.getTofs();
+    TS_ASSERT(std::is_sorted(tofs.cbegin(), tofs.cend()));
+    EventList sortedRows(rows);
+    sortedRows.sortTof();
+    TS_ASSERT_EQUALS(tofs, sortedRows.getTofs());
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_reverse_allTypes() {
     // Go through each possible EventType as the input
@@ -1229,6 +1288,53 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_logarithmic_bins() {
+    // Events on every bin boundary, and one outside either end
+    MantidVec X(11);
+    std::generate(X.begin(), X.end(), LogarithmicGenerator(100.0, 0.5));
+    EventList el3;
+    el3 += TofEvent(50.0, 0);
+    for (auto x : X)
+      el3 += TofEvent(x, 0);
+    el3 += TofEvent(X.back() * 2.0, 0);
+
+    MantidVec Y, E;
+    el3.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y.size(), 10);
+    // The last boundary is not included in the last bin
+    for (std::size_t i = 0; i < Y.size(); i++)
+      TS_ASSERT_EQUALS(Y[i], 1.0);
+
+    el3.switchTo(WEIGHTED);
+    el3 *= 2.0;
+    el3.generateHistogram(X, Y, E);
+    for (std::size_t i = 0; i < Y.size(); i++) {
+      TS_ASSERT_EQUALS(Y[i], 2.0);
+      TS_ASSERT_DELTA(E[i], 2.0, 1e-6);
+    }
+  }
+
+  void test_histogram_regular_and_irregular_bins_agree() {
+    this->fake_data();
+    const EventList el3(el);
+    // Linear bins, and the same bins with one boundary moved so that they
+    // have to be searched
+    MantidVec X(1001);
+    std::generate(X.begin(), X.end(), LinearGenerator(0.0, 1e4));
+    MantidVec irregularX(X);
+    irregularX[500] += 1.0;
+
+    MantidVec Y, E, irregularY;
+    el3.generateHistogram(X, Y, E);
+    el3.generateHistogram(irregularX, irregularY, E);
+    TS_ASSERT_EQUALS(Y.size(), irregularY.size());
+    for (std::size_t i = 0; i < Y.size(); i++) {
+      if (i != 499 && i != 500)
+        TS_ASSERT_EQUALS(Y[i], irregularY[i]);
+    }
+    TS_ASSERT_EQUALS(Y[499] + Y[500], irregularY[499] + irregularY[500]);
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1882,6 +1988,59 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Test splitting by many more splitters than events, most of which get no
+   * events
+   */
+  void test_split_manySplitters() {
+    // 2000 events 10 ns apart
+    EventList events;
+    for (int64_t i = 0; i < 2000; ++i)
+      events.addEventQuickly(TofEvent(0.0, DateAndTime(i * 10)));
+
+    // 1000 splitters of 1 ns from 5 ns, to groups 0, 1 and 2 in turn
+    TimeSplitterType split;
+    std::vector<int64_t> vec_splitTimes{5};
+    std::vector<int> vec_splitGroup;
+    for (int64_t i = 5; i < 1005; ++i) {
+      const int group = static_cast<int>(i % 3);
+      split.push_back(SplittingInterval(i, i + 1, group));
+      vec_splitTimes.push_back(i + 1);
+      vec_splitGroup.push_back(group);
+    }
+
+    std::map<int, EventList *> outputs;
+    for (int i = -1; i < 3; i++)
+      outputs.emplace(i, new EventList());
+
+    // The events at 10 to 1000 ns go to the groups, the event at 0 ns goes
+    // to -1 and the events after the last splitter are dropped
+    events.splitByPulseTime(split, outputs);
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 33);
+    TS_ASSERT_EQUALS(outputs[1]->getNumberEvents(), 34);
+    TS_ASSERT_EQUALS(outputs[2]->getNumberEvents(), 33);
+    TS_ASSERT_EQUALS(outputs[1]->getEvent(33).pulseTime(), DateAndTime(1000));
+
+    events.splitByFullTime(split, outputs, false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 33);
+    TS_ASSERT_EQUALS(outputs[1]->getNumberEvents(), 34);
+    TS_ASSERT_EQUALS(outputs[2]->getNumberEvents(), 33);
+
+    // With fewer splitters than events, the events before the first splitter
+    // are dropped too
+    events.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup,
+                                         outputs, false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 33);
+    TS_ASSERT_EQUALS(outputs[1]->getNumberEvents(), 34);
+    TS_ASSERT_EQUALS(outputs[2]->getNumberEvents(), 33);
+
+    for (auto &output : outputs)
+      delete output.second;
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2393,6 +2552,179 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_columnStorage_round_trip_allTypes() {
+    // Go through each possible EventType as the input
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data(static_cast<EventType>(this_type));
+      const EventList rows(el);
+      TS_ASSERT_EQUALS(el.getStorageType(), ROW_STORAGE);
+
+      el.setStorageType(COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getEventType(), rows.getEventType());
+      TS_ASSERT_EQUALS(el.getNumberEvents(), rows.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getTofs(), rows.getTofs());
+      TS_ASSERT_EQUALS(el.getWeights(), rows.getWeights());
+      TS_ASSERT_EQUALS(el.getPulseTimes(), rows.getPulseTimes());
+
+      // Asking for the event structures goes back to rows
+      TS_ASSERT(el == rows);
+      TS_ASSERT_EQUALS(el.getStorageType(), ROW_STORAGE);
+    }
+  }
+
+  void test_columnStorage_copy_keeps_columns() {
+    this->fake_data();
+    el.setStorageType(COLUMN_STORAGE);
+    const EventList copy(el);
+    TS_ASSERT_EQUALS(copy.getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(copy.getTofs(), el.getTofs());
+  }
+
+  void test_columnStorage_read_while_switching_to_rows() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data(static_cast<EventType>(this_type));
+      const EventList rows(el);
+      el.setStorageType(COLUMN_STORAGE);
+      const EventList &constList = el;
+      // A const method that needs the event structures switches to rows
+      // while this thread keeps reading
+      bool equal = false;
+      std::thread switcher(
+          [&constList, &rows, &equal]() { equal = constList == rows; });
+      for (int i = 0; i < 100; i++) {
+        TS_ASSERT_EQUALS(constList.getNumberEvents(), NUMEVENTS);
+        TS_ASSERT(!constList.empty());
+        TS_ASSERT_EQUALS(constList.getTofMin(), rows.getTofMin());
+        TS_ASSERT_EQUALS(constList.getTofMax(), rows.getTofMax());
+      }
+      switcher.join();
+      TS_ASSERT(equal);
+      TS_ASSERT_EQUALS(el.getStorageType(), ROW_STORAGE);
+      const size_t keptColumns = el.getMemorySize();
+
+      // The next non-const switch frees the columns
+      el.setStorageType(ROW_STORAGE);
+      TS_ASSERT_LESS_THAN(el.getMemorySize(), keptColumns);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS);
+    }
+  }
+
+  void test_columnStorage_pulse_times() {
+    // Many events from a few pulses, in no particular order
+    el = EventList();
+    el.reserve(1000);
+    for (int i = 0; i < 1000; i++)
+      el += TofEvent(static_cast<double>(i), (i * 7) % 10);
+    EventList rows(el);
+    el.setStorageType(COLUMN_STORAGE);
+    // The pulse indices take less memory than the pulse times
+    TS_ASSERT_LESS_THAN(el.getMemorySize(), rows.getMemorySize());
+    TS_ASSERT_EQUALS(el.getPulseTimeMin(), rows.getPulseTimeMin());
+    TS_ASSERT_EQUALS(el.getPulseTimeMax(), rows.getPulseTimeMax());
+
+    rows.sortPulseTime();
+    el.sortPulseTime();
+    TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+    TS_ASSERT_EQUALS(el.getPulseTimes(), rows.getPulseTimes());
+  }
+
+  void test_columnStorage_shared_pulse_times() {
+    std::vector<DateAndTime> pulses{DateAndTime(300), DateAndTime(100),
+                                    DateAndTime(200), DateAndTime(100)};
+    const auto table = EventList::makePulseTimeTable(pulses);
+    TS_ASSERT_EQUALS(table->size(), 3);
+    TS_ASSERT(std::is_sorted(table->begin(), table->end()));
+
+    EventList el1, el2;
+    el1 += TofEvent(1.0, 200);
+    el1 += TofEvent(2.0, 100);
+    el2 += TofEvent(3.0, 300);
+    el1.setStorageType(COLUMN_STORAGE, table);
+    el2.setStorageType(COLUMN_STORAGE, table);
+    TS_ASSERT_EQUALS(table.use_count(), 3);
+    TS_ASSERT_EQUALS(el1.getPulseTimes()[0], DateAndTime(200));
+    TS_ASSERT_EQUALS(el2.getPulseTimes()[0], DateAndTime(300));
+
+    // A pulse time missing from the table makes the list use its own
+    EventList el3;
+    el3 += TofEvent(4.0, 400);
+    el3.setStorageType(COLUMN_STORAGE, table);
+    TS_ASSERT_EQUALS(table.use_count(), 3);
+    TS_ASSERT_EQUALS(el3.getPulseTimes()[0], DateAndTime(400));
+  }
+
+  void test_columnStorage_sortPulseTime_with_a_large_table() {
+    // A table of many more pulses than the events of each list
+    std::vector<DateAndTime> pulses;
+    for (int64_t i = 0; i < 1000000; ++i)
+      pulses.emplace_back(i * 1000);
+    const auto table = EventList::makePulseTimeTable(pulses);
+
+    // Lists of a few events and of more events than the radix sort threshold,
+    // spread over the whole table
+    for (const int numEvents : {10, 5000}) {
+      EventList el;
+      srand(1234);
+      for (int i = 0; i < numEvents; ++i)
+        el += TofEvent(static_cast<double>(i), (rand() % 1000000) * 1000);
+      EventList rows(el);
+      el.setStorageType(COLUMN_STORAGE, table);
+
+      rows.sortPulseTime();
+      el.sortPulseTime();
+      TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getPulseTimes(), rows.getPulseTimes());
+      // The order of the events of the same pulse is kept
+      TS_ASSERT_EQUALS(el.getTofs(), rows.getTofs());
+    }
+  }
+
+  void test_columnStorage_histogram_allTypes() {
+    // Go through each possible EventType as the input
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      this->test_setX();
+      const EventList rows(el);
+      el.setStorageType(COLUMN_STORAGE);
+
+      const MantidVec &X = rows.readX();
+      MantidVec Y1, E1, Y2, E2;
+      rows.generateHistogram(X, Y1, E1);
+      el.generateHistogram(X, Y2, E2);
+      TS_ASSERT_EQUALS(Y1, Y2);
+      TS_ASSERT_EQUALS(E1, E2);
+      TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+      TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+    }
+  }
+
+  void test_columnStorage_tof_operations_allTypes() {
+    // Go through each possible EventType as the input
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList rows(el);
+      el.setStorageType(COLUMN_STORAGE);
+
+      rows.convertTof(2.0, 5.0);
+      el.convertTof(2.0, 5.0);
+      rows.maskTof(MAX_TOF * 0.25, MAX_TOF * 0.5);
+      el.maskTof(MAX_TOF * 0.25, MAX_TOF * 0.5);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), rows.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getTofMin(), rows.getTofMin());
+      TS_ASSERT_EQUALS(el.getTofMax(), rows.getTofMax());
+      TS_ASSERT_EQUALS(el.integrate(0, MAX_TOF, false),
+                       rows.integrate(0, MAX_TOF, false));
+      TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+
+      TS_ASSERT(el == rows);
+    }
+  }
+
   //==================================================================================
   // Mocking functions
   //==================================================================================
@@ -2552,6 +2884,27 @@ public:
     }
   }
 
+  /** A list long enough to be radix sorted, with negative tofs and many
+   * events in each pulse
+   */
+  EventList fake_long_list(EventType eventType = TOF) {
+    EventList list;
+    srand(1234); // Fixed random seed
+    for (int i = 0; i < 10000; i++)
+      list += TofEvent(1e4 * (rand() * 1.0 / RAND_MAX) - 100.,
+                       DateAndTime("2017-01-01T00:00:00") +
+                           static_cast<int64_t>(rand() % 100) * 16666667);
+    list.switchTo(eventType);
+    return list;
+  }
+
+  double sumOfTofs() {
+    double sum = 0;
+    for (const auto tof : el.getTofs())
+      sum += tof;
+    return sum;
+  }
+
   void fake_data_only_two_times(DateAndTime time1, DateAndTime time2) {
     // Clear the list
     el = EventList();
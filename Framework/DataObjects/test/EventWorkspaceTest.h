@@ -13,12 +13,14 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
 #include <string>
 
 #include "MantidHistogramData/LinearGenerator.h"
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventListLoader.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
@@ -44,6 +46,48 @@ using Mantid::HistogramData::LinearGenerator;
 using Mantid::Types::Core::DateAndTime;
 using Mantid::Types::Event::TofEvent;
 
+namespace {
+/// Loads pairs of spectra, adding as many events as the group index plus one
+class PairsEventListLoader : public EventListLoader {
+public:
+  explicit PairsEventListLoader(const size_t numSpectra)
+      : m_numSpectra(numSpectra) {}
+  size_t numberOfGroups() const override { return m_numSpectra / 2; }
+  size_t groupOfSpectrum(const size_t index) const override {
+    return index / 2;
+  }
+  void loadGroup(const size_t group,
+                 const std::vector<EventList *> &lists) const override {
+    ++loads;
+    for (size_t i = 2 * group; i < 2 * group + 2; ++i)
+      for (size_t event = 0; event <= group; ++event)
+        lists[i]->addEventQuickly(TofEvent(static_cast<double>(event), 0));
+  }
+  mutable size_t loads{0};
+
+private:
+  const size_t m_numSpectra;
+};
+
+/// Loads weighted events of decreasing pulse time into each spectrum
+class UnsortedEventListLoader : public EventListLoader {
+public:
+  size_t numberOfGroups() const override { return 1; }
+  size_t groupOfSpectrum(const size_t) const override { return 0; }
+  void loadGroup(const size_t,
+                 const std::vector<EventList *> &lists) const override {
+    ++loads;
+    for (auto list : lists) {
+      list->switchTo(Mantid::API::WEIGHTED);
+      for (int pulse = 3; pulse > 0; --pulse)
+        list->addEventQuickly(
+            WeightedEvent(1.0, DateAndTime(pulse, 0), 1.0, 1.0));
+    }
+  }
+  mutable size_t loads{0};
+};
+} // namespace
+
 class EventWorkspaceTest : public CxxTest::TestSuite {
 private:
   EventWorkspace_sptr ew;
@@ -611,6 +655,24 @@ public:
     }
   }
 
+  void test_sortAll_with_lists_of_very_different_lengths() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    // A long list, in reverse order, among short ones
+    auto &longList = test_in->getSpectrum(3);
+    for (int i = 0; i < 5000; i++)
+      longList += TofEvent(5000. - i, static_cast<int64_t>(i % 7));
+    test_in->sortAll(TOF_SORT, nullptr);
+
+    TS_ASSERT_EQUALS(test_in->getSortType(), TOF_SORT);
+    for (int wi = 0; wi < NUMPIXELS; wi++) {
+      std::vector<TofEvent> ve = test_in->getSpectrum(wi).getEvents();
+      TS_ASSERT_EQUALS(ve.size(), wi == 3 ? NUMBINS + 5000 : NUMBINS);
+      for (size_t i = 0; i < ve.size() - 1; i++)
+        TS_ASSERT_LESS_THAN_EQUALS(ve[i].tof(), ve[i + 1].tof());
+    }
+  }
+
   /** Nov 29 2010, ticket #1974
    * SegFault on data access through MRU list.
    * Test that parallelization is thread-safe
@@ -784,6 +846,23 @@ public:
     TS_ASSERT_EQUALS(hist1.sharedE(), hist2.sharedE());
   }
 
+  void test_switchStorageType() {
+    const auto numEvents = ew->getNumberEvents();
+    const auto counts = ew->counts(1);
+    ew->clearMRU();
+
+    ew->switchStorageType(COLUMN_STORAGE);
+    for (size_t i = 0; i < ew->getNumberHistograms(); ++i)
+      TS_ASSERT_EQUALS(ew->getSpectrum(i).getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(ew->getNumberEvents(), numEvents);
+    TS_ASSERT_EQUALS(ew->counts(1), counts);
+
+    ew->switchStorageType(ROW_STORAGE);
+    for (size_t i = 0; i < ew->getNumberHistograms(); ++i)
+      TS_ASSERT_EQUALS(ew->getSpectrum(i).getStorageType(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(ew->getNumberEvents(), numEvents);
+  }
+
   void test_clearing_EventList_clears_MRU() {
     auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(2, 1);
     auto y = ws->sharedY(0);
@@ -828,6 +907,85 @@ public:
     // Placement-new to put ws back into valid state (avoid double-destruct)
     static_cast<void>(new (memory) EventList());
   }
+
+  void test_events_are_loaded_on_first_access() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->initialize(5, 2, 1);
+    auto loader = std::make_shared<PairsEventListLoader>(5);
+    ws->setEventListLoader(loader);
+    TS_ASSERT(ws->hasUnloadedEvents());
+    TS_ASSERT_EQUALS(loader->loads, 0);
+
+    TS_ASSERT_EQUALS(ws->getSpectrum(3).getNumberEvents(), 2);
+    TS_ASSERT_EQUALS(loader->loads, 1);
+    TS_ASSERT_EQUALS(ws->getSpectrum(2).getNumberEvents(), 2);
+    TS_ASSERT_EQUALS(loader->loads, 1);
+    // The last spectrum is in no group
+    TS_ASSERT_EQUALS(ws->getSpectrum(4).getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(loader->loads, 1);
+    TS_ASSERT(ws->hasUnloadedEvents());
+
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 6);
+    TS_ASSERT_EQUALS(loader->loads, 2);
+    TS_ASSERT(!ws->hasUnloadedEvents());
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getNumberEvents(), 1);
+    TS_ASSERT_EQUALS(loader->loads, 2);
+  }
+
+  void test_histogram_of_unloaded_spectrum() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->initialize(4, 2, 1);
+    ws->setAllX(BinEdges{-0.5, 0.5, 1.5});
+    ws->setEventListLoader(std::make_shared<PairsEventListLoader>(4));
+    TS_ASSERT_EQUALS(ws->y(2)[0], 1.0);
+    TS_ASSERT_EQUALS(ws->y(2)[1], 1.0);
+    TS_ASSERT(ws->hasUnloadedEvents());
+  }
+
+  void test_copy_loads_all_events() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->initialize(4, 2, 1);
+    auto loader = std::make_shared<PairsEventListLoader>(4);
+    ws->setEventListLoader(loader);
+    ws->getSpectrum(0);
+    TS_ASSERT_EQUALS(loader->loads, 1);
+
+    auto copy = ws->clone();
+    TS_ASSERT_EQUALS(loader->loads, 2);
+    TS_ASSERT(!ws->hasUnloadedEvents());
+    TS_ASSERT(!copy->hasUnloadedEvents());
+    TS_ASSERT_EQUALS(copy->getNumberEvents(), 6);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 6);
+    TS_ASSERT_EQUALS(loader->loads, 2);
+  }
+
+  void test_sortAll_sorts_the_loaded_events() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->initialize(2, 2, 1);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+      ws->getSpectrum(i).setSortOrder(PULSETIME_SORT);
+    auto loader = std::make_shared<UnsortedEventListLoader>();
+    ws->setEventListLoader(loader);
+
+    ws->sortAll(PULSETIME_SORT, nullptr);
+    TS_ASSERT_EQUALS(loader->loads, 1);
+    const auto pulseTimes = ws->getSpectrum(1).getPulseTimes();
+    TS_ASSERT(std::is_sorted(pulseTimes.begin(), pulseTimes.end()));
+    TS_ASSERT_EQUALS(ws->getSortType(), PULSETIME_SORT);
+  }
+
+  void test_event_type_and_memory_size_of_unloaded_events() {
+    auto ws = boost::make_shared<EventWorkspace>();
+    ws->initialize(2, 2, 1);
+    const size_t emptySize = ws->getMemorySize();
+    auto loader = std::make_shared<UnsortedEventListLoader>();
+    ws->setEventListLoader(loader);
+
+    TS_ASSERT_EQUALS(ws->getEventType(), Mantid::API::WEIGHTED);
+    TS_ASSERT_EQUALS(loader->loads, 1);
+    TS_ASSERT_LESS_THAN_EQUALS(emptySize + 6 * sizeof(WeightedEvent),
+                               ws->getMemorySize());
+  }
 };
 
 #endif /* EVENTWORKSPACETEST_H_ */
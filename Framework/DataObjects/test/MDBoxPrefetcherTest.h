@@ -0,0 +1,134 @@
+#ifndef MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_
+#define MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidKernel/ISaveable.h"
+#include "MantidTestHelpers/BoxControllerDummyIO.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+#include <cxxtest/TestSuite.h>
+
+#include <memory>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class MDBoxPrefetcherTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDBoxPrefetcherTest *createSuite() {
+    return new MDBoxPrefetcherTest();
+  }
+  static void destroySuite(MDBoxPrefetcherTest *suite) { delete suite; }
+
+  void test_boxes_are_loaded_in_order() {
+    BoxController_sptr bc(new BoxController(3));
+    // Room for two boxes ahead
+    auto boxes = makeFileBackedBoxes(bc, 10, 20);
+    TS_ASSERT_EQUALS(bc->getFileIO()->getReadAheadBufferSize(), 20);
+
+    MDBoxPrefetcher prefetcher(asNodes(boxes));
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      auto box = prefetcher.next();
+      TS_ASSERT_EQUALS(box, boxes[i].get());
+      if (box != boxes[i].get())
+        return;
+      TSM_ASSERT("The events are in memory", box->getISaveable()->isLoaded());
+      TSM_ASSERT("The events are kept until used",
+                 box->getISaveable()->isBusy());
+      TS_ASSERT_EQUALS(box->getDataInMemorySize(), 10);
+      // The events are those on file
+      const auto &events = boxes[i]->getConstEvents();
+      TS_ASSERT_DELTA(events[0].getSignal(), double(10 * i), 1e-5);
+      boxes[i]->releaseEvents();
+      TS_ASSERT(!box->getISaveable()->isBusy());
+    }
+    TS_ASSERT(!prefetcher.next());
+    TS_ASSERT(!prefetcher.next());
+  }
+
+  void test_boxes_larger_than_the_buffer_are_loaded() {
+    BoxController_sptr bc(new BoxController(3));
+    auto boxes = makeFileBackedBoxes(bc, 10, 1);
+
+    MDBoxPrefetcher prefetcher(asNodes(boxes));
+    size_t count = 0;
+    while (auto box = prefetcher.next()) {
+      TS_ASSERT_EQUALS(box->getDataInMemorySize(), 10);
+      box->getISaveable()->setBusy(false);
+      ++count;
+    }
+    TS_ASSERT_EQUALS(count, boxes.size());
+  }
+
+  void test_boxes_in_memory_are_handed_out() {
+    BoxController_sptr bc(new BoxController(3));
+    MDBox<MDLeanEvent<3>, 3> box1(bc.get());
+    MDBox<MDLeanEvent<3>, 3> box2(bc.get());
+    MDEventsTestHelper::feedMDBox(&box1, 1, 2, 0.5, 1.0);
+
+    MDBoxPrefetcher prefetcher({&box1, &box2});
+    TS_ASSERT_EQUALS(prefetcher.next(), &box1);
+    TS_ASSERT_EQUALS(prefetcher.next(), &box2);
+    TS_ASSERT(!prefetcher.next());
+  }
+
+  void test_no_boxes() {
+    MDBoxPrefetcher prefetcher({});
+    TS_ASSERT(!prefetcher.next());
+  }
+
+  void test_destructor_releases_boxes_not_handed_out() {
+    BoxController_sptr bc(new BoxController(3));
+    auto boxes = makeFileBackedBoxes(bc, 10, 1000);
+    {
+      MDBoxPrefetcher prefetcher(asNodes(boxes));
+      auto box = prefetcher.next();
+      TS_ASSERT_EQUALS(box, boxes[0].get());
+      box->getISaveable()->setBusy(false);
+    }
+    for (const auto &box : boxes)
+      TS_ASSERT(!box->getISaveable()->isBusy());
+  }
+
+private:
+  using Box = MDBox<MDLeanEvent<3>, 3>;
+
+  /** Make boxes backed by a dummy file of 1000 events, each with 10 events
+   * following the events of the previous box.
+   *
+   * @param bc :: the box controller to make file-backed
+   * @param numBoxes :: number of boxes to make
+   * @param readAhead :: the read-ahead buffer size, in events
+   */
+  std::vector<std::unique_ptr<Box>>
+  makeFileBackedBoxes(BoxController_sptr bc, const size_t numBoxes,
+                      const uint64_t readAhead) {
+    auto loader = boost::shared_ptr<API::IBoxControllerIO>(
+        new MantidTestHelpers::BoxControllerDummyIO(bc.get()));
+    std::vector<std::unique_ptr<Box>> boxes;
+    for (size_t i = 0; i < numBoxes; ++i)
+      boxes.emplace_back(new Box(bc.get()));
+    loader->setDataType(boxes[0]->getCoordType(), boxes[0]->getEventType());
+    bc->setFileBacked(loader, "existingDummy");
+    bc->getFileIO()->setWriteBufferSize(100000);
+    bc->getFileIO()->setReadAheadBufferSize(readAhead);
+    for (size_t i = 0; i < numBoxes; ++i)
+      boxes[i]->setFileBacked(10 * i, 10, true);
+    return boxes;
+  }
+
+  std::vector<IMDNode *>
+  asNodes(const std::vector<std::unique_ptr<Box>> &boxes) {
+    std::vector<IMDNode *> nodes;
+    for (const auto &box : boxes)
+      nodes.push_back(box.get());
+    return nodes;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_ */
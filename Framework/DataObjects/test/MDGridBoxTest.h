@@ -958,6 +958,45 @@ public:
 
   void test_addEvents_inParallel() { do_test_addEvents_inParallel(nullptr); }
 
+  /** Adding many events at once shares them between the threads by child box
+   * and keeps their order within each box */
+  void test_addEventsInParallel() {
+    MDGridBox<MDLeanEvent<2>, 2> *b = MDEventsTestHelper::makeMDGridBox<2>();
+    std::vector<MDLeanEvent<2>> events;
+    for (int repeat = 0; repeat < 200; repeat++)
+      for (double x = 0.5; x < 10; x += 1.0)
+        for (double y = 0.5; y < 10; y += 1.0) {
+          coord_t centers[2] = {static_cast<coord_t>(x),
+                                static_cast<coord_t>(y)};
+          events.push_back(
+              MDLeanEvent<2>(static_cast<float>(repeat), 1.0f, centers));
+        }
+    // On the upper boundary of the last box, kept as by addEvent()
+    coord_t lastCorner[2] = {10.0f, 9.5f};
+    events.push_back(MDLeanEvent<2>(1.0, 1.0, lastCorner));
+
+    size_t numAdded = 0;
+    TS_ASSERT_THROWS_NOTHING(numAdded = b->addEventsInParallel(events));
+    TS_ASSERT_EQUALS(numAdded, 20001);
+    b->refreshCache(nullptr);
+    TS_ASSERT_EQUALS(b->getNPoints(), 20001);
+
+    std::vector<MDBoxBase<MDLeanEvent<2>, 2> *> boxes = b->getBoxes();
+    TS_ASSERT_EQUALS(boxes.size(), 100);
+    for (size_t i = 0; i < boxes.size(); i++) {
+      auto box = dynamic_cast<MDBox<MDLeanEvent<2>, 2> *>(boxes[i]);
+      const auto &boxEvents = box->getConstEvents();
+      TS_ASSERT_EQUALS(boxEvents.size(), i == 99 ? 201 : 200);
+      for (size_t j = 0; j < 200; j++)
+        TS_ASSERT_EQUALS(boxEvents[j].getSignal(), static_cast<float>(j));
+      box->releaseEvents();
+    }
+
+    BoxController *const bcc = b->getBoxController();
+    delete b;
+    delete bcc;
+  }
+
   /** Disabled because parallel RefreshCache is not implemented. Might not be
    * ever? */
   void xtest_addEvents_inParallel_then_refreshCache_inParallel() {
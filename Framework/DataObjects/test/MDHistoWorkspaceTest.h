@@ -877,6 +877,28 @@ public:
     checkWorkspace(a, 1.5, 1.5 * 1.5 * (.5 + 1. / 3.), 1.0);
   }
 
+  //--------------------------------------------------------------------------------------
+  void test_operations_on_large_workspace() {
+    // Enough bins for the operations to run in parallel
+    MDHistoWorkspace_sptr a = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        3.0, 3, 50, 10.0, 3.0 /*errorSquared*/);
+    MDHistoWorkspace_sptr b = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        2.0, 3, 50, 10.0, 2.0 /*errorSquared*/);
+    *a /= *b;
+    checkWorkspace(a, 1.5, 1.5 * 1.5 * (.5 + 1. / 3.));
+    a->add(0.5, 0.0);
+    checkWorkspace(a, 2.0, 1.5 * 1.5 * (.5 + 1. / 3.));
+
+    MDHistoWorkspace_sptr mask =
+        MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 3, 50, 10.0, 0.0);
+    const size_t last = mask->getNPoints() - 1;
+    mask->setSignalAt(last, 1.0);
+    a->setUsingMask(*mask, 6.78, 0.0);
+    TS_ASSERT_DELTA(a->getSignalAt(0), 2.0, 1e-5);
+    TS_ASSERT_DELTA(a->getSignalAt(last - 1), 2.0, 1e-5);
+    TS_ASSERT_DELTA(a->getSignalAt(last), 6.78, 1e-5);
+  }
+
   //--------------------------------------------------------------------------------------
   void test_exp() {
     MDHistoWorkspace_sptr a =
@@ -80,6 +80,7 @@ public:
   virtual ~DiskBuffer() = default;
 
   void toWrite(ISaveable *item);
+  void loadBusy(ISaveable *item);
   void flushCache();
   void objectDeleted(ISaveable *item);
 
@@ -103,7 +104,7 @@ public:
    * use the write buffer  */
   void setWriteBufferSize(uint64_t buffer) {
     if (buffer > std::numeric_limits<size_t>::max() / 2)
-      throw std::runtime_error(" Can not aloocate memory for that many events "
+      throw std::runtime_error(" Can not allocate memory for that many events "
                                "on given architecture ");
 
     m_writeBufferSize = static_cast<size_t>(buffer);
@@ -115,6 +116,20 @@ public:
   ///@return the memory used in the "toWrite" buffer, in number of events
   uint64_t getWriteBufferUsed() const { return m_writeBufferUsed; }
 
+  /** Set the amount of memory that may be held by objects loaded ahead of
+   * their use, e.g. by a MDBoxPrefetcher.
+   * @param buffer :: number of events */
+  void setReadAheadBufferSize(uint64_t buffer) {
+    if (buffer > std::numeric_limits<size_t>::max() / 2)
+      throw std::runtime_error(" Can not allocate memory for that many events "
+                               "on given architecture ");
+
+    m_readAheadBufferSize = static_cast<size_t>(buffer);
+  }
+
+  /// @return the size of the read-ahead buffer, in number of events
+  uint64_t getReadAheadBufferSize() const { return m_readAheadBufferSize; }
+
   //-------------------------------------------------------------------------------------------
   ///@return reference to the free space map (for testing only!)
   freeSpace_t &getFreeSpaceMap() { return m_free; }
@@ -142,6 +157,9 @@ protected:
   /// Amount of memory to accumulate in the write buffer before writing.
   size_t m_writeBufferSize;
 
+  /// Amount of memory objects loaded ahead of their use may hold.
+  size_t m_readAheadBufferSize;
+
   /// Total amount of memory in the "toWrite" buffer.
   size_t m_writeBufferUsed;
   /// number of objects stored in to write buffer list
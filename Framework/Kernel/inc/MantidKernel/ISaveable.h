@@ -2,6 +2,7 @@
 #define MANTID_KERNEL_ISAVEABLE_H_
 
 #include "MantidKernel/System.h"
+#include <atomic>
 #include <list>
 #include <mutex>
 #ifndef Q_MOC_RUN
@@ -135,7 +136,7 @@ protected:
   //--------------
   /// a user needs to set this variable to true preventing from deleting data
   /// from buffer
-  bool m_Busy;
+  std::atomic<bool> m_Busy;
   /** a user needs to set this variable to true to allow DiskBuffer saving the
      object to HDD
       when it decides it suitable,  if the size of iSavable object in cache is
@@ -148,7 +149,7 @@ protected:
   /// changed in memory)
   mutable bool m_wasSaved;
   /// this boolean indicates, if the data have its copy in memory
-  bool m_isLoaded;
+  std::atomic<bool> m_isLoaded;
 
 private:
   // the iterator which describes the position of this object in the DiskBuffer.
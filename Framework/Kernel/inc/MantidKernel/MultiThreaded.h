@@ -2,6 +2,7 @@
 #define MANTID_KERNEL_MULTITHREADED_H_
 
 #include "MantidKernel/DataItem.h"
+#include "MantidKernel/ThreadBudget.h"
 
 #include <atomic>
 #include <mutex>
@@ -125,20 +126,26 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 
 #include <omp.h>
 
+/** The number of threads of the parallel regions of the macros below, which
+ * keeps the threads of the whole process within the ThreadBudget.
+ */
+#define PARALLEL_NUM_THREADS                                                   \
+  num_threads(Mantid::Kernel::ThreadBudget::getNumThreadsForParallelRegion())
+
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes an arbirary check: condition.
 *   "condition" must evaluate to TRUE in order for the
 *   code to be executed in parallel
 */
 #define PARALLEL_FOR_IF(condition)                                             \
-    PRAGMA(omp parallel for if (condition) )
+    PRAGMA(omp parallel for if (condition) PARALLEL_NUM_THREADS)
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes no checks to see if workspaces are suitable
 *   and therefore should not be used in any loops that access workspaces.
 */
 #define PARALLEL_FOR_NO_WSP_CHECK()                                            \
-    PRAGMA(omp parallel for)
+    PRAGMA(omp parallel for PARALLEL_NUM_THREADS)
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *  and declare the varialbes to be firstprivate.
@@ -146,10 +153,11 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
  *  and therefore should not be used in any loops that access workspace.
  */
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)                         \
-  PRAGMA(omp parallel for firstprivate(variable) )
+  PRAGMA(omp parallel for firstprivate(variable) PARALLEL_NUM_THREADS)
 
 #define PARALLEL_FOR_NO_WSP_CHECK_FIRSTPRIVATE2(variable1, variable2)          \
-  PRAGMA(omp parallel for firstprivate(variable1, variable2) )
+  PRAGMA(omp parallel for firstprivate(variable1, variable2)                 \
+             PARALLEL_NUM_THREADS)
 
 /** Ensures that the next execution line or block is only executed if
 * there are multple threads execting in this region
@@ -186,7 +194,7 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 
 #define PARALLEL_THREAD_NUMBER omp_get_thread_num()
 
-#define PARALLEL PRAGMA(omp parallel)
+#define PARALLEL PRAGMA(omp parallel PARALLEL_NUM_THREADS)
 
 #define PARALLEL_SECTIONS PRAGMA(omp sections nowait)
 
@@ -0,0 +1,60 @@
+#ifndef MANTID_KERNEL_THREADBUDGET_H_
+#define MANTID_KERNEL_THREADBUDGET_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadBudget : Shares the cores of the process between the ThreadPools
+  and the parallel loops of the OpenMP macros of MultiThreaded.h, so that
+  nested and concurrent parallel work does not use more threads than the
+  MultiThreaded.MaxCores setting allows.
+
+  A thread that starts parallel work counts as one of the threads of that
+  work, as it waits for it to finish. A ThreadPool reserves its other threads
+  from the budget while they run, and gets fewer of them when the budget is
+  used up, e.g. when it is started by a task of another pool. The parallel
+  loops of the OpenMP macros run with the calling thread and the threads
+  left in the budget, so a loop within a task of a busy pool runs on the
+  thread of the task only.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadBudget {
+public:
+  static size_t getLimit();
+  static void setLimit(size_t limit);
+
+  static size_t reserve(size_t wanted);
+  static void release(size_t threads);
+  static size_t getNumReserved();
+
+  static int getNumThreadsForParallelRegion();
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADBUDGET_H_ */
@@ -68,6 +68,9 @@ protected:
   /// Number of cores used
   size_t m_numThreads;
 
+  /// Number of threads reserved from the ThreadBudget by the running threads
+  size_t m_reservedThreads;
+
   /// The ThreadScheduler instance taking care of task scheduling
   ThreadScheduler *m_scheduler;
 
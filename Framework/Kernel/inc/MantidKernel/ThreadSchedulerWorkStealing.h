@@ -0,0 +1,95 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A ThreadScheduler that keeps a queue of
+  tasks for each thread of the ThreadPool, so that the threads do not all
+  contend on one lock.
+
+  A thread takes the tasks of its own queue last-in-first-out. When its queue
+  is empty, it steals the oldest task of the queue of another thread. A task
+  pushed from a thread while it runs a task of this scheduler (e.g. a task
+  that splits its work into subtasks) goes to the queue of that thread, so it
+  is likely to be run by the same thread, with its data still in the cache.
+  Tasks pushed from any other thread, including the threads of another pool,
+  are spread over the queues in turn.
+
+  The tasks are run in no particular order, and the mutexes of the tasks are
+  not used to order them: use ThreadSchedulerMutexes for tasks that share a
+  mutex.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  Task *pop(size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+  double totalCostExecuted() override;
+
+  /// @return the number of queues of tasks
+  size_t numQueues() const { return m_queues.size(); }
+
+private:
+  /// The tasks of one thread
+  struct Queue {
+    /// Guards the tasks
+    std::mutex lock;
+    /// Oldest tasks at the front
+    std::deque<Task *> tasks;
+    /// Total cost of the tasks pushed to this queue
+    double cost = 0.;
+    /// Total cost of the tasks popped by the thread of this queue
+    double costExecuted = 0.;
+  };
+
+  /// The queues, by thread number
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  /// Number of tasks in all the queues
+  std::atomic<size_t> m_size;
+  /// Queue of the next task pushed from outside the pool
+  std::atomic<size_t> m_nextQueue;
+  /// Identifies the scheduler to the threads running its tasks
+  const size_t m_id;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
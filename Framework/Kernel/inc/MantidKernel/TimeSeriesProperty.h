@@ -10,6 +10,7 @@
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
 #include <cstdint>
+#include <mutex>
 #include <utility>
 
 // Forward declare
@@ -120,6 +121,8 @@ class DLLExport TimeSeriesProperty : public Property,
 public:
   /// Constructor
   explicit TimeSeriesProperty(const std::string &name);
+  /// Copy constructor
+  TimeSeriesProperty(const TimeSeriesProperty<TYPE> &other);
   /// Virtual destructor
   ~TimeSeriesProperty() override;
   /// "Virtual" copy constructor
@@ -350,6 +353,12 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// Time integral of the values, in value * seconds, from the first time to
+  /// the time of each entry. Built when needed and cleared on any change.
+  mutable std::vector<double> m_cumulativeIntegral;
+  /// Guards building the cumulative integral, which const methods may do
+  /// from several threads at once
+  mutable std::mutex m_cumulativeIntegralMutex;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -12,8 +12,9 @@ namespace Kernel {
 /** Constructor
  */
 DiskBuffer::DiskBuffer()
-    : m_writeBufferSize(50), m_writeBufferUsed(0), m_nObjectsToWrite(0),
-      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0) {
+    : m_writeBufferSize(50), m_readAheadBufferSize(50), m_writeBufferUsed(0),
+      m_nObjectsToWrite(0), m_free(), m_free_bySize(m_free.get<1>()),
+      m_fileLength(0) {
   m_free.clear();
 }
 
@@ -21,11 +22,12 @@ DiskBuffer::DiskBuffer()
 /** Constructor
  *
  * @param m_writeBufferSize :: Amount of memory to accumulate in the write
- *buffer before writing.
+ *buffer before writing. The read-ahead buffer gets the same size.
  * @return
  */
 DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize)
-    : m_writeBufferSize(m_writeBufferSize), m_writeBufferUsed(0),
+    : m_writeBufferSize(m_writeBufferSize),
+      m_readAheadBufferSize(m_writeBufferSize), m_writeBufferUsed(0),
       m_nObjectsToWrite(0), m_free(), m_free_bySize(m_free.get<1>()),
       m_fileLength(0) {
   m_free.clear();
@@ -68,6 +70,29 @@ void DiskBuffer::toWrite(ISaveable *item) {
     writeOldObjects();
 }
 
+//---------------------------------------------------------------------------------------------
+/** Flag an object as busy and load its data, e.g. from another thread ahead
+ * of its use. The object is then added to the to-write buffer, as by
+ * toWrite(). Release the object with ISaveable::setBusy(false) when done.
+ *
+ * The object is flagged while the to-write buffer is locked, so that
+ * writeOldObjects() cannot be writing it out and clearing its data while it
+ * is loaded.
+ *
+ * @param item :: item to load
+ */
+void DiskBuffer::loadBusy(ISaveable *item) {
+  if (item == nullptr)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    item->setBusy(true);
+  }
+  if (item->wasSaved())
+    item->load();
+  toWrite(item);
+}
+
 //---------------------------------------------------------------------------------------------
 /** Call this method when an object that might be in the cache
  * is getting deleted.
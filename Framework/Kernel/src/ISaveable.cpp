@@ -16,7 +16,7 @@ ISaveable::ISaveable()
     Note setting isLoaded to false to break connection with the file object
    which is not copyale */
 ISaveable::ISaveable(const ISaveable &other)
-    : m_Busy(other.m_Busy), m_dataChanged(other.m_dataChanged),
+    : m_Busy(other.m_Busy.load()), m_dataChanged(other.m_dataChanged),
       m_wasSaved(other.m_wasSaved), m_isLoaded(false),
       m_BufPosition(other.m_BufPosition),
       m_BufMemorySize(other.m_BufMemorySize),
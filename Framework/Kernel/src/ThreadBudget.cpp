@@ -0,0 +1,80 @@
+#include "MantidKernel/ThreadBudget.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Maximum number of threads, or 0 if not set yet
+std::atomic<size_t> g_limit(0);
+/// Number of threads reserved, on top of the threads that reserved them
+std::atomic<size_t> g_reserved(0);
+} // namespace
+
+/**
+ * @return the maximum number of threads of the process. Unless set with
+ * setLimit(), this is the number of cores used by a ThreadPool by default,
+ * which respects the MultiThreaded.MaxCores setting.
+ */
+size_t ThreadBudget::getLimit() {
+  size_t limit = g_limit;
+  if (limit == 0) {
+    limit = std::max(ThreadPool::getNumPhysicalCores(), size_t(1));
+    size_t unset = 0;
+    if (!g_limit.compare_exchange_strong(unset, limit))
+      limit = unset;
+  }
+  return limit;
+}
+
+/**
+ * Set the maximum number of threads of the process.
+ * @param limit :: the maximum; 0 to go back to the default
+ */
+void ThreadBudget::setLimit(size_t limit) { g_limit = limit; }
+
+/**
+ * Reserve threads, as many as the budget has left up to the number wanted.
+ * The threads must be given back with release().
+ * @param wanted :: the number of threads wanted, besides the calling thread
+ * @return the number of threads reserved, possibly 0
+ */
+size_t ThreadBudget::reserve(size_t wanted) {
+  const size_t limit = getLimit();
+  size_t reserved = g_reserved;
+  size_t granted;
+  do {
+    const size_t left = limit - 1 > reserved ? limit - 1 - reserved : 0;
+    granted = std::min(wanted, left);
+  } while (!g_reserved.compare_exchange_weak(reserved, reserved + granted));
+  return granted;
+}
+
+/**
+ * Give back threads reserved with reserve().
+ * @param threads :: the number of threads to give back
+ */
+void ThreadBudget::release(size_t threads) { g_reserved -= threads; }
+
+/// @return the number of threads reserved
+size_t ThreadBudget::getNumReserved() { return g_reserved; }
+
+/**
+ * @return the number of threads for a parallel region started now: the
+ * calling thread and the threads left in the budget. It is never more than
+ * PARALLEL_GET_MAX_THREADS, which the callers may use to size their
+ * per-thread buffers.
+ */
+int ThreadBudget::getNumThreadsForParallelRegion() {
+  const size_t limit = getLimit();
+  const size_t reserved = g_reserved;
+  const size_t left = limit - 1 > reserved ? limit - 1 - reserved : 0;
+  return std::min(static_cast<int>(1 + left), PARALLEL_GET_MAX_THREADS);
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -7,6 +7,7 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadBudget.h"
 #include "MantidKernel/ThreadPoolRunnable.h"
 
 #include <Poco/Thread.h>
@@ -37,7 +38,8 @@ namespace Kernel {
  */
 ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
                        ProgressBase *prog)
-    : m_scheduler(scheduler), m_started(false), m_prog(prog) {
+    : m_reservedThreads(0), m_scheduler(scheduler), m_started(false),
+      m_prog(prog) {
   if (!m_scheduler)
     throw std::invalid_argument(
         "NULL ThreadScheduler passed to ThreadPool constructor.");
@@ -54,6 +56,7 @@ ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
 /** Destructor. Deletes the ThreadScheduler.
  */
 ThreadPool::~ThreadPool() {
+  ThreadBudget::release(m_reservedThreads);
   if (m_scheduler)
     delete m_scheduler;
   if (m_prog)
@@ -84,6 +87,10 @@ size_t ThreadPool::getNumPhysicalCores() {
 
 //--------------------------------------------------------------------------------
 /** Start the threads and begin looking for tasks.
+ *
+ * The pool starts one thread, and as many of the others as the ThreadBudget
+ * has left, so that pools started from the tasks of another pool do not run
+ * more threads than there are cores.
  *
  * @param waitSec :: how many seconds will each thread be allowed to wait (with
  *no tasks scheduled to it)
@@ -102,11 +109,15 @@ void ThreadPool::start(double waitSec) {
     delete thread;
   for (auto &runnable : m_runnables)
     delete runnable;
+  ThreadBudget::release(m_reservedThreads);
+  m_reservedThreads = 0;
 
   // Now, launch that many threads and let them wait for new tasks.
   m_threads.clear();
   m_runnables.clear();
-  for (size_t i = 0; i < m_numThreads; i++) {
+  m_reservedThreads =
+      ThreadBudget::reserve(std::max(m_numThreads, size_t(1)) - 1);
+  for (size_t i = 0; i < 1 + m_reservedThreads; i++) {
     // Make a descriptive name
     std::ostringstream name;
     name << "Thread" << i;
@@ -189,6 +200,10 @@ void ThreadPool::joinAll() {
     delete runnable;
   m_runnables.clear();
 
+  // Give the threads back to the budget
+  ThreadBudget::release(m_reservedThreads);
+  m_reservedThreads = 0;
+
   // This will make threads restart
   m_started = false;
 
@@ -0,0 +1,141 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of the identifiers of the schedulers
+std::atomic<size_t> g_nextId(1);
+
+/// The scheduler whose tasks the current thread runs, if any
+thread_local size_t t_schedulerId = 0;
+/// The queue of the current thread in that scheduler
+thread_local size_t t_queue = 0;
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+/** Constructor
+ *
+ * @param numQueues :: number of queues of tasks, which should be the number
+ *        of threads of the ThreadPool; default = 0, meaning the number of
+ *        cores used by a ThreadPool by default.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler(), m_size(0), m_nextQueue(0), m_id(g_nextId++) {
+  if (numQueues == 0)
+    numQueues = ThreadPool::getNumPhysicalCores();
+  numQueues = std::max(numQueues, size_t(1));
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(new Queue);
+}
+
+/// Destructor. Deletes the tasks left.
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//----------------------------------------------------------------------------------------------
+/** Add a Task to the queue of the calling thread if it runs the tasks of this
+ * scheduler, or else to the next queue in turn.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  const size_t index = t_schedulerId == m_id
+                           ? t_queue
+                           : m_nextQueue++ % m_queues.size();
+  auto &queue = *m_queues[index];
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.cost += newTask->cost();
+  queue.tasks.push_back(newTask);
+  ++m_size;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Retrieves the newest task of the queue of the thread or, if it is empty,
+ * the oldest task of another queue.
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or nullptr if there are no tasks.
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t numQueues = m_queues.size();
+  const size_t own = threadnum % numQueues;
+  // The tasks pushed from now on by this thread go to its own queue
+  t_schedulerId = m_id;
+  t_queue = own;
+
+  auto &ownQueue = *m_queues[own];
+  std::unique_lock<std::mutex> ownLock(ownQueue.lock);
+  if (!ownQueue.tasks.empty()) {
+    Task *task = ownQueue.tasks.back();
+    ownQueue.tasks.pop_back();
+    --m_size;
+    ownQueue.costExecuted += task->cost();
+    return task;
+  }
+  ownLock.unlock();
+
+  for (size_t i = 1; i < numQueues && m_size > 0; ++i) {
+    Task *task = nullptr;
+    {
+      auto &queue = *m_queues[(own + i) % numQueues];
+      std::lock_guard<std::mutex> lock(queue.lock);
+      if (queue.tasks.empty())
+        continue;
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      --m_size;
+    }
+    // A stolen task counts as executed by the thief
+    ownLock.lock();
+    ownQueue.costExecuted += task->cost();
+    return task;
+  }
+  return nullptr;
+}
+
+/// @return the number of tasks in all the queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all the queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+/// Empty out the queues and delete the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    for (auto &task : queue->tasks)
+      delete task;
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->cost = 0.;
+    queue->costExecuted = 0.;
+  }
+  m_cost = 0;
+  m_costExecuted = 0;
+}
+
+/// @return the total cost of the tasks pushed since the last clear()
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->cost;
+  }
+  return cost;
+}
+
+/// @return the total cost of the tasks popped since the last clear()
+double ThreadSchedulerWorkStealing::totalCostExecuted() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->costExecuted;
+  }
+  return cost;
+}
+
+} // namespace Kernel
+} // namespace Mantid
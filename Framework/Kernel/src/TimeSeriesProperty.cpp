@@ -8,6 +8,8 @@
 
 #include <boost/regex.hpp>
 
+#include <mutex>
+
 namespace Mantid {
 using namespace Types::Core;
 namespace Kernel {
@@ -23,7 +25,22 @@ Logger g_log("TimeSeriesProperty");
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
     : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(),
-      m_size(), m_propSortedFlag(), m_filterApplied() {}
+      m_size(), m_propSortedFlag(), m_filterApplied(),
+      m_cumulativeIntegral(), m_cumulativeIntegralMutex() {}
+
+/**
+ * Copy constructor. The cumulative integral is not copied, as another thread
+ * may be building it, and is rebuilt when needed.
+ *  @param other :: The property to copy
+ */
+template <typename TYPE>
+TimeSeriesProperty<TYPE>::TimeSeriesProperty(
+    const TimeSeriesProperty<TYPE> &other)
+    : Property(other), m_values(other.m_values), m_size(other.m_size),
+      m_propSortedFlag(other.m_propSortedFlag), m_filter(other.m_filter),
+      m_filterQuickRef(other.m_filterQuickRef),
+      m_filterApplied(other.m_filterApplied), m_cumulativeIntegral(),
+      m_cumulativeIntegralMutex() {}
 
 /// Virtual destructor
 template <typename TYPE> TimeSeriesProperty<TYPE>::~TimeSeriesProperty() {}
@@ -109,7 +126,8 @@ TimeSeriesProperty<std::string>::getDerivative() const {
 template <typename TYPE>
 size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
   // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime)) +
+         m_cumulativeIntegral.size() * sizeof(double);
 }
 
 /**
@@ -138,6 +156,7 @@ operator+=(Property const *right) {
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      m_cumulativeIntegral.clear();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -309,6 +328,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  m_cumulativeIntegral.clear();
 }
 
 /**
@@ -386,6 +406,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  m_cumulativeIntegral.clear();
 }
 
 /**
@@ -429,6 +450,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         myOutput->m_values.clear();
         myOutput->m_size = 0;
       }
+      myOutput->m_cumulativeIntegral.clear();
     } else {
       outputs_tsp.push_back(nullptr);
     }
@@ -466,8 +488,11 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     }
 
     // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
-      ++i_property;
+    const TimeValueUnit<TYPE> startEntry(start, m_values[0].value());
+    i_property = static_cast<size_t>(
+        std::lower_bound(m_values.begin() + i_property, m_values.end(),
+                         startEntry) -
+        m_values.begin());
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
@@ -489,14 +514,23 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         myOutput->addValue(m_values[i_prev].time(), m_values[i_prev].value());
     }
 
-    // Loop through all the entries until out.
-    while (i_property < m_values.size() && m_values[i_property].time() < stop) {
-
-      // Copy the log out to the output
-      myOutput->addValue(m_values[i_property].time(),
-                         m_values[i_property].value());
-      ++i_property;
+    // Copy all the entries before the stop of the time to the output
+    const TimeValueUnit<TYPE> stopEntry(stop, m_values[0].value());
+    const auto first = m_values.begin() + i_property;
+    const auto last = std::lower_bound(first, m_values.end(), stopEntry);
+    if (first != last) {
+      auto &outValues = myOutput->m_values;
+      // As addValue() would, for entries in order within the interval
+      if (outValues.empty())
+        myOutput->m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+      else if (*first < outValues.back())
+        myOutput->m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
+      outValues.insert(outValues.end(), first, last);
+      myOutput->m_size = static_cast<int>(outValues.size());
+      myOutput->m_filterApplied = false;
+      myOutput->m_cumulativeIntegral.clear();
     }
+    i_property = static_cast<size_t>(last - m_values.begin());
 
     // Go to the next interval
     ++itspl;
@@ -875,29 +909,43 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
 
   sortIfNecessary();
 
+  // The integrals up to each entry, so that each range of the filter only
+  // needs two binary searches
+  {
+    std::lock_guard<std::mutex> lock(m_cumulativeIntegralMutex);
+    if (m_cumulativeIntegral.size() != m_values.size()) {
+      std::vector<double> integral(m_values.size());
+      integral[0] = 0.0;
+      for (size_t i = 1; i < m_values.size(); ++i) {
+        integral[i] = integral[i - 1] +
+                      DateAndTime::secondsFromDuration(m_values[i].time() -
+                                                       m_values[i - 1].time()) *
+                          static_cast<double>(m_values[i - 1].value());
+      }
+      m_cumulativeIntegral.swap(integral);
+    }
+  }
+
+  // The integral from the first time to t, with each value holding until the
+  // next time, and the first value before the first time
+  auto integrateTo = [this](const DateAndTime &t) {
+    const TimeValueUnit<TYPE> entry(t, m_values[0].value());
+    const auto next = std::upper_bound(m_values.begin(), m_values.end(), entry);
+    const size_t index =
+        next == m_values.begin()
+            ? 0
+            : static_cast<size_t>(next - m_values.begin()) - 1;
+    return m_cumulativeIntegral[index] +
+           DateAndTime::secondsFromDuration(t - m_values[index].time()) *
+               static_cast<double>(m_values[index].value());
+  };
+
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += integrateTo(time.stop()) - integrateTo(time.start());
   }
 
   // 'Normalise' by the total time
@@ -1048,6 +1096,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
   TimeValueUnit<TYPE> newvalue(time, value);
   // Add the value to the back of the vector
   m_values.push_back(newvalue);
+  m_cumulativeIntegral.clear();
   // Increment the separate record of the property's size
   m_size++;
 
@@ -1110,6 +1159,7 @@ void TimeSeriesProperty<TYPE>::addValues(
   for (size_t i = 0; i < length; ++i) {
     m_values.emplace_back(times[i], values[i]);
   }
+  m_cumulativeIntegral.clear();
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
@@ -1323,6 +1373,7 @@ TimeSeriesProperty<TYPE>::setDataItem(const boost::shared_ptr<DataItem>) {
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
   m_values.clear();
+  m_cumulativeIntegral.clear();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1915,6 +1966,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  m_cumulativeIntegral.clear();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved
@@ -1958,6 +2010,7 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
         "TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+    m_cumulativeIntegral.clear();
   }
 }
 
@@ -2210,6 +2263,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  m_cumulativeIntegral.clear();
   return "";
 }
 
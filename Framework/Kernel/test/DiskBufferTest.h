@@ -124,6 +124,32 @@ public:
     TS_WARN("Tests here were disabled for the time being");
   }
 
+  void test_readAheadBufferSize() {
+    DiskBuffer dbuf(4);
+    TSM_ASSERT_EQUALS("Defaults to the size of the write buffer",
+                      dbuf.getReadAheadBufferSize(), 4);
+    dbuf.setReadAheadBufferSize(10);
+    TS_ASSERT_EQUALS(dbuf.getReadAheadBufferSize(), 10);
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferSize(), 4);
+  }
+
+  void test_loadBusy_keeps_the_data_in_memory() {
+    DiskBuffer dbuf(4);
+    data[0]->clearDataFromMemory();
+    dbuf.loadBusy(data[0]);
+    TS_ASSERT(data[0]->isLoaded());
+    TS_ASSERT(data[0]->isBusy());
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 2);
+    // Writing out the buffer leaves the busy object alone
+    for (size_t i = 1; i < 3; i++) {
+      data[i]->setDataChanged();
+      dbuf.toWrite(data[i]);
+    }
+    TS_ASSERT(data[0]->isLoaded());
+    TS_ASSERT_EQUALS(data[0]->getDataMemorySize(), 2);
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 2);
+  }
+
   /** Extreme case with nothing writable but exceeding the writable buffer */
   void test_noWriteBuffer_nothingWritable() {
     // Room for 4 in the write buffer
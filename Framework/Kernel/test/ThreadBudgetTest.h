@@ -0,0 +1,87 @@
+#ifndef MANTID_KERNEL_THREADBUDGETTEST_H_
+#define MANTID_KERNEL_THREADBUDGETTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadBudget.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <atomic>
+
+using namespace Mantid::Kernel;
+
+namespace {
+/// Number of threads reserved, as seen from within the tasks
+std::atomic<size_t> g_reservedInTask(0);
+
+void recordReserved() { g_reservedInTask = ThreadBudget::getNumReserved(); }
+} // namespace
+
+class ThreadBudgetTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadBudgetTest *createSuite() { return new ThreadBudgetTest(); }
+  static void destroySuite(ThreadBudgetTest *suite) { delete suite; }
+
+  ThreadBudgetTest() : m_limit(ThreadBudget::getLimit()) {}
+
+  void tearDown() override { ThreadBudget::setLimit(m_limit); }
+
+  void test_default_limit_is_at_least_one() {
+    ThreadBudget::setLimit(0);
+    TS_ASSERT_LESS_THAN_EQUALS(1, ThreadBudget::getLimit());
+  }
+
+  void test_reserve_and_release() {
+    ThreadBudget::setLimit(4);
+    TS_ASSERT_EQUALS(ThreadBudget::getNumReserved(), 0);
+    // The calling thread is not reserved, so 3 are left
+    TS_ASSERT_EQUALS(ThreadBudget::reserve(2), 2);
+    TS_ASSERT_EQUALS(ThreadBudget::reserve(2), 1);
+    TS_ASSERT_EQUALS(ThreadBudget::reserve(2), 0);
+    TS_ASSERT_EQUALS(ThreadBudget::getNumReserved(), 3);
+    ThreadBudget::release(3);
+    TS_ASSERT_EQUALS(ThreadBudget::getNumReserved(), 0);
+  }
+
+  void test_getNumThreadsForParallelRegion() {
+    ThreadBudget::setLimit(4);
+    const int regionThreads = ThreadBudget::getNumThreadsForParallelRegion();
+    TS_ASSERT_LESS_THAN_EQUALS(1, regionThreads);
+    TS_ASSERT_LESS_THAN_EQUALS(regionThreads, 4);
+
+    TS_ASSERT_EQUALS(ThreadBudget::reserve(3), 3);
+    TS_ASSERT_EQUALS(ThreadBudget::getNumThreadsForParallelRegion(), 1);
+    ThreadBudget::release(3);
+  }
+
+  void test_pool_reserves_its_threads_while_running() {
+    ThreadBudget::setLimit(3);
+    g_reservedInTask = 0;
+    ThreadPool pool(new ThreadSchedulerFIFO(), 8);
+    pool.schedule(new FunctionTask(recordReserved));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(g_reservedInTask, 2);
+    TS_ASSERT_EQUALS(ThreadBudget::getNumReserved(), 0);
+  }
+
+  void test_pool_runs_on_one_thread_when_budget_is_used_up() {
+    ThreadBudget::setLimit(2);
+    TS_ASSERT_EQUALS(ThreadBudget::reserve(1), 1);
+    g_reservedInTask = 0;
+    ThreadPool pool(new ThreadSchedulerFIFO(), 4);
+    for (size_t i = 0; i < 10; ++i)
+      pool.schedule(new FunctionTask(recordReserved));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(g_reservedInTask, 1);
+    ThreadBudget::release(1);
+    TS_ASSERT_EQUALS(ThreadBudget::getNumReserved(), 0);
+  }
+
+private:
+  size_t m_limit;
+};
+
+#endif /* MANTID_KERNEL_THREADBUDGETTEST_H_ */
@@ -0,0 +1,114 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <atomic>
+
+using namespace Mantid::Kernel;
+
+namespace {
+/// Counts the tasks run by the nested pools
+std::atomic<size_t> g_nestedCounter(0);
+
+void doNothing() {}
+
+void countNested() { ++g_nestedCounter; }
+
+/// Runs a pool of its own, with 10 tasks
+void runNestedPool() {
+  ThreadPool pool(new ThreadSchedulerWorkStealing(2), 2);
+  for (size_t i = 0; i < 10; ++i)
+    pool.schedule(new FunctionTask(countNested));
+  pool.joinAll();
+}
+} // namespace
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  void test_push_pop_and_clear() {
+    ThreadSchedulerWorkStealing sc(2);
+    TS_ASSERT_EQUALS(sc.numQueues(), 2);
+    TS_ASSERT(sc.empty());
+    sc.push(new FunctionTask(doNothing, 1.0));
+    sc.push(new FunctionTask(doNothing, 2.0));
+    sc.push(new FunctionTask(doNothing, 3.0));
+    TS_ASSERT_EQUALS(sc.size(), 3);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 6.0, 1e-10);
+
+    Task *task = sc.pop(0);
+    TS_ASSERT(task);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), task->cost(), 1e-10);
+    delete task;
+    TS_ASSERT_EQUALS(sc.size(), 2);
+
+    sc.clear();
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 0.0, 1e-10);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 0.0, 1e-10);
+    TS_ASSERT(!sc.pop(0));
+  }
+
+  void test_threads_take_their_own_tasks_last_in_first_out() {
+    ThreadSchedulerWorkStealing sc(2);
+    // Tasks pushed from outside go to the queues in turn:
+    // queue 0 has tasks 0 and 2, queue 1 has tasks 1 and 3
+    std::vector<Task *> tasks;
+    for (size_t i = 0; i < 4; ++i) {
+      tasks.push_back(new FunctionTask(doNothing, static_cast<double>(i)));
+      sc.push(tasks.back());
+    }
+
+    // Own tasks first, newest first, then the oldest task of the other queue
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[2]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[0]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[1]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[3]);
+    TS_ASSERT(!sc.pop(0));
+    // The stolen tasks count as executed too
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 6.0, 1e-10);
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_tasks_pushed_by_a_thread_go_to_its_queue() {
+    ThreadSchedulerWorkStealing sc(2);
+    // This thread now runs the tasks of queue 1
+    TS_ASSERT(!sc.pop(1));
+    Task *first = new FunctionTask(doNothing);
+    Task *second = new FunctionTask(doNothing);
+    sc.push(first);
+    sc.push(second);
+
+    // Another thread steals the oldest
+    TS_ASSERT_EQUALS(sc.pop(0), first);
+    TS_ASSERT_EQUALS(sc.pop(1), second);
+    delete first;
+    delete second;
+  }
+
+  void test_nested_pools() {
+    g_nestedCounter = 0;
+    ThreadPool pool(new ThreadSchedulerWorkStealing(2), 2);
+    for (size_t i = 0; i < 4; ++i)
+      pool.schedule(new FunctionTask(runNestedPool));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(g_nestedCounter, 40);
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
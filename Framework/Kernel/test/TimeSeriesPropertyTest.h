@@ -12,6 +12,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <thread>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -609,6 +610,29 @@ public:
     delete intLog;
   }
 
+  void test_averageValueInFilter_follows_changes_to_the_log() {
+    auto dblLog = createDoubleTSP();
+    TimeSplitterType filter;
+    filter.push_back(SplittingInterval(DateAndTime("2007-11-30T16:17:00"),
+                                       DateAndTime("2007-11-30T16:17:40")));
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 8.41, 0.001);
+
+    dblLog->addValue("2007-11-30T16:17:35", 0.0);
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 7.09125, 0.001);
+
+    // Out of order, so the log gets sorted again
+    dblLog->addValue("2007-11-30T16:17:05", 1.0);
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 5.9675, 0.001);
+
+    dblLog->filterByTime(DateAndTime("2007-11-30T16:17:10"),
+                         DateAndTime("2007-11-30T16:17:40"));
+    filter[0] = SplittingInterval(DateAndTime("2007-11-30T16:17:10"),
+                                  DateAndTime("2007-11-30T16:17:40"));
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 6.125, 0.001);
+
+    delete dblLog;
+  }
+
   void test_timeAverageValue() {
     auto dblLog = createDoubleTSP();
     auto intLog = createIntegerTSP(5);
@@ -621,6 +645,21 @@ public:
     delete intLog;
   }
 
+  void test_timeAverageValue_from_several_threads() {
+    auto dblLog = createDoubleTSP();
+    std::vector<double> averages(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < averages.size(); ++i)
+      threads.emplace_back(
+          [&, i] { averages[i] = dblLog->timeAverageValue(); });
+    for (auto &thread : threads)
+      thread.join();
+    for (const auto average : averages)
+      TS_ASSERT_DELTA(average, 7.6966, .0001);
+
+    delete dblLog;
+  }
+
   void test_averageValueInFilter_throws_for_string_property() {
     TimeSplitterType splitter;
     TS_ASSERT_THROWS(sProp->averageValueInFilter(splitter),
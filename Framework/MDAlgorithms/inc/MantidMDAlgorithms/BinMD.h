@@ -12,6 +12,7 @@
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/VMD.h"
+#include "MantidMDAlgorithms/BinMDCache.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
 
 namespace Mantid {
@@ -63,10 +64,63 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Bin in parallel with a copy of the output arrays per thread
+  template <typename MDE, size_t nd>
+  void binIntoTiles(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+                    const size_t numTiles);
+
+  /// Bin in chunks of the output workspace
+  template <typename MDE, size_t nd>
+  void binInChunks(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+                   const bool doParallel);
+
+  /// Find the cache entry for this cut
+  template <typename MDE, size_t nd>
+  std::shared_ptr<BinMDCacheImpl::Entry>
+  getCacheEntry(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
+  /// Bin reusing the histograms of the boxes in the cache
+  template <typename MDE, size_t nd>
+  void binWithCache(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+                    BinMDCacheImpl::Entry &entry, const bool doParallel);
+
+  /// Make the histogram of a box for the cache
+  template <typename MDE, size_t nd>
+  BinMDCacheImpl::BoxHistogram
+  makeBoxHistogram(DataObjects::MDBox<MDE, nd> *box, const size_t dimension,
+                   const std::vector<double> &direction,
+                   const size_t *const chunkMin, const size_t *const chunkMax);
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                const size_t *const chunkMax);
+                const size_t *const chunkMax, signal_t *const outSignals,
+                signal_t *const outErrors, signal_t *const outNumEvents);
+
+  /// Bin a MDBox from its cached totals, if it is entirely in one bin
+  template <typename MDE, size_t nd>
+  bool binWholeMDBox(DataObjects::MDBox<MDE, nd> *box,
+                     const size_t *const chunkMin, const size_t *const chunkMax,
+                     signal_t *const outSignals, signal_t *const outErrors,
+                     signal_t *const outNumEvents);
+
+  /// Bin the events of a single MDBox
+  template <typename MDE, size_t nd>
+  void binMDBoxEvents(DataObjects::MDBox<MDE, nd> *box,
+                      const size_t *const chunkMin,
+                      const size_t *const chunkMax, signal_t *const outSignals,
+                      signal_t *const outErrors, signal_t *const outNumEvents);
+
+  /// Bin the boxes of a file-backed workspace, loading their events ahead
+  template <typename MDE, size_t nd>
+  void binFileBackedBoxes(const std::vector<API::IMDNode *> &boxes,
+                          const size_t *const chunkMin,
+                          const size_t *const chunkMax);
+
+  /// Find the linear index of the bin of a transformed point
+  bool getLinearIndex(const coord_t *const outCenter,
+                      const size_t *const chunkMin,
+                      const size_t *const chunkMax, size_t &linearIndex) const;
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
@@ -0,0 +1,156 @@
+#ifndef MANTID_MDALGORITHMS_BINMDCACHE_H_
+#define MANTID_MDALGORITHMS_BINMDCACHE_H_
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/Workspace_fwd.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/Matrix.h"
+#include "MantidKernel/SingletonHolder.h"
+#include "MantidMDAlgorithms/DllConfig.h"
+
+#include <Poco/NObserver.h>
+#include <boost/weak_ptr.hpp>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** BinMDCache : Keeps the contributions of the boxes of MDEventWorkspaces to
+  the cuts made by BinMD, so that a cut that only moves the limits of one
+  integrated (single bin) output dimension can be made incrementally.
+
+  An entry of the cache is kept for each workspace and projection: the affine
+  transformation from the workspace to the output bins, and the number of
+  bins. When a cut has the same projection as an entry except for the limits
+  of one integrated dimension, that dimension becomes the varying dimension
+  of the entry. From then on the entry holds, for each box that was binned,
+  the histogram of its events over the other dimensions, and the range of
+  the positions of its events along the varying dimension. A box whose
+  events are all within the new limits adds its histogram to the output
+  without looking at its events again.
+
+  The memory used by the histograms is limited by the binmd.cache.memory
+  configuration setting, in MB. The least recently used entries are dropped
+  first. The entries of a workspace are dropped when it is replaced in the
+  AnalysisDataService, which is also what happens when an algorithm modifies
+  it in place.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_MDALGORITHMS_DLL BinMDCacheImpl {
+public:
+  /// The contribution of a box to the bins of the other dimensions
+  struct BoxHistogram {
+    /// Smallest position of the events along the varying dimension
+    double minPosition{0.};
+    /// Largest position of the events along the varying dimension
+    double maxPosition{0.};
+    /// Linear indexes of the bins the events fall in
+    std::vector<size_t> indexes;
+    /// Signal, squared error and number of events, by bin
+    std::vector<signal_t> values;
+
+    size_t memory() const;
+  };
+
+  /// The cached cuts of a workspace along a projection
+  class Entry {
+  public:
+    /// @return the index of the varying output dimension
+    size_t dimension() const { return m_dimension; }
+    /// @return the unit vector of the varying dimension in the input space
+    const std::vector<double> &direction() const { return m_direction; }
+    const BoxHistogram *find(const size_t boxID) const;
+
+  private:
+    friend class BinMDCacheImpl;
+    /// Guards the histograms
+    mutable std::mutex m_mutex;
+    /// The workspace binned
+    boost::weak_ptr<const API::Workspace> m_workspace;
+    /// Identifies the contents of the workspace when the entry was made
+    std::vector<double> m_fingerprint;
+    /// Affine transformation of the last cut
+    Kernel::Matrix<coord_t> m_transform;
+    /// Number of bins of each output dimension
+    std::vector<size_t> m_numBins;
+    /// The varying dimension, or the number of dimensions if not known yet
+    size_t m_dimension{0};
+    /// Unit vector of the varying dimension
+    std::vector<double> m_direction;
+    /// Histograms by box ID
+    std::unordered_map<size_t, BoxHistogram> m_boxes;
+    /// Memory used by the histograms
+    size_t m_memory{0};
+  };
+
+  std::shared_ptr<Entry>
+  getEntry(const boost::shared_ptr<const API::Workspace> &workspace,
+           const std::vector<double> &fingerprint,
+           const Kernel::Matrix<coord_t> &transform,
+           const std::vector<size_t> &numBins);
+  const BoxHistogram *addBoxHistogram(Entry &entry, const size_t boxID,
+                                      BoxHistogram &histogram);
+  void clear();
+  size_t getMemoryUsed() const;
+  void setMemoryLimit(const size_t bytes);
+
+private:
+  friend struct Kernel::CreateUsingNew<BinMDCacheImpl>;
+  BinMDCacheImpl();
+  ~BinMDCacheImpl();
+
+  void removeEntry(std::list<std::shared_ptr<Entry>>::iterator it);
+  void handleBeforeReplace(API::WorkspaceBeforeReplaceNotification_ptr pNf);
+
+  /// Observer of the workspaces replaced in the AnalysisDataService
+  Poco::NObserver<BinMDCacheImpl, API::WorkspaceBeforeReplaceNotification>
+      m_beforeReplaceObserver;
+
+  /// Entries, most recently used first
+  std::list<std::shared_ptr<Entry>> m_entries;
+  /// Total memory used by the histograms
+  size_t m_memory{0};
+  /// Maximum memory of the histograms
+  size_t m_memoryLimit;
+  /// Guards the entries
+  mutable std::mutex m_mutex;
+};
+
+using BinMDCache = Mantid::Kernel::SingletonHolder<BinMDCacheImpl>;
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+namespace Mantid {
+namespace Kernel {
+EXTERN_MANTID_MDALGORITHMS template class MANTID_MDALGORITHMS_DLL
+    Mantid::Kernel::SingletonHolder<Mantid::MDAlgorithms::BinMDCacheImpl>;
+}
+}
+
+#endif /* MANTID_MDALGORITHMS_BINMDCACHE_H_ */
@@ -61,15 +61,34 @@ public:
   void runConversion(API::Progress *pProgress) override;
 
 private:
+  /// Events of a spectrum converted into MD space, waiting to be added to the
+  /// workspace
+  struct ConvertedEvents {
+    std::vector<coord_t> coord;
+    std::vector<float> sigErr;
+    std::vector<uint16_t> runIndex;
+    std::vector<uint32_t> detIDs;
+  };
+
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
   // the pointer to the source event workspace as event ws does not work through
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-  /**function converts particular type of events into MD space and add these
-   * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  /// converts the events of a spectrum into MD space without adding them to
+  /// the workspace
+  void convertSpectrum(size_t workspaceIndex, MDTransfInterface &qConverter,
+                       ConvertedEvents &converted) const;
+  /**function converts particular type of events into MD space, using the
+   * given transformation, which may be a copy local to a thread    */
+  template <class T>
+  void convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter,
+                        ConvertedEvents &converted) const;
+  /// adds converted events to the workspace and releases them
+  size_t addEvents(ConvertedEvents &converted);
+  /// moves converted events to the end of other converted events
+  static size_t appendEvents(ConvertedEvents &from, ConvertedEvents &to);
 };
 
 } // endNamespace DataObjects
@@ -73,6 +73,9 @@ private:
   void finalizeOutput(const std::string &outputFile);
 
   uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+  void mergeBoxesInMemory(const std::vector<API::IMDNode *> &boxes,
+                          const bool parallel);
+  void mergeBoxesToFile(const std::vector<API::IMDNode *> &boxes);
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
@@ -106,7 +109,7 @@ protected:
   /// # of events loaded from all tasks
   uint64_t m_totalLoaded;
 
-  /// Mutex for file access
+  /// Mutex for file access, as the NeXus library is not thread-safe
   std::mutex m_fileMutex;
 
   /// Mutex for modifying stats
@@ -5,6 +5,7 @@
 #include "MantidDataObjects/CoordTransformAligned.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
@@ -13,10 +14,15 @@
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/ThreadBudget.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -28,6 +34,13 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// Number of events transformed at once by binMDBox
+const size_t EVENT_BLOCK_SIZE = 512;
+/// Maximum memory for the per-thread copies of the output arrays, in bytes
+const size_t MAX_TILE_MEMORY = size_t(512) << 20;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -71,6 +84,13 @@ void BinMD::init() {
       "due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("UseCache", false, Direction::Input),
+      "Keep the histograms of the boxes of the input workspace over all but "
+      "one integrated dimension, so that later cuts that only move the limits "
+      "of that dimension are faster.");
+  setPropertyGroup("UseCache", grp);
+
   declareProperty(make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
                       "TemporaryDataWorkspace", "", Direction::Input,
                       PropertyMode::Optional),
@@ -83,6 +103,38 @@ void BinMD::init() {
                   "A name for the output MDHistoWorkspace.");
 }
 
+//----------------------------------------------------------------------------------------------
+/** Find the bin of the output workspace a transformed point falls in.
+ *
+ * @param outCenter :: the point, in the output dimensions
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param[out] linearIndex :: the linear index of the bin
+ * @return false if the point is outside of the range
+ */
+inline bool BinMD::getLinearIndex(const coord_t *const outCenter,
+                                  const size_t *const chunkMin,
+                                  const size_t *const chunkMax,
+                                  size_t &linearIndex) const {
+  linearIndex = 0;
+  /// Loop through the dimensions on which we bin
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    // What is the bin index in that dimension
+    const coord_t x = outCenter[bd];
+    if (!(x >= 0))
+      return false;
+    const size_t ix = size_t(x);
+    // Within range (for this chunk)?
+    if ((ix < chunkMin[bd]) || (ix >= chunkMax[bd]))
+      return false;
+    // Build up the linear index
+    linearIndex += indexMultiplier[bd] * ix;
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Bin the contents of a MDBox
  *
@@ -91,13 +143,42 @@ void BinMD::init() {
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @param outSignals :: the signal array to add to
+ * @param outErrors :: the squared error array to add to
+ * @param outNumEvents :: the number of events array to add to
  */
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = new coord_t[m_outD];
+                            const size_t *const chunkMax,
+                            signal_t *const outSignals,
+                            signal_t *const outErrors,
+                            signal_t *const outNumEvents) {
+  if (!this->binWholeMDBox(box, chunkMin, chunkMax, outSignals, outErrors,
+                           outNumEvents))
+    this->binMDBoxEvents(box, chunkMin, chunkMax, outSignals, outErrors,
+                         outNumEvents);
+}
 
+//----------------------------------------------------------------------------------------------
+/** Add the cached totals of a MDBox to a bin, if the whole box is in it.
+ *
+ * @param box :: pointer to the MDBox to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param outSignals :: the signal array to add to
+ * @param outErrors :: the squared error array to add to
+ * @param outNumEvents :: the number of events array to add to
+ * @return true if the box was binned; false if its events must be binned
+ */
+template <typename MDE, size_t nd>
+inline bool BinMD::binWholeMDBox(MDBox<MDE, nd> *box,
+                                 const size_t *const chunkMin,
+                                 const size_t *const chunkMax,
+                                 signal_t *const outSignals,
+                                 signal_t *const outErrors,
+                                 signal_t *const outNumEvents) {
   // Evaluate whether the entire box is in the same bin
   if (box->getNPoints() > (1 << nd) * 2) {
     // There is a check that the number of events is enough for it to make sense
@@ -105,39 +186,20 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
     size_t numVertexes = 0;
     auto vertexes = box->getVertexesArray(numVertexes);
 
+    // Transform all the vertexes at once
+    std::vector<coord_t> outVertexes(numVertexes * m_outD);
+    m_transform->applyBlock(vertexes.get(), outVertexes.data(), numVertexes);
+
     // All vertexes have to be within THE SAME BIN = have the same linear index.
     size_t lastLinearIndex = 0;
     bool badOne = false;
 
     for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes.get() + i * nd;
-
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
-      // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
-      // <<  VMD(nd,outCenter) << '\n';
-
       // To build up the linear index
       size_t linearIndex = 0;
       // To mark VERTEXES outside range
-      badOne = false;
-
-      /// Loop through the dimensions on which we bin
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        size_t ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        } else {
-          // Outside the range
-          badOne = true;
-          break;
-        }
-      } // (for each dim in MDHisto)
+      badOne = !getLinearIndex(outVertexes.data() + i * m_outD, chunkMin,
+                               chunkMax, linearIndex);
 
       // Is the vertex at the same place as the last one?
       if (!badOne) {
@@ -156,100 +218,158 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
     if (!badOne) {
       // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
       // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
+      outSignals[lastLinearIndex] += box->getSignal();
+      outErrors[lastLinearIndex] += box->getErrorSquared();
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+      outNumEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
-      delete[] outCenter;
-      return;
+      return true;
     }
   }
+  return false;
+}
 
-  // If you get here, you could not determine that the entire box was in the
-  // same bin.
-  // So you need to iterate through events.
+//----------------------------------------------------------------------------------------------
+/** Bin the events of a MDBox, for a box that could not be determined to be
+ * entirely in the same bin.
+ *
+ * @param box :: pointer to the MDBox to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param outSignals :: the signal array to add to
+ * @param outErrors :: the squared error array to add to
+ * @param outNumEvents :: the number of events array to add to
+ */
+template <typename MDE, size_t nd>
+inline void BinMD::binMDBoxEvents(MDBox<MDE, nd> *box,
+                                  const size_t *const chunkMin,
+                                  const size_t *const chunkMax,
+                                  signal_t *const outSignals,
+                                  signal_t *const outErrors,
+                                  signal_t *const outNumEvents) {
+  // Iterate through events. Their centers are transformed a block at a time,
+  // which the transform can do in a single vectorized loop.
+  coord_t inCenters[EVENT_BLOCK_SIZE * nd];
+  coord_t outCenters[EVENT_BLOCK_SIZE * nd];
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
+  for (size_t begin = 0; begin < events.size(); begin += EVENT_BLOCK_SIZE) {
+    const size_t blockSize = std::min(EVENT_BLOCK_SIZE, events.size() - begin);
+    const MDE *block = events.data() + begin;
+    for (size_t i = 0; i < blockSize; ++i)
+      std::copy_n(block[i].getCenter(), nd, inCenters + i * nd);
 
     // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
-
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
+    m_transform->applyBlock(inCenters, outCenters, blockSize);
 
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
+    for (size_t i = 0; i < blockSize; ++i) {
+      size_t linearIndex = 0;
+      if (getLinearIndex(outCenters + i * m_outD, chunkMin, chunkMax,
+                         linearIndex)) {
+        // Sum the signals as doubles to preserve precision
+        outSignals[linearIndex] += static_cast<signal_t>(block[i].getSignal());
+        outErrors[linearIndex] +=
+            static_cast<signal_t>(block[i].getErrorSquared());
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        outNumEvents[linearIndex] += 1.0;
       }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
     }
   }
   // Done with the events list
   box->releaseEvents();
-
-  delete[] outCenter;
 }
 
 //----------------------------------------------------------------------------------------------
-/** Perform binning by iterating through every event and placing them in the
- *output workspace
+/** Bin all the boxes of the workspace in parallel. Each thread adds to its own
+ * copy of the output arrays, and the copies are added up at the end.
  *
  * @param ws :: MDEventWorkspace of the given type.
+ * @param numTiles :: number of threads, and of copies of the output arrays
+ *        (including the arrays of the output workspace)
  */
 template <typename MDE, size_t nd>
-void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
-  BoxController_sptr bc = ws->getBoxController();
-  // store exisiting write buffer size for the future
-  // uint64_t writeBufSize =bc->getDiskBuffer().getWriteBufferSize();
-  // and disable write buffer (if any) for input MD Events for this algorithm
-  // purposes;
-  // bc->setCacheParameters(1,0);
+void BinMD::binIntoTiles(typename MDEventWorkspace<MDE, nd>::sptr ws,
+                         const size_t numTiles) {
+  // The whole output workspace is the region of interest
+  std::vector<size_t> chunkMin(m_outD, 0);
+  std::vector<size_t> chunkMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    chunkMax[bd] = m_binDimensions[bd]->getNBins();
+  std::unique_ptr<MDImplicitFunction> function(
+      this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data()));
+
+  // Leaf-only; no depth limit; with the implicit function passed to it.
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+  g_log.debug() << "Found " << boxes.size()
+                << " boxes within the implicit function.\n";
+  if (prog)
+    prog->setNumSteps(boxes.size());
+
+  // The first thread adds to the output workspace, the others to their own
+  // copy of the signal, error and number of events arrays.
+  const size_t numBins = outWS->getNPoints();
+  std::vector<std::vector<signal_t>> tiles(numTiles - 1);
+
+  PRAGMA_OMP(parallel for schedule(dynamic) num_threads(int(numTiles)))
+  for (int64_t i = 0; i < int64_t(boxes.size()); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t thread = PARALLEL_THREAD_NUMBER;
+    signal_t *tileSignals = signals;
+    signal_t *tileErrors = errors;
+    signal_t *tileNumEvents = numEvents;
+    if (thread > 0) {
+      auto &tile = tiles[thread - 1];
+      if (tile.empty())
+        tile.resize(3 * numBins, 0.0);
+      tileSignals = tile.data();
+      tileErrors = tileSignals + numBins;
+      tileNumEvents = tileErrors + numBins;
+    }
 
-  // Cache some data to speed up accessing them a bit
-  indexMultiplier = new size_t[m_outD];
-  for (size_t d = 0; d < m_outD; d++) {
-    if (d > 0)
-      indexMultiplier[d] = outWS->getIndexMultiplier()[d - 1];
-    else
-      indexMultiplier[d] = 1;
-  }
-  signals = outWS->getSignalArray();
-  errors = outWS->getErrorSquaredArray();
-  numEvents = outWS->getNumEventsArray();
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (box && !box->getIsMasked())
+      this->binMDBox(box, chunkMin.data(), chunkMax.data(), tileSignals,
+                     tileErrors, tileNumEvents);
 
-  if (!m_accumulate) {
-    // Start with signal/error/numEvents at 0.0
-    outWS->setTo(0.0, 0.0, 0.0);
+    // Progress reporting
+    if (prog)
+      prog->report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Add up the copies
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < int64_t(numBins); ++i) {
+    for (const auto &tile : tiles) {
+      if (tile.empty())
+        continue;
+      signals[i] += tile[i];
+      errors[i] += tile[numBins + i];
+      numEvents[i] += tile[2 * numBins + i];
+    }
   }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the workspace in chunks along the first output dimension, running the
+ * chunks in parallel if requested. Each chunk looks at the boxes that overlap
+ * it only.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @param doParallel :: true to run the chunks in parallel
+ */
+template <typename MDE, size_t nd>
+void BinMD::binInChunks(typename MDEventWorkspace<MDE, nd>::sptr ws,
+                        const bool doParallel) {
+  BoxController_sptr bc = ws->getBoxController();
 
   // The dimension (in the output workspace) along which we chunk for parallel
   // processing
@@ -262,21 +382,11 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
                          (PARALLEL_GET_MAX_THREADS * 2));
   if (chunkNumBins < 1)
     chunkNumBins = 1;
-
-  // Do we actually do it in parallel?
-  bool doParallel = getProperty("Parallel");
-  // Not if file-backed!
-  if (bc->isFileBacked())
-    doParallel = false;
   if (!doParallel)
     chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
 
   // Total number of steps
   size_t progNumSteps = 0;
-  if (prog) {
-    prog->setNotifyStep(0.1);
-    prog->resetNumSteps(100, 0.00, 1.0);
-  }
 
   // Run the chunks in parallel. There is no overlap in the output workspace so
   // it is thread safe to write to it..
@@ -327,34 +437,355 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
       }
 
-      // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
-        // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
-
-        // Progress reporting
-        if (prog)
-          prog->report();
-        // For early cancelling of the loop
-        if (this->m_cancel)
-          break;
-      } // for each box in the vector
+      if (bc->isFileBacked()) {
+        this->binFileBackedBoxes<MDE, nd>(boxes, chunkMin.data(),
+                                          chunkMax.data());
+      } else {
+        // Go through every box for this chunk.
+        for (auto &boxe : boxes) {
+          MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+          // Perform the binning in this separate method.
+          if (box && !box->getIsMasked())
+            this->binMDBox(box, chunkMin.data(), chunkMax.data(), signals,
+                           errors, numEvents);
+
+          // Progress reporting
+          if (prog)
+            prog->report();
+          // For early cancelling of the loop
+          if (this->m_cancel)
+            break;
+        } // for each box in the vector
+      }
       PARALLEL_END_INTERUPT_REGION
     } // for each chunk in parallel
     PARALLEL_CHECK_INTERUPT_REGION
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the boxes of a file-backed workspace. The boxes that are entirely in
+ * one bin are binned first, from their cached totals. The events of the
+ * others are read from the file on a background thread, a few boxes ahead
+ * of the box being binned.
+ *
+ * @param boxes :: the boxes to bin, in the order of the file
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ */
+template <typename MDE, size_t nd>
+void BinMD::binFileBackedBoxes(const std::vector<API::IMDNode *> &boxes,
+                               const size_t *const chunkMin,
+                               const size_t *const chunkMax) {
+  std::vector<API::IMDNode *> toLoad;
+  for (auto &boxe : boxes) {
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+    if (box && !box->getIsMasked() &&
+        !this->binWholeMDBox(box, chunkMin, chunkMax, signals, errors,
+                             numEvents)) {
+      toLoad.push_back(box);
+      continue;
+    }
+    if (prog)
+      prog->report();
+  }
+
+  MDBoxPrefetcher prefetcher(toLoad);
+  while (auto boxe = prefetcher.next()) {
+    MDBox<MDE, nd> *box = static_cast<MDBox<MDE, nd> *>(boxe);
+    this->binMDBoxEvents(box, chunkMin, chunkMax, signals, errors, numEvents);
+    if (prog)
+      prog->report();
+    // For early cancelling of the loop
+    if (this->m_cancel)
+      break;
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Find the entry of the BinMDCache for this cut.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @return the entry, or nullptr if the cut cannot reuse an earlier one
+ */
+template <typename MDE, size_t nd>
+std::shared_ptr<BinMDCacheImpl::Entry>
+BinMD::getCacheEntry(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  Matrix<coord_t> matrix;
+  try {
+    matrix = m_transform->makeAffineMatrix();
+  } catch (std::runtime_error &) {
+    return nullptr;
+  }
+  // Adding or removing events changes the totals of the top box, or the number
+  // of boxes. Algorithms that move events replace the workspace in the ADS,
+  // which drops its entries from the cache.
+  const std::vector<double> fingerprint{
+      double(ws->getNPoints()), ws->getBox()->getSignal(),
+      ws->getBox()->getErrorSquared(),
+      double(ws->getBoxController()->getMaxId())};
+  std::vector<size_t> numBins(m_outD);
+  for (size_t d = 0; d < m_outD; d++)
+    numBins[d] = m_binDimensions[d]->getNBins();
+  return BinMDCache::Instance().getEntry(ws, fingerprint, matrix, numBins);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Make the histogram of the events of a box over all the output dimensions
+ * but the varying dimension of a cache entry.
+ *
+ * @param box :: pointer to the MDBox to bin
+ * @param dimension :: the varying output dimension, which has a single bin
+ * @param direction :: unit vector of the varying dimension in the input space
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ * @return the histogram, with the range of the positions along the direction
+ *         of the events in the bins
+ */
+template <typename MDE, size_t nd>
+BinMDCacheImpl::BoxHistogram
+BinMD::makeBoxHistogram(MDBox<MDE, nd> *box, const size_t dimension,
+                        const std::vector<double> &direction,
+                        const size_t *const chunkMin,
+                        const size_t *const chunkMax) {
+  BinMDCacheImpl::BoxHistogram histogram;
+  histogram.minPosition = std::numeric_limits<double>::infinity();
+  histogram.maxPosition = -std::numeric_limits<double>::infinity();
+  // Index in the histogram of each bin
+  std::unordered_map<size_t, size_t> slots;
+
+  coord_t inCenters[EVENT_BLOCK_SIZE * nd];
+  coord_t outCenters[EVENT_BLOCK_SIZE * nd];
+  const std::vector<MDE> &events = box->getConstEvents();
+  for (size_t begin = 0; begin < events.size(); begin += EVENT_BLOCK_SIZE) {
+    const size_t blockSize = std::min(EVENT_BLOCK_SIZE, events.size() - begin);
+    const MDE *block = events.data() + begin;
+    for (size_t i = 0; i < blockSize; ++i)
+      std::copy_n(block[i].getCenter(), nd, inCenters + i * nd);
+    m_transform->applyBlock(inCenters, outCenters, blockSize);
+
+    for (size_t i = 0; i < blockSize; ++i) {
+      coord_t *outCenter = outCenters + i * m_outD;
+      // Whatever the limits of the varying dimension, it has a single bin
+      outCenter[dimension] = 0;
+      size_t linearIndex = 0;
+      if (!getLinearIndex(outCenter, chunkMin, chunkMax, linearIndex))
+        continue;
+
+      double position = 0.;
+      for (size_t d = 0; d < nd; ++d)
+        position += direction[d] * block[i].getCenter(d);
+      histogram.minPosition = std::min(histogram.minPosition, position);
+      histogram.maxPosition = std::max(histogram.maxPosition, position);
+
+      const auto slot = slots.emplace(linearIndex, histogram.indexes.size());
+      if (slot.second) {
+        histogram.indexes.push_back(linearIndex);
+        histogram.values.resize(histogram.values.size() + 3, 0.0);
+      }
+      signal_t *values = histogram.values.data() + 3 * slot.first->second;
+      values[0] += static_cast<signal_t>(block[i].getSignal());
+      values[1] += static_cast<signal_t>(block[i].getErrorSquared());
+      values[2] += 1.0;
+    }
+  }
+  box->releaseEvents();
 
-    // Now the implicit function
-    if (implicitFunction) {
-      if (prog)
-        prog->report("Applying implicit function.");
-      signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-      outWS->applyImplicitFunction(implicitFunction, nan, nan);
+  histogram.indexes.shrink_to_fit();
+  histogram.values.shrink_to_fit();
+  return histogram;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the workspace reusing the histograms of the boxes in a cache entry.
+ * Boxes whose events are all within the limits of the varying dimension add
+ * their histogram, boxes whose events are all outside are skipped, and the
+ * events of the others are binned as usual. Missing histograms are made and
+ * added to the cache first.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @param entry :: the cache entry for this cut
+ * @param doParallel :: true to make the missing histograms in parallel
+ */
+template <typename MDE, size_t nd>
+void BinMD::binWithCache(typename MDEventWorkspace<MDE, nd>::sptr ws,
+                         BinMDCacheImpl::Entry &entry, const bool doParallel) {
+  // The whole output workspace is the region of interest
+  std::vector<size_t> chunkMin(m_outD, 0);
+  std::vector<size_t> chunkMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    chunkMax[bd] = m_binDimensions[bd]->getNBins();
+  std::unique_ptr<MDImplicitFunction> function(
+      this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data()));
+
+  // Leaf-only; no depth limit; with the implicit function passed to it.
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+  if (prog)
+    prog->setNumSteps(boxes.size());
+
+  // Find the histograms of the boxes in the cache
+  std::vector<MDBox<MDE, nd> *> mdBoxes(boxes.size(), nullptr);
+  std::vector<const BinMDCacheImpl::BoxHistogram *> histograms(boxes.size(),
+                                                               nullptr);
+  std::vector<size_t> missing;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (!box || box->getIsMasked())
+      continue;
+    mdBoxes[i] = box;
+    histograms[i] = entry.find(box->getID());
+    if (!histograms[i])
+      missing.push_back(i);
+  }
+
+  // Make the missing ones
+  const size_t dimension = entry.dimension();
+  const auto &direction = entry.direction();
+  std::vector<BinMDCacheImpl::BoxHistogram> made(missing.size());
+  PRAGMA_OMP(parallel for schedule(dynamic) if (doParallel))
+  for (int64_t j = 0; j < int64_t(missing.size()); ++j) {
+    PARALLEL_START_INTERUPT_REGION
+    made[j] = this->makeBoxHistogram(mdBoxes[missing[j]], dimension, direction,
+                                     chunkMin.data(), chunkMax.data());
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  auto &cache = BinMDCache::Instance();
+  for (size_t j = 0; j < missing.size(); ++j) {
+    const size_t i = missing[j];
+    histograms[i] = cache.addBoxHistogram(entry, mdBoxes[i]->getID(), made[j]);
+    if (!histograms[i])
+      histograms[i] = &made[j];
+  }
+
+  // The output coordinate along the varying dimension is
+  // scale * position + offset, where position is along the direction
+  const auto matrix = m_transform->makeAffineMatrix();
+  double scale = 0.;
+  for (size_t d = 0; d < nd; ++d)
+    scale += matrix[dimension][d] * direction[d];
+  const double offset = matrix[dimension][nd];
+
+  size_t numReused = 0;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (mdBoxes[i]) {
+      const auto &histogram = *histograms[i];
+      const double first = scale * histogram.minPosition + offset;
+      const double last = scale * histogram.maxPosition + offset;
+      const double lowest = std::min(first, last);
+      const double highest = std::max(first, last);
+      // Allow for the rounding of the transformation of the events
+      const double margin =
+          1e-5 * (std::abs(offset) +
+                  3. * std::abs(scale) *
+                      std::max(std::abs(histogram.minPosition),
+                               std::abs(histogram.maxPosition))) +
+          1e-6;
+      if (highest < -margin || lowest >= 1. + margin) {
+        // All the events are outside of the limits
+        ++numReused;
+      } else if (lowest >= margin && highest < 1. - margin) {
+        // All the events are within the limits
+        for (size_t slot = 0; slot < histogram.indexes.size(); ++slot) {
+          const size_t linearIndex = histogram.indexes[slot];
+          signals[linearIndex] += histogram.values[3 * slot];
+          errors[linearIndex] += histogram.values[3 * slot + 1];
+          numEvents[linearIndex] += histogram.values[3 * slot + 2];
+        }
+        ++numReused;
+      } else {
+        this->binMDBox(mdBoxes[i], chunkMin.data(), chunkMax.data(), signals,
+                       errors, numEvents);
+      }
     }
+    if (prog)
+      prog->report();
+    if (this->m_cancel)
+      break;
+  }
+  g_log.debug() << "Reused the histograms of " << numReused << " of "
+                << boxes.size() << " boxes.\n";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Perform binning by iterating through every event and placing them in the
+ *output workspace
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ */
+template <typename MDE, size_t nd>
+void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  BoxController_sptr bc = ws->getBoxController();
+  // store exisiting write buffer size for the future
+  // uint64_t writeBufSize =bc->getDiskBuffer().getWriteBufferSize();
+  // and disable write buffer (if any) for input MD Events for this algorithm
+  // purposes;
+  // bc->setCacheParameters(1,0);
+
+  // Cache some data to speed up accessing them a bit
+  indexMultiplier = new size_t[m_outD];
+  for (size_t d = 0; d < m_outD; d++) {
+    if (d > 0)
+      indexMultiplier[d] = outWS->getIndexMultiplier()[d - 1];
+    else
+      indexMultiplier[d] = 1;
+  }
+  signals = outWS->getSignalArray();
+  errors = outWS->getErrorSquaredArray();
+  numEvents = outWS->getNumEventsArray();
+
+  if (!m_accumulate) {
+    // Start with signal/error/numEvents at 0.0
+    outWS->setTo(0.0, 0.0, 0.0);
+  }
+
+  // Do we actually do it in parallel?
+  bool doParallel = getProperty("Parallel");
+  // Not if file-backed!
+  if (bc->isFileBacked())
+    doParallel = false;
+
+  if (prog) {
+    prog->setNotifyStep(0.1);
+    prog->resetNumSteps(100, 0.00, 1.0);
+  }
+
+  // When each thread can have its own copy of the output arrays, share out
+  // the boxes between the threads rather than the bins: each box is then only
+  // looked at once.
+  size_t numTiles = 1;
+  if (doParallel) {
+    const size_t tileMemory = 3 * outWS->getNPoints() * sizeof(signal_t);
+    // Only the threads left in the budget, e.g. when run in a pool task
+    const auto numThreads =
+        static_cast<size_t>(ThreadBudget::getNumThreadsForParallelRegion());
+    numTiles = std::min(numThreads,
+                        1 + MAX_TILE_MEMORY / std::max(tileMemory, size_t(1)));
+  }
+
+  // A cut that only moves the limits of an integrated dimension of an earlier
+  // cut can reuse the histograms of the boxes
+  std::shared_ptr<BinMDCacheImpl::Entry> cacheEntry;
+  if (getProperty("UseCache"))
+    cacheEntry = this->getCacheEntry<MDE, nd>(ws);
+
+  if (cacheEntry)
+    this->binWithCache<MDE, nd>(ws, *cacheEntry, doParallel);
+  else if (numTiles > 1)
+    this->binIntoTiles<MDE, nd>(ws, numTiles);
+  else
+    this->binInChunks<MDE, nd>(ws, doParallel);
+
+  // Now the implicit function
+  if (implicitFunction) {
+    if (prog)
+      prog->report("Applying implicit function.");
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    outWS->applyImplicitFunction(implicitFunction, nan, nan);
+  }
 
-    // return the size of the input workspace write buffer to its initial value
-    // bc->setCacheParameters(sizeof(MDE),writeBufSize);
+  // return the size of the input workspace write buffer to its initial value
+  // bc->setCacheParameters(sizeof(MDE),writeBufSize);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -0,0 +1,262 @@
+#include "MantidMDAlgorithms/BinMDCache.h"
+#include "MantidAPI/Workspace.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+
+#include <cmath>
+#include <ostream>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("BinMDCache");
+
+/// Maximum number of entries, including those without histograms
+const size_t MAX_ENTRIES = 16;
+
+/// Unit vector of a row of an affine matrix, without the translation
+std::vector<double> rowDirection(const Kernel::Matrix<coord_t> &matrix,
+                                 const size_t row) {
+  const size_t inD = matrix.numCols() - 1;
+  std::vector<double> direction(inD);
+  double norm = 0.;
+  for (size_t d = 0; d < inD; ++d) {
+    direction[d] = matrix[row][d];
+    norm += direction[d] * direction[d];
+  }
+  norm = std::sqrt(norm);
+  if (norm > 0.)
+    for (auto &x : direction)
+      x /= norm;
+  return direction;
+}
+} // namespace
+
+/// @return an estimate of the memory used by the histogram, in bytes
+size_t BinMDCacheImpl::BoxHistogram::memory() const {
+  // Including the node of the map of the entry
+  return sizeof(BoxHistogram) + 4 * sizeof(size_t) +
+         indexes.capacity() * sizeof(size_t) +
+         values.capacity() * sizeof(signal_t);
+}
+
+/** Find the histogram of a box.
+ * @param boxID :: ID of the box
+ * @return the histogram, or nullptr if the box has none yet
+ */
+const BinMDCacheImpl::BoxHistogram *
+BinMDCacheImpl::Entry::find(const size_t boxID) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_boxes.find(boxID);
+  return it == m_boxes.end() ? nullptr : &it->second;
+}
+
+/// Private constructor for singleton class
+BinMDCacheImpl::BinMDCacheImpl()
+    : m_beforeReplaceObserver(*this, &BinMDCacheImpl::handleBeforeReplace) {
+  int memoryMB = 0;
+  if (!Kernel::ConfigService::Instance().getValue("binmd.cache.memory",
+                                                  memoryMB) ||
+      memoryMB < 0) {
+    memoryMB = 512; // Default to 512 MB if not specified
+  }
+  m_memoryLimit = size_t(memoryMB) << 20;
+  API::AnalysisDataService::Instance().notificationCenter.addObserver(
+      m_beforeReplaceObserver);
+}
+
+/// Private destructor for singleton class
+BinMDCacheImpl::~BinMDCacheImpl() {
+  API::AnalysisDataService::Instance().notificationCenter.removeObserver(
+      m_beforeReplaceObserver);
+}
+
+/** Find the entry for a cut. If there is none, one is made for later cuts.
+ *
+ * @param workspace :: the workspace being binned
+ * @param fingerprint :: values identifying the contents of the workspace. An
+ *        entry for the workspace with another fingerprint is out of date.
+ * @param transform :: affine matrix from the workspace to the output bins
+ * @param numBins :: number of bins of each output dimension
+ * @return the entry, if the cut only differs from the last cut of the entry
+ *         by the limits of its varying dimension; nullptr otherwise.
+ */
+std::shared_ptr<BinMDCacheImpl::Entry> BinMDCacheImpl::getEntry(
+    const boost::shared_ptr<const API::Workspace> &workspace,
+    const std::vector<double> &fingerprint,
+    const Kernel::Matrix<coord_t> &transform,
+    const std::vector<size_t> &numBins) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const size_t outD = numBins.size();
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    auto &entry = **it;
+    const auto entryWorkspace = entry.m_workspace.lock();
+    if (!entryWorkspace) {
+      removeEntry(it++);
+      continue;
+    }
+    if (entryWorkspace != workspace) {
+      ++it;
+      continue;
+    }
+    if (entry.m_fingerprint != fingerprint) {
+      g_log.debug() << "The cached cuts of " << workspace->getName()
+                    << " are out of date.\n";
+      removeEntry(it++);
+      continue;
+    }
+    if (entry.m_numBins != numBins ||
+        entry.m_transform.numRows() != transform.numRows() ||
+        entry.m_transform.numCols() != transform.numCols()) {
+      ++it;
+      continue;
+    }
+
+    // The output dimensions whose transformation changed
+    std::vector<size_t> changed;
+    for (size_t row = 0; row < outD; ++row) {
+      for (size_t col = 0; col < transform.numCols(); ++col) {
+        if (entry.m_transform[row][col] != transform[row][col]) {
+          changed.push_back(row);
+          break;
+        }
+      }
+    }
+
+    if (changed.empty() && entry.m_dimension == outD) {
+      // The same cut again: there is nothing to reuse yet
+      m_entries.splice(m_entries.begin(), m_entries, it);
+      return nullptr;
+    }
+    bool matches = changed.empty();
+    if (changed.size() == 1 && numBins[changed[0]] == 1) {
+      const size_t dimension = changed[0];
+      const auto direction = rowDirection(transform, dimension);
+      if (entry.m_dimension == outD) {
+        // Now we know which dimension is moving
+        entry.m_dimension = dimension;
+        entry.m_direction = direction;
+        matches = true;
+      } else if (entry.m_dimension == dimension) {
+        // Only the limits may change, not the direction
+        matches = true;
+        for (size_t d = 0; d < direction.size(); ++d)
+          if (std::abs(direction[d] - entry.m_direction[d]) > 1e-6)
+            matches = false;
+      }
+    }
+    if (!matches) {
+      ++it;
+      continue;
+    }
+
+    entry.m_transform = transform;
+    // Most recently used first
+    m_entries.splice(m_entries.begin(), m_entries, it);
+    return m_entries.front();
+  }
+
+  // Remember the cut, for the next one
+  auto entry = std::make_shared<Entry>();
+  entry->m_workspace = workspace;
+  entry->m_fingerprint = fingerprint;
+  entry->m_transform = transform;
+  entry->m_numBins = numBins;
+  entry->m_dimension = outD;
+  m_entries.push_front(entry);
+  while (m_entries.size() > MAX_ENTRIES)
+    removeEntry(std::prev(m_entries.end()));
+  return nullptr;
+}
+
+/** Add the histogram of a box to an entry, if there is room for it. Least
+ * recently used entries are dropped to make room.
+ *
+ * @param entry :: an entry returned by getEntry()
+ * @param boxID :: ID of the box
+ * @param histogram :: the histogram. It is moved into the cache if added.
+ * @return the histogram in the cache, or nullptr if it was not added
+ */
+const BinMDCacheImpl::BoxHistogram *
+BinMDCacheImpl::addBoxHistogram(Entry &entry, const size_t boxID,
+                                BoxHistogram &histogram) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const size_t memory = histogram.memory();
+  auto it = m_entries.begin();
+  while (it != m_entries.end() && it->get() != &entry)
+    ++it;
+  // The entry was dropped, or the histogram can never fit
+  if (it == m_entries.end() || memory > m_memoryLimit)
+    return nullptr;
+
+  // Drop least recently used entries until the histogram fits
+  auto last = m_entries.end();
+  while (m_memory + memory > m_memoryLimit && last != m_entries.begin()) {
+    --last;
+    if (last->get() != &entry && (*last)->m_memory > 0)
+      removeEntry(last++);
+  }
+  if (m_memory + memory > m_memoryLimit)
+    return nullptr;
+
+  std::lock_guard<std::mutex> entryLock(entry.m_mutex);
+  auto inserted = entry.m_boxes.emplace(boxID, std::move(histogram));
+  if (inserted.second) {
+    entry.m_memory += memory;
+    m_memory += memory;
+  }
+  return &inserted.first->second;
+}
+
+/// Remove an entry and the memory of its histograms
+void BinMDCacheImpl::removeEntry(
+    std::list<std::shared_ptr<Entry>>::iterator it) {
+  m_memory -= (*it)->m_memory;
+  m_entries.erase(it);
+}
+
+/** Remove the entries of a workspace that is being replaced in the
+ * AnalysisDataService. Algorithms that modify a workspace in place store it
+ * again under its name, so this catches changes, such as moved events, that
+ * leave the fingerprint of the workspace as it was.
+ * @param pNf :: the notification, with the workspace being replaced
+ */
+void BinMDCacheImpl::handleBeforeReplace(
+    API::WorkspaceBeforeReplaceNotification_ptr pNf) {
+  const auto workspace = pNf->oldObject();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if ((*it)->m_workspace.lock() == workspace)
+      removeEntry(it++);
+    else
+      ++it;
+  }
+}
+
+/// Remove all the entries
+void BinMDCacheImpl::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_memory = 0;
+}
+
+/// @return the memory used by the histograms, in bytes
+size_t BinMDCacheImpl::getMemoryUsed() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memory;
+}
+
+/** Set the maximum memory of the histograms. Entries are dropped if needed.
+ * @param bytes :: the maximum, in bytes
+ */
+void BinMDCacheImpl::setMemoryLimit(const size_t bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_memoryLimit = bytes;
+  while (m_memory > m_memoryLimit && !m_entries.empty())
+    removeEntry(std::prev(m_entries.end()));
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
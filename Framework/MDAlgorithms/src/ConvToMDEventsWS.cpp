@@ -1,19 +1,35 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadBudget.h"
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include <algorithm>
+#include <exception>
+
 namespace Mantid {
 namespace MDAlgorithms {
-/**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+namespace {
+/// Number of events of the spectra that are converted in parallel before
+/// their events are added to the workspace
+const size_t EVENTS_PER_BATCH = 1 << 21;
+} // namespace
+
+/**function converts particular list of events of type T into MD space.
+ * @param workspaceIndex -- index of the spectrum to convert
+ * @param qConverter -- the transformation to use. It keeps the coordinates of
+ *the detector, so threads converting at the same time need their own copies
+ * @param converted -- the buffers to add the converted events to */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+void ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                        MDTransfInterface &qConverter,
+                                        ConvertedEvents &converted) const {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
   size_t numEvents = el.getNumberEvents();
   if (numEvents == 0)
-    return 0;
+    return;
 
   // create local unit conversion class
   UnitsConversionHelper localUnitConv(m_UnitConversion);
@@ -24,16 +40,18 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
-    return 0; // skip if any y outsize of the range of interest;
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
+    return; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
   //
   // allocate temporary buffers for MD Events data
   // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
+  std::vector<coord_t> &allCoord = converted.coord;
+  std::vector<float> &sig_err = converted.sigErr; // array for signal and error.
+  std::vector<uint16_t> &run_index =
+      converted.runIndex; // Buffer for run index for each event
+  std::vector<uint32_t> &det_ids =
+      converted.detIDs; // Buffer of det Id-s for each event
 
   allCoord.reserve(this->m_NDims * numEvents);
   sig_err.reserve(2 * numEvents);
@@ -51,7 +69,7 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
     double val = localUnitConv.convertUnits(it->tof());
     double signal = it->weight();
     double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+    if (!qConverter.calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
     sig_err.push_back(static_cast<float>(signal));
@@ -60,33 +78,69 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
     det_ids.push_back(detID);
     allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
   }
-
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
-  return n_added_events;
 }
 
-/** The method runs conversion for a single event list, corresponding to a
- * particular workspace index */
-size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+/** The method converts the events of a spectrum into MD space */
+void ConvToMDEventsWS::convertSpectrum(size_t workspaceIndex,
+                                       MDTransfInterface &qConverter,
+                                       ConvertedEvents &converted) const {
 
   switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
   case Mantid::API::TOF:
-    return this->convertEventList<Mantid::Types::Event::TofEvent>(
-        workspaceIndex);
+    this->convertEventList<Mantid::Types::Event::TofEvent>(
+        workspaceIndex, qConverter, converted);
+    break;
   case Mantid::API::WEIGHTED:
-    return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
+    this->convertEventList<Mantid::DataObjects::WeightedEvent>(
+        workspaceIndex, qConverter, converted);
+    break;
   case Mantid::API::WEIGHTED_NOTIME:
-    return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
+    this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
+        workspaceIndex, qConverter, converted);
+    break;
   default:
     throw std::runtime_error("EventList had an unexpected data type!");
   }
 }
 
+/** Add converted events to the MD workspace and release their buffers
+ * @returns -- number of events added to the workspace. */
+size_t ConvToMDEventsWS::addEvents(ConvertedEvents &converted) {
+  size_t n_added_events = converted.runIndex.size();
+  if (n_added_events > 0)
+    m_OutWSWrapper->addMDData(converted.sigErr, converted.runIndex,
+                              converted.detIDs, converted.coord,
+                              n_added_events);
+  converted = ConvertedEvents();
+  return n_added_events;
+}
+
+/** Move converted events to the end of other converted events
+ * @returns -- number of events moved. */
+size_t ConvToMDEventsWS::appendEvents(ConvertedEvents &from,
+                                      ConvertedEvents &to) {
+  if (to.runIndex.empty()) {
+    std::swap(from, to);
+    return to.runIndex.size();
+  }
+  to.coord.insert(to.coord.end(), from.coord.cbegin(), from.coord.cend());
+  to.sigErr.insert(to.sigErr.end(), from.sigErr.cbegin(), from.sigErr.cend());
+  to.runIndex.insert(to.runIndex.end(), from.runIndex.cbegin(),
+                     from.runIndex.cend());
+  to.detIDs.insert(to.detIDs.end(), from.detIDs.cbegin(), from.detIDs.cend());
+  const size_t numMoved = from.runIndex.size();
+  from = ConvertedEvents();
+  return numMoved;
+}
+
+/** The method runs conversion for a single event list, corresponding to a
+ * particular workspace index */
+size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+  ConvertedEvents converted;
+  this->convertSpectrum(workspaceIndex, *m_QConverter, converted);
+  return this->addEvents(converted);
+}
+
 /** method sets up all internal variables necessary to convert from Event
 Workspace to MDEvent workspace
 @param WSD         -- the class describing the target MD workspace, sorurce
@@ -149,32 +203,79 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
     return;
 
+  // The transformations keep the coordinates of the detector being
+  // converted, so each thread converts with its own copy
+  std::vector<MDTransf_sptr> qConverters{m_QConverter};
+  if (runMultithreaded) {
+    // Only the threads left in the budget, e.g. when run in a pool task
+    const int budget = Kernel::ThreadBudget::getNumThreadsForParallelRegion();
+    const int nConverters = nThreads > 0 ? std::min(nThreads, budget) : budget;
+    for (int i = 1; i < nConverters; ++i)
+      qConverters.emplace_back(m_QConverter->clone());
+  }
+  const int nConverters = static_cast<int>(qConverters.size());
+
   size_t eventsAdded = 0;
-  for (size_t wi = 0; wi < nValidSpectra; wi++) {
-
-    size_t nConverted = this->conversionChunk(wi);
-    eventsAdded += nConverted;
-    nEventsInWS += nConverted;
-    // Keep a running total of how many events we've added
-    if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
-      if (runMultithreaded) {
-        // Now do all the splitting tasks
-        m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
-        if (ts->size() > 0)
-          tp.joinAll();
-      } else {
-        m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(
-            nullptr); // it is done this way as it is possible trying to do
-                      // single
-                      // threaded split more efficiently
+  std::vector<ConvertedEvents> converted;
+  for (size_t batchStart = 0; batchStart < nValidSpectra;) {
+    // Convert a batch of spectra in parallel...
+    size_t batchEnd = batchStart;
+    size_t batchEvents = 0;
+    while (batchEnd < nValidSpectra && batchEvents < EVENTS_PER_BATCH)
+      batchEvents += m_EventWS->getSpectrum(batchEnd++).getNumberEvents();
+    converted.resize(batchEnd - batchStart);
+
+    std::exception_ptr conversionError;
+    PRAGMA_OMP(parallel for schedule(dynamic) num_threads(nConverters) \
+               if (nConverters > 1))
+    for (int i = static_cast<int>(batchStart); i < static_cast<int>(batchEnd);
+         ++i) {
+      try {
+        this->convertSpectrum(i, *qConverters[PARALLEL_THREAD_NUMBER],
+                              converted[i - batchStart]);
+      } catch (...) {
+        PARALLEL_CRITICAL(ConvToMDEventsWS_error) {
+          if (!conversionError)
+            conversionError = std::current_exception();
+        }
+      }
+    }
+    if (conversionError)
+      std::rethrow_exception(conversionError);
+
+    // ...and add their events in the order of the spectra, so that the boxes
+    // are split just as when converting one spectrum at a time. Whether to
+    // split depends only on the number of events, so the events of the
+    // spectra before a split are added together.
+    ConvertedEvents pending;
+    for (size_t wi = batchStart; wi < batchEnd; wi++) {
+      size_t nConverted = appendEvents(converted[wi - batchStart], pending);
+      eventsAdded += nConverted;
+      nEventsInWS += nConverted;
+      // Keep a running total of how many events we've added
+      if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
+        this->addEvents(pending);
+        if (runMultithreaded) {
+          // Now do all the splitting tasks
+          m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
+          if (ts->size() > 0)
+            tp.joinAll();
+        } else {
+          m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(
+              nullptr); // it is done this way as it is possible trying to do
+                        // single
+                        // threaded split more efficiently
+        }
+        // Count the new # of boxes.
+        lastNumBoxes = m_OutWSWrapper->pWorkspace()
+                           ->getBoxController()
+                           ->getTotalNumMDBoxes();
+        eventsAdded = 0;
+        pProgress->report(wi);
       }
-      // Count the new # of boxes.
-      lastNumBoxes = m_OutWSWrapper->pWorkspace()
-                         ->getBoxController()
-                         ->getTotalNumMDBoxes();
-      eventsAdded = 0;
-      pProgress->report(wi);
     }
+    this->addEvents(pending);
+    batchStart = batchEnd;
   }
   // Do a final splitting of everything
   if (runMultithreaded) {
@@ -565,6 +565,8 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
       // Set these values in the diskMRU
       bc->getFileIO()->setWriteBufferSize(cacheMemory);
+      // Boxes read ahead of their use may take as much
+      bc->getFileIO()->setReadAheadBufferSize(cacheMemory);
 
       g_log.information() << "Setting a DiskBuffer cache size of " << mb
                           << " MB, or " << cacheMemory << " events.\n";
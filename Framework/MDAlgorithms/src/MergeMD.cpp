@@ -7,6 +7,9 @@
 #include "MantidKernel/Strings.h"
 #include "MantidAPI/WorkspaceGroup.h"
 
+#include <algorithm>
+#include <iterator>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
@@ -170,6 +173,23 @@ void MergeMD::doPlus(typename MDEventWorkspace<MDE, nd>::sptr ws2) {
   MDBoxBase<MDE, nd> *box1 = ws1->getBox();
   MDBoxBase<MDE, nd> *box2 = ws2->getBox();
 
+  // The bulk insertion does no bounds checking, so leave out the events
+  // outside of WS1 here, as MDBoxBase::addEvents() does.
+  coord_t minimum[nd];
+  coord_t maximum[nd];
+  for (size_t d = 0; d < nd; d++) {
+    minimum[d] = box1->getExtents(d).getMin();
+    maximum[d] = box1->getExtents(d).getMax();
+  }
+  auto isInside = [&minimum, &maximum](const MDE &event) {
+    for (size_t d = 0; d < nd; d++) {
+      const coord_t x = event.getCenter(d);
+      if (x < minimum[d] || x >= maximum[d])
+        return false;
+    }
+    return true;
+  };
+
   // How many events you started with
   size_t initial_numEvents = ws1->getNPoints();
 
@@ -177,32 +197,35 @@ void MergeMD::doPlus(typename MDEventWorkspace<MDE, nd>::sptr ws2) {
   // workspace
   std::vector<API::IMDNode *> boxes;
   box2->getBoxes(boxes, 1000, true);
-  int numBoxes = int(boxes.size());
+  size_t numBoxes = boxes.size();
 
   bool fileBasedSource(false);
   if (ws2->isFileBacked())
     fileBasedSource = true;
 
-  // Add the boxes in parallel. They should be spread out enough on each
-  // core to avoid stepping on each other.
-  // cppcheck-suppress syntaxError
-    PRAGMA_OMP( parallel for if (!ws2->isFileBacked()) )
-    for (int i = 0; i < numBoxes; i++) {
-      PARALLEL_START_INTERUPT_REGION
-      MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
-      if (box && !box->getIsMasked()) {
-        // Copy the events from WS2 and add them into WS1
-        const std::vector<MDE> &events = box->getConstEvents();
-        // Add events, with bounds checking
-        box1->addEvents(events);
-        if (fileBasedSource)
-          box->clear();
-        else
-          box->releaseEvents();
-      }
-      PARALLEL_END_INTERUPT_REGION
+  // Gather the events of the boxes and add them in large blocks. Each block
+  // is added in parallel, the threads sharing the top-level boxes of WS1.
+  const size_t eventsPerBlock = 1 << 22;
+  std::vector<MDE> events;
+  for (size_t i = 0; i < numBoxes; i++) {
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (box && !box->getIsMasked()) {
+      // Copy the events from WS2
+      const std::vector<MDE> &boxEvents = box->getConstEvents();
+      std::copy_if(boxEvents.cbegin(), boxEvents.cend(),
+                   std::back_inserter(events), isInside);
+      if (fileBasedSource)
+        box->clear();
+      else
+        box->releaseEvents();
+    }
+    if (events.size() >= eventsPerBlock || (i + 1 == numBoxes)) {
+      interruption_point();
+      // Add events to WS1, which spans all the input workspaces
+      ws1->addEventsInParallel(events);
+      events.clear();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
+  }
 
     // Progress * prog2 = new Progress(this, 0.4, 0.9, 100);
     Progress *prog2 = nullptr;
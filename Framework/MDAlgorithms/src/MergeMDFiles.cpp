@@ -54,7 +54,8 @@ void MergeMDFiles::init() {
       "If not, it will be created in memory.");
 
   declareProperty("Parallel", false,
-                  "Run the loading tasks in parallel.\n"
+                  "Merge several boxes at once when the output workspace is "
+                  "in memory.\n"
                   "This can be faster but might use more memory.");
 
   declareProperty(make_unique<WorkspaceProperty<IMDEventWorkspace>>(
@@ -149,6 +150,9 @@ void MergeMDFiles::loadBoxData() {
 
 /** Task that loads all of the events from corresponded boxes of all files
   * that is being merged into a particular box in the output workspace.
+  * The blocks of events are read one file at a time, and converted to
+  * events without holding the file mutex, so that several boxes can be
+  * merged in parallel.
 */
 
 uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
@@ -156,30 +160,134 @@ uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
   /// (from cloning)
   TargetBox->clear();
 
+  const size_t ID = TargetBox->getID();
+  // The events of all the files, one file after the other
+  std::vector<coord_t> boxData;
+  std::vector<coord_t> fileData;
   uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
-
   for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
+    const auto &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+    const auto numFileEvents = static_cast<size_t>(eventIndex[2 * ID + 1]);
+    if (numFileEvents == 0)
+      continue;
+    {
+      // The NeXus library may only be used by one thread at a time
+      std::lock_guard<std::mutex> lock(m_fileMutex);
+      m_EventLoader[iw]->loadBlock(fileData, eventIndex[2 * ID + 0],
+                                   numFileEvents);
+    }
+    boxData.insert(boxData.end(), fileData.begin(), fileData.end());
+    nBoxEvents += numFileEvents;
   }
 
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
+  if (nBoxEvents > 0)
+    TargetBox->setEventsData(boxData);
+  return nBoxEvents;
+}
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
-      continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+//----------------------------------------------------------------------------------------------
+/** Merge the events of the boxes of all the files into the boxes of an
+ * output workspace in memory.
+ *
+ * @param boxes :: the boxes of the output workspace
+ * @param parallel :: true to merge several boxes at once
+ */
+void MergeMDFiles::mergeBoxesInMemory(const std::vector<API::IMDNode *> &boxes,
+                                      const bool parallel) {
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t ib = 0; ib < static_cast<int64_t>(boxes.size()); ib++) {
+    PARALLEL_START_INTERUPT_REGION
+    if (boxes[ib]->isBox())
+      this->loadEventsFromSubBoxes(boxes[ib]);
+    m_progress->report("Loading and merging box data");
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
+}
 
-  return nBoxEvents;
+//----------------------------------------------------------------------------------------------
+/** Merge the events of the boxes of all the files into the file of a
+ * file-backed output workspace, without converting them to events.
+ *
+ * The boxes are merged in batches whose events fit in the write buffer of the
+ * output. The blocks of the boxes of a batch are read from each file in turn,
+ * in the order they are in the file, then written one after the other at the
+ * positions of the boxes in the output file, in a single sequential pass.
+ *
+ * @param boxes :: the boxes of the output workspace, in the order of their
+ *        positions in the output file
+ */
+void MergeMDFiles::mergeBoxesToFile(const std::vector<API::IMDNode *> &boxes) {
+  auto fileIO = m_OutIWS->getBoxController()->getFileIO();
+  const uint64_t maxBatchEvents = fileIO->getWriteBufferSize();
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+  const size_t numFiles = m_EventLoader.size();
+
+  size_t begin = 0;
+  while (begin < boxes.size()) {
+    // Find the boxes of the batch; at least one, whatever its size
+    std::vector<API::IMDNode *> batch;
+    uint64_t batchEvents = 0;
+    size_t end = begin;
+    for (; end < boxes.size(); end++) {
+      if (!boxes[end]->isBox())
+        continue;
+      const uint64_t nEvents = targetEventIndexes[2 * boxes[end]->getID() + 1];
+      if (!batch.empty() && batchEvents + nEvents > maxBatchEvents)
+        break;
+      batch.push_back(boxes[end]);
+      batchEvents += nEvents;
+    }
+
+    // Read the blocks, one file at a time
+    std::vector<std::vector<coord_t>> blocks(batch.size() * numFiles);
+    for (size_t iw = 0; iw < numFiles; iw++) {
+      const auto &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+      for (size_t ib = 0; ib < batch.size(); ib++) {
+        const size_t ID = batch[ib]->getID();
+        const auto numFileEvents = static_cast<size_t>(eventIndex[2 * ID + 1]);
+        if (numFileEvents > 0)
+          m_EventLoader[iw]->loadBlock(blocks[ib * numFiles + iw],
+                                       eventIndex[2 * ID + 0], numFileEvents);
+      }
+    }
+
+    // Write them, and set the totals of the boxes as if they were saved
+    for (size_t ib = 0; ib < batch.size(); ib++) {
+      auto box = batch[ib];
+      const size_t ID = box->getID();
+      const uint64_t boxStart = targetEventIndexes[2 * ID];
+      const uint64_t nBoxEvents = targetEventIndexes[2 * ID + 1];
+      uint64_t position = boxStart;
+      double signal = 0.;
+      double errorSquared = 0.;
+      for (size_t iw = 0; iw < numFiles; iw++) {
+        auto &block = blocks[ib * numFiles + iw];
+        if (block.empty())
+          continue;
+        const auto &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+        const uint64_t numFileEvents = eventIndex[2 * ID + 1];
+        const size_t numColumns = block.size() / numFileEvents;
+        // The signal and squared error are the first columns of the events
+        for (size_t i = 0; i < block.size(); i += numColumns) {
+          signal += block[i];
+          errorSquared += block[i + 1];
+        }
+        fileIO->saveBlock(block, position);
+        position += numFileEvents;
+        std::vector<coord_t>().swap(block);
+      }
+      if (nBoxEvents > 0) {
+        box->setFileBacked(boxStart, nBoxEvents, true);
+        box->setSignal(static_cast<signal_t>(signal));
+        box->setErrorSquared(static_cast<signal_t>(errorSquared));
+      }
+      m_progress->report("Loading and merging box data");
+    }
+    m_progress->reportIncrement(end - begin - batch.size());
+    begin = end;
+  }
+  fileIO->flushData();
 }
 
 //----------------------------------------------------------------------------------------------
@@ -196,9 +304,6 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
-
   // Fix the box controller settings in the output workspace so that it splits
   // normally
   BoxController_sptr bc = ws->getBoxController();
@@ -237,62 +342,15 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   // For tracking progress
   // uint64_t m_totalEventsInTasks = 0;
 
-  // Prepare thread pool
   CPUTimer overallTime;
 
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
-  Kernel::DiskBuffer *DiskBuf(nullptr);
-  if (m_fileBasedTargetWS) {
-    DiskBuf = bc->getFileIO();
-  }
-
   this->m_totalLoaded = 0;
-  std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  if (m_fileBasedTargetWS)
+    this->mergeBoxesToFile(boxes);
+  else
+    this->mergeBoxesInMemory(boxes, this->getProperty("Parallel"));
 
-  for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
-    }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    m_progress->reportIncrement(ib, "Loading and merging box data");
-  }
-  if (DiskBuf) {
-    DiskBuf->flushCache();
-    bc->getFileIO()->flushData();
-  }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
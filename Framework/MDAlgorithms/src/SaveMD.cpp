@@ -76,6 +76,15 @@ void SaveMD::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("Compress", false,
+                  "For an MDEventWorkspace that is not file-backed: compress "
+                  "the events in the file.\n"
+                  "The file is smaller and faster to read from a slow disk, "
+                  "but takes more time to write.");
+  setPropertySettings(
+      "Compress",
+      make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -159,8 +168,9 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = boost::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto NeXusSaver = new DataObjects::BoxControllerNeXusIO(bc.get());
+    NeXusSaver->setCompressed(getProperty("Compress"));
+    auto Saver = boost::shared_ptr<API::IBoxControllerIO>(NeXusSaver);
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
     if (makeFileBackend) {
       // store saver with box controller
@@ -64,6 +64,15 @@ void SaveMD2::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("Compress", false,
+                  "For an MDEventWorkspace that is not file-backed: compress "
+                  "the events in the file.\n"
+                  "The file is smaller and faster to read from a slow disk, "
+                  "but takes more time to write.");
+  setPropertySettings(
+      "Compress",
+      make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -210,6 +219,7 @@ void SaveMD2::exec() {
                                 getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked",
                                 getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("Compress", getProperty("Compress"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
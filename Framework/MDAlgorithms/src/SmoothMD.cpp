@@ -1,9 +1,7 @@
 #include "MantidMDAlgorithms/SmoothMD.h"
-#include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
-#include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/Progress.h"
-#include "MantidDataObjects/MDHistoWorkspaceIterator.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidKernel/ArrayBoundedValidator.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -16,6 +14,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <numeric>
@@ -60,7 +59,73 @@ SmoothFunctionMap makeFunctionMap(Mantid::MDAlgorithms::SmoothMD *instance) {
       {"Gaussian", boost::bind(&Mantid::MDAlgorithms::SmoothMD::gaussianSmooth,
                                instance, _1, _2, _3)}};
 }
+
+/// How a bin takes part in the smoothing
+enum class BinStatus : char {
+  /// Smoothed, and used to smooth its neighbours
+  Used,
+  /// Masked: left as it is
+  Masked,
+  /// Zero in the weighting workspace: set to NaN
+  Unmeasured
+};
+
+/**
+ * Find how each bin of a workspace takes part in the smoothing
+ * @param toSmooth : Workspace to smooth
+ * @param weightingWS : Weighting workspace (optional)
+ * @return the status of each bin
+ */
+std::vector<BinStatus>
+getBinStatus(const IMDHistoWorkspace &toSmooth,
+             const OptionalIMDHistoWorkspace_const_sptr &weightingWS) {
+  const size_t nPoints = toSmooth.getNPoints();
+  std::vector<BinStatus> status(nPoints, BinStatus::Used);
+  if (weightingWS) {
+    const double *weights = (*weightingWS)->getSignalArray();
+    for (size_t i = 0; i < nPoints; ++i)
+      if (weights[i] == 0)
+        status[i] = BinStatus::Unmeasured;
+  }
+  if (auto histoWS = dynamic_cast<const MDHistoWorkspace *>(&toSmooth)) {
+    for (size_t i = 0; i < nPoints; ++i)
+      if (histoWS->getIsMaskedAt(i))
+        status[i] = BinStatus::Masked;
+  }
+  return status;
+}
+
+/**
+ * Convolve the values of a workspace with a 1D kernel along one of its
+ * dimensions. The elements of the kernel beyond the edges of the workspace
+ * are left out.
+ * @param in : the values, in the order of the linear indexes of the workspace
+ * @param out : the convolved values
+ * @param kernel : kernel of odd size, centred on each bin
+ * @param stride : difference of the linear indexes of neighbouring bins along
+ * the dimension
+ * @param nBins : number of bins of the dimension
+ */
+void convolveDimension(const std::vector<double> &in, std::vector<double> &out,
+                       const KernelVector &kernel, const size_t stride,
+                       const size_t nBins) {
+  const auto halfWidth = static_cast<int64_t>(kernel.size() / 2);
+  const auto step = static_cast<int64_t>(stride);
+  const auto lastBin = static_cast<int64_t>(nBins) - 1;
+  const auto nPoints = static_cast<int64_t>(in.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < nPoints; ++i) {
+    // Position of the bin along the dimension
+    const int64_t position = (i / step) % (lastBin + 1);
+    const int64_t first = std::max(-halfWidth, -position);
+    const int64_t last = std::min(halfWidth, lastBin - position);
+    double sum = 0.;
+    for (int64_t offset = first; offset <= last; ++offset)
+      sum += kernel[offset + halfWidth] * in[i + offset * step];
+    out[i] = sum;
+  }
 }
+} // namespace
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -165,6 +230,10 @@ const std::string SmoothMD::summary() const {
 /**
  * Hat function smoothing. All weights even. Hat function boundaries beyond
  * width.
+ *
+ * The sum over the hat is separable: the signals, squared errors and number
+ * of the bins used are summed along each dimension in turn, which takes
+ * a time proportional to the sum of the widths rather than their product.
  * @param toSmooth : Workspace to smooth
  * @param widthVector : Width vector
  * @param weightingWS : Weighting workspace (optional)
@@ -175,89 +244,56 @@ SmoothMD::hatSmooth(IMDHistoWorkspace_const_sptr toSmooth,
                     const WidthVector &widthVector,
                     OptionalIMDHistoWorkspace_const_sptr weightingWS) {
 
-  const bool useWeights = weightingWS.is_initialized();
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
+  const size_t nPoints = toSmooth->getNPoints();
+  const size_t nd = toSmooth->getNumDims();
+  Progress progress(this, 0.0, 1.0, 3 * nd + 2);
   // Create the output workspace.
   IMDHistoWorkspace_sptr outWS(toSmooth->clone());
-  progress.reportIncrement(
-      size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  const int nThreads = Mantid::API::FrameworkManager::Instance()
-                           .getNumOMPThreads(); // NThreads to Request
-
-  auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-    PARALLEL_START_INTERUPT_REGION
-    auto iterator =
-        dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
+  const auto status = getBinStatus(*toSmooth, weightingWS);
+  progress.report();
+
+  const signal_t *signal = toSmooth->getSignalArray();
+  const signal_t *errorSquared = toSmooth->getErrorSquaredArray();
+  std::vector<double> sumSignal(nPoints);
+  std::vector<double> sumErrorSquared(nPoints);
+  std::vector<double> count(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    const bool used = status[i] == BinStatus::Used;
+    sumSignal[i] = used ? signal[i] : 0.;
+    sumErrorSquared[i] = used ? errorSquared[i] : 0.;
+    count[i] = used ? 1. : 0.;
+  }
 
-    if (!iterator) {
-      throw std::logic_error(
-          "Failed to cast IMDIterator to MDHistoWorkspaceIterator");
+  std::vector<double> buffer(nPoints);
+  size_t stride = 1;
+  for (size_t d = 0; d < nd; ++d) {
+    const size_t nBins = toSmooth->getDimension(d)->getNBins();
+    // We've already checked in the validator that the widths are odd
+    // integer values
+    const KernelVector hat(static_cast<size_t>(widthVector[d]), 1.0);
+    for (auto sums : {&sumSignal, &sumErrorSquared, &count}) {
+      interruption_point();
+      convolveDimension(*sums, buffer, hat, stride, nBins);
+      sums->swap(buffer);
+      progress.report();
     }
+    stride *= nBins;
+  }
 
-    do {
-      // Gets all vertex-touching neighbours
-      size_t iteratorIndex = iterator->getLinearIndex();
-
-      if (useWeights) {
-
-        // Check that we could measure here.
-        if ((*weightingWS)->getSignalAt(iteratorIndex) == 0) {
-
-          outWS->setSignalAt(iteratorIndex,
-                             std::numeric_limits<double>::quiet_NaN());
-          outWS->setErrorSquaredAt(iteratorIndex,
-                                   std::numeric_limits<double>::quiet_NaN());
-
-          continue; // Skip we couldn't measure here.
-        }
-      }
-
-      // Explicitly cast the doubles to int
-      // We've already checked in the validator that the doubles we have are odd
-      // integer values and well below max int
-      std::vector<int> widthVectorInt;
-      widthVectorInt.reserve(widthVector.size());
-      for (auto const widthEntry : widthVector) {
-        widthVectorInt.push_back(static_cast<int>(widthEntry));
-      }
-
-      std::vector<size_t> neighbourIndexes =
-          iterator->findNeighbourIndexesByWidth(widthVectorInt);
-
-      size_t nNeighbours = neighbourIndexes.size();
-      double sumSignal = iterator->getSignal();
-      double sumSqError = iterator->getError();
-      for (auto neighbourIndex : neighbourIndexes) {
-        if (useWeights) {
-          if ((*weightingWS)->getSignalAt(neighbourIndex) == 0) {
-            // Nothing measured here. We cannot use that neighbouring point.
-            nNeighbours -= 1;
-            continue;
-          }
-        }
-        sumSignal += toSmooth->getSignalAt(neighbourIndex);
-        double error = toSmooth->getErrorAt(neighbourIndex);
-        sumSqError += (error * error);
-      }
-
+  signal_t *outSignal = outWS->getSignalArray();
+  signal_t *outErrorSquared = outWS->getErrorSquaredArray();
+  for (size_t i = 0; i < nPoints; ++i) {
+    if (status[i] == BinStatus::Used) {
       // Calculate the mean
-      outWS->setSignalAt(iteratorIndex, sumSignal / double(nNeighbours + 1));
+      outSignal[i] = sumSignal[i] / count[i];
       // Calculate the sample variance
-      outWS->setErrorSquaredAt(iteratorIndex,
-                               sumSqError / double(nNeighbours + 1));
-
-      progress.report();
-
-    } while (iterator->next());
-    PARALLEL_END_INTERUPT_REGION
+      outErrorSquared[i] = sumErrorSquared[i] / count[i];
+    } else if (status[i] == BinStatus::Unmeasured) {
+      outSignal[i] = std::numeric_limits<double>::quiet_NaN();
+      outErrorSquared[i] = std::numeric_limits<double>::quiet_NaN();
+    }
   }
-  PARALLEL_CHECK_INTERUPT_REGION
+  progress.report();
 
   return outWS;
 }
@@ -268,6 +304,9 @@ SmoothMD::hatSmooth(IMDHistoWorkspace_const_sptr toSmooth,
  * of a multidimensional Gaussian kernel with the workspace to be carried out by
  * a convolution with a 1D Gaussian kernel in each dimension. This
  * reduces the number of calculations overall.
+ *
+ * The kernel is renormalised over the bins used at each position, so the
+ * bins beyond the edges of the workspace, masked or not measured are left out.
  * @param toSmooth : Workspace to smooth
  * @param widthVector : Width vector
  * @param weightingWS : Weighting workspace (optional)
@@ -278,106 +317,64 @@ SmoothMD::gaussianSmooth(IMDHistoWorkspace_const_sptr toSmooth,
                          const WidthVector &widthVector,
                          OptionalIMDHistoWorkspace_const_sptr weightingWS) {
 
-  const bool useWeights = weightingWS.is_initialized();
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
+  const size_t nPoints = toSmooth->getNPoints();
+  const size_t nd = toSmooth->getNumDims();
+  Progress progress(this, 0.0, 1.0, 3 * nd + 1);
   // Create the output workspace
   IMDHistoWorkspace_sptr outWS(toSmooth->clone().release());
-  // Create a temporary workspace
-  IMDHistoWorkspace_sptr tempWS(toSmooth->clone().release());
-  progress.reportIncrement(
-      size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  // Create a kernel for each dimension and
-  std::vector<KernelVector> gaussian_kernels;
-  gaussian_kernels.reserve(widthVector.size());
-  for (const auto width : widthVector) {
-    gaussian_kernels.push_back(gaussianKernel(width));
-  }
-
-  const int nThreads = Mantid::API::FrameworkManager::Instance()
-                           .getNumOMPThreads(); // NThreads to Request
-
-  auto read_ws = outWS;
-  auto write_ws = tempWS;
-  for (size_t dimension_number = 0; dimension_number < widthVector.size();
-       ++dimension_number) {
-
-    auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-    // Alternately write to each workspace
-    if (dimension_number % 2 == 0) {
-      read_ws = outWS;
-      write_ws = tempWS;
-    } else {
-      read_ws = tempWS;
-      write_ws = outWS;
-    }
-
-    PARALLEL_FOR_NO_WSP_CHECK()
-    for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-      PARALLEL_START_INTERUPT_REGION
-      auto iterator =
-          dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-      if (!iterator) {
-        throw std::logic_error(
-            "Failed to cast IMDIterator to MDHistoWorkspaceIterator");
-      }
-
-      do {
-
-        // Gets linear index at current position
-        size_t iteratorIndex = iterator->getLinearIndex();
-
-        if (useWeights) {
-
-          // Check that we could measure here.
-          if ((*weightingWS)->getSignalAt(iteratorIndex) == 0) {
-
-            write_ws->setSignalAt(iteratorIndex,
-                                  std::numeric_limits<double>::quiet_NaN());
-            write_ws->setErrorSquaredAt(
-                iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-
-            continue; // Skip we couldn't measure here.
-          }
-        }
-
-        std::pair<std::vector<size_t>, std::vector<bool>> indexesAndValidity =
-            iterator->findNeighbourIndexesByWidth1D(
-                static_cast<int>(gaussian_kernels[dimension_number].size()),
-                static_cast<int>(dimension_number));
-        std::vector<size_t> neighbourIndexes = std::get<0>(indexesAndValidity);
-        std::vector<bool> indexValidity = std::get<1>(indexesAndValidity);
-        auto normalised_kernel = renormaliseKernel(
-            gaussian_kernels[dimension_number], indexValidity);
-
-        // Convolve signal with kernel
-        double sumSignal = 0;
-        double sumSquareError = 0;
-        double error = 0;
-        for (size_t i = 0; i < neighbourIndexes.size(); ++i) {
-          if (indexValidity[i]) {
-            sumSignal += read_ws->getSignalAt(neighbourIndexes[i]) *
-                         normalised_kernel[i];
-            error =
-                read_ws->getErrorAt(neighbourIndexes[i]) * normalised_kernel[i];
-            sumSquareError += error * error;
-          }
-
-          write_ws->setSignalAt(iteratorIndex, sumSignal);
-          write_ws->setErrorSquaredAt(iteratorIndex, sumSquareError);
-        }
-        progress.report();
-
-      } while (iterator->next());
-      PARALLEL_END_INTERUPT_REGION
+  const auto status = getBinStatus(*toSmooth, weightingWS);
+
+  signal_t *signal = outWS->getSignalArray();
+  signal_t *errorSquared = outWS->getErrorSquaredArray();
+  std::vector<double> used(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    used[i] = status[i] == BinStatus::Used ? 1. : 0.;
+    if (status[i] == BinStatus::Unmeasured) {
+      signal[i] = std::numeric_limits<double>::quiet_NaN();
+      errorSquared[i] = std::numeric_limits<double>::quiet_NaN();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
+  }
+  progress.report();
+
+  std::vector<double> values(nPoints);
+  std::vector<double> convolved(nPoints);
+  std::vector<double> kernelSum(nPoints);
+  size_t stride = 1;
+  for (size_t d = 0; d < nd; ++d) {
+    const size_t nBins = toSmooth->getDimension(d)->getNBins();
+    const KernelVector kernel = gaussianKernel(widthVector[d]);
+    KernelVector kernelSquared(kernel);
+    for (auto &value : kernelSquared)
+      value *= value;
+
+    // The sum of the kernel over the bins used, to renormalise it
+    interruption_point();
+    convolveDimension(used, kernelSum, kernel, stride, nBins);
+    progress.report();
+
+    // Convolve signal with kernel
+    for (size_t i = 0; i < nPoints; ++i)
+      values[i] = used[i] != 0. ? signal[i] : 0.;
+    convolveDimension(values, convolved, kernel, stride, nBins);
+    for (size_t i = 0; i < nPoints; ++i)
+      if (used[i] != 0.)
+        signal[i] = convolved[i] / kernelSum[i];
+    progress.report();
+
+    // The errors are convolved with the square of the kernel
+    interruption_point();
+    for (size_t i = 0; i < nPoints; ++i)
+      values[i] = used[i] != 0. ? errorSquared[i] : 0.;
+    convolveDimension(values, convolved, kernelSquared, stride, nBins);
+    for (size_t i = 0; i < nPoints; ++i)
+      if (used[i] != 0.)
+        errorSquared[i] = convolved[i] / (kernelSum[i] * kernelSum[i]);
+    progress.report();
+
+    stride *= nBins;
   }
 
-  return write_ws;
+  return outWS;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include "MantidGeometry/MDGeometry/QSample.h"
 #include "MantidKernel/WarningSuppressions.h"
 #include "MantidMDAlgorithms/BinMD.h"
+#include "MantidMDAlgorithms/BinMDCache.h"
 #include "MantidMDAlgorithms/CreateMDWorkspace.h"
 #include "MantidMDAlgorithms/FakeMDEventData.h"
 #include "MantidMDAlgorithms/LoadMD.h"
@@ -292,6 +293,132 @@ public:
                  true /*IterateEvents*/, 20 /*numEventsPerBox*/, VMD(0, 0, 1));
   }
 
+  void test_exec_parallel_is_same_as_serial() {
+    FrameworkManager::Instance().exec(
+        "CreateMDWorkspace", 16, "Dimensions", "2", "Extents", "-10,10,-10,10",
+        "Names", "x,y", "Units", "m,m", "SplitInto", "4", "SplitThreshold",
+        "100", "MaxRecursionDepth", "20", "OutputWorkspace", "BinMDTest_mdew");
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                      "BinMDTest_mdew", "UniformParams",
+                                      "20000", "RandomSeed", "1234");
+
+    // Rotated, so that the events go through the full affine transform
+    const char *parallel[] = {"0", "1"};
+    const char *names[] = {"BinMDTest_serial", "BinMDTest_parallel"};
+    for (size_t i = 0; i < 2; ++i)
+      FrameworkManager::Instance().exec(
+          "BinMD", 16, "InputWorkspace", "BinMDTest_mdew", "OutputWorkspace",
+          names[i], "AxisAligned", "0", "BasisVector0", "rx,m, 0.866025,0.5",
+          "BasisVector1", "ry,m, -0.5,0.866025", "OutputExtents",
+          "-10,10, -10,10", "OutputBins", "25,25", "Parallel", parallel[i]);
+
+    auto serial = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "BinMDTest_serial");
+    auto parallelWS =
+        AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+            "BinMDTest_parallel");
+    TS_ASSERT(serial);
+    TS_ASSERT(parallelWS);
+    if (!serial || !parallelWS)
+      return;
+    double total = 0.;
+    for (size_t i = 0; i < serial->getNPoints(); ++i) {
+      TS_ASSERT_DELTA(parallelWS->getSignalAt(i), serial->getSignalAt(i),
+                      1e-9);
+      TS_ASSERT_DELTA(parallelWS->getErrorAt(i), serial->getErrorAt(i), 1e-9);
+      TS_ASSERT_DELTA(parallelWS->getNumEventsAt(i), serial->getNumEventsAt(i),
+                      1e-9);
+      total += serial->getSignalAt(i);
+    }
+    // Some of the events are outside of the rotated region
+    TS_ASSERT_LESS_THAN(0., total);
+    TS_ASSERT_LESS_THAN(total, 20000.5);
+
+    AnalysisDataService::Instance().remove("BinMDTest_mdew");
+    AnalysisDataService::Instance().remove("BinMDTest_serial");
+    AnalysisDataService::Instance().remove("BinMDTest_parallel");
+  }
+
+  void test_exec_with_cache_is_same_as_without() {
+    FrameworkManager::Instance().exec(
+        "CreateMDWorkspace", 16, "Dimensions", "3", "Extents",
+        "-10,10,-10,10,-10,10", "Names", "x,y,z", "Units", "m,m,m", "SplitInto",
+        "4", "SplitThreshold", "100", "MaxRecursionDepth", "20",
+        "OutputWorkspace", "BinMDTest_mdew");
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                      "BinMDTest_mdew", "UniformParams",
+                                      "20000", "RandomSeed", "1234");
+    BinMDCache::Instance().clear();
+
+    // Step a slice along z, then widen and narrow it
+    const char *slices[] = {"z,-10,-6,1", "z,-8,-2,1", "z,-8,4,1",
+                            "z,-3,4,1", "z,-3.5,9.5,1"};
+    for (auto slice : slices) {
+      const char *useCache[] = {"0", "1"};
+      const char *names[] = {"BinMDTest_uncached", "BinMDTest_cached"};
+      for (size_t i = 0; i < 2; ++i)
+        FrameworkManager::Instance().exec(
+            "BinMD", 14, "InputWorkspace", "BinMDTest_mdew", "OutputWorkspace",
+            names[i], "AxisAligned", "1", "AlignedDim0", "x,-10,10,20",
+            "AlignedDim1", "y,-10,10,20", "AlignedDim2", slice, "UseCache",
+            useCache[i]);
+
+      auto uncached =
+          AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+              "BinMDTest_uncached");
+      auto cached =
+          AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+              "BinMDTest_cached");
+      TS_ASSERT(uncached);
+      TS_ASSERT(cached);
+      if (!uncached || !cached)
+        return;
+      for (size_t i = 0; i < uncached->getNPoints(); ++i) {
+        TS_ASSERT_DELTA(cached->getSignalAt(i), uncached->getSignalAt(i),
+                        1e-9);
+        TS_ASSERT_DELTA(cached->getErrorAt(i), uncached->getErrorAt(i), 1e-9);
+        TS_ASSERT_DELTA(cached->getNumEventsAt(i),
+                        uncached->getNumEventsAt(i), 1e-9);
+      }
+    }
+    // The histograms of the boxes were kept
+    TS_ASSERT_LESS_THAN(0, BinMDCache::Instance().getMemoryUsed());
+
+    BinMDCache::Instance().clear();
+    TS_ASSERT_EQUALS(BinMDCache::Instance().getMemoryUsed(), 0);
+    AnalysisDataService::Instance().remove("BinMDTest_mdew");
+    AnalysisDataService::Instance().remove("BinMDTest_uncached");
+    AnalysisDataService::Instance().remove("BinMDTest_cached");
+  }
+
+  void test_cache_is_dropped_when_the_workspace_is_replaced() {
+    FrameworkManager::Instance().exec(
+        "CreateMDWorkspace", 16, "Dimensions", "3", "Extents",
+        "-10,10,-10,10,-10,10", "Names", "x,y,z", "Units", "m,m,m", "SplitInto",
+        "4", "SplitThreshold", "100", "MaxRecursionDepth", "20",
+        "OutputWorkspace", "BinMDTest_mdew");
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                      "BinMDTest_mdew", "UniformParams",
+                                      "20000", "RandomSeed", "1234");
+    BinMDCache::Instance().clear();
+
+    const char *slices[] = {"z,-10,-6,1", "z,-8,-2,1", "z,-8,4,1"};
+    for (auto slice : slices)
+      FrameworkManager::Instance().exec(
+          "BinMD", 14, "InputWorkspace", "BinMDTest_mdew", "OutputWorkspace",
+          "BinMDTest_cached", "AxisAligned", "1", "AlignedDim0", "x,-10,10,20",
+          "AlignedDim1", "y,-10,10,20", "AlignedDim2", slice, "UseCache", "1");
+    TS_ASSERT_LESS_THAN(0, BinMDCache::Instance().getMemoryUsed());
+
+    // As an algorithm that modifies the workspace in place would do
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("BinMDTest_mdew", ads.retrieve("BinMDTest_mdew"));
+    TS_ASSERT_EQUALS(BinMDCache::Instance().getMemoryUsed(), 0);
+
+    ads.remove("BinMDTest_mdew");
+    ads.remove("BinMDTest_cached");
+  }
+
   bool etta(int x, int base) {
     int ii = x - base / 2;
     if (ii < 0)
@@ -1,7 +1,9 @@
 #ifndef MANTID_MD_CONVEVENTS2_Q_NDANY_TEST_H_
 #define MANTID_MD_CONVEVENTS2_Q_NDANY_TEST_H_
 
+#include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/Run.h"
 #include "MantidMDAlgorithms/ConvertToMD.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
@@ -65,6 +67,49 @@ public:
     AnalysisDataService::Instance().remove("testMDEvWorkspace");
   }
 
+  void test_multithreaded_conversion_is_identical_to_single_threaded() {
+    int numHist = 50;
+    auto wsEv = boost::dynamic_pointer_cast<MatrixWorkspace>(
+        WorkspaceCreationHelper::createRandomEventWorkspace(2000, numHist,
+                                                            0.1));
+    wsEv->setInstrument(
+        ComponentCreationHelper::createTestInstrumentCylindrical(numHist));
+    AnalysisDataService::Instance().addOrReplace("testManyEvWS", wsEv);
+
+    // NUM_THREADS = 0 disables multithreading, -1 uses all the cores
+    for (const double numThreads : {0., -1.}) {
+      wsEv->mutableRun().addProperty("NUM_THREADS", numThreads, true);
+      ConvertEvents2MDEvTestHelper alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", "testManyEvWS");
+      alg.setPropertyValue("OutputWorkspace", numThreads == 0.
+                                                  ? "testSingleThreadedMD"
+                                                  : "testMultiThreadedMD");
+      alg.setPropertyValue("QDimensions", "Q3D");
+      alg.setPropertyValue("dEAnalysisMode", "Elastic");
+      alg.setPropertyValue("MinValues", "-10,-10,-10");
+      alg.setPropertyValue("MaxValues", " 10, 10, 10");
+      alg.setPropertyValue("SplitThreshold", "100");
+      TS_ASSERT_THROWS_NOTHING(alg.execute());
+      TS_ASSERT(alg.isExecuted());
+    }
+
+    auto compare = AlgorithmManager::Instance().createUnmanaged(
+        "CompareMDWorkspaces");
+    compare->initialize();
+    compare->setChild(true);
+    compare->setPropertyValue("Workspace1", "testSingleThreadedMD");
+    compare->setPropertyValue("Workspace2", "testMultiThreadedMD");
+    compare->setProperty("CheckEvents", true);
+    TS_ASSERT_THROWS_NOTHING(compare->execute());
+    bool equals = compare->getProperty("Equals");
+    TS_ASSERT(equals);
+
+    AnalysisDataService::Instance().remove("testManyEvWS");
+    AnalysisDataService::Instance().remove("testSingleThreadedMD");
+    AnalysisDataService::Instance().remove("testMultiThreadedMD");
+  }
+
   ConvertEventsToMDTest() {
     FrameworkManager::Instance();
 
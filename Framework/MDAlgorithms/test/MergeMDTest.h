@@ -98,6 +98,30 @@ public:
     AnalysisDataService::Instance().remove(outWSName);
   }
 
+  void test_events_outside_of_the_output_are_omitted() {
+    // Name of the output workspace.
+    std::string outWSName("MergeMDTest_OutputWS");
+
+    // Add events on the upper boundary of the output extents, -5 to 20
+    auto ws2 = AnalysisDataService::Instance()
+                   .retrieveWS<MDEventWorkspace<MDLeanEvent<2>, 2>>("ws2");
+    coord_t upperEdge[2] = {20.f, 10.f};
+    coord_t upperCorner[2] = {20.f, 20.f};
+    ws2->addEvent(MDLeanEvent<2>(1.0, 1.0, upperEdge));
+    ws2->addEvent(MDLeanEvent<2>(1.0, 1.0, upperCorner));
+    ws2->refreshCache();
+    TS_ASSERT_EQUALS(ws2->getNPoints(), 10 * 10 + 2);
+
+    auto ws = execute_merge(outWSName); // cannot be nullptr
+
+    // Number of events is the sum of the 3 input ones, without the events on
+    // the boundary
+    TS_ASSERT_EQUALS(ws->getNPoints(), 2 * 2 + 6 * 6 + 10 * 10);
+
+    // Remove workspace from the data service.
+    AnalysisDataService::Instance().remove(outWSName);
+  }
+
   void test_masked_data_omitted() {
     // Name of the output workspace.
     std::string outWSName("MergeMDTest_OutputWS");
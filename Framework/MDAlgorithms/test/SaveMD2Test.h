@@ -41,6 +41,48 @@ public:
     do_test_exec(23, "SaveMD2Test_updating.nxs", true, true);
   }
 
+  void test_exec_compressed() {
+    MDEventWorkspace3Lean::sptr ws =
+        MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 3);
+    AnalysisDataService::Instance().addOrReplace("SaveMD2Test_ws", ws);
+
+    SaveMD2 alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("InputWorkspace", "SaveMD2Test_ws"));
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("Filename", "SaveMD2Test_compressed.nxs"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Compress", true));
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    std::string this_filename = alg.getProperty("Filename");
+
+    // The events read back are the same
+    LoadMD loader;
+    TS_ASSERT_THROWS_NOTHING(loader.initialize());
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("Filename", this_filename));
+    TS_ASSERT_THROWS_NOTHING(
+        loader.setPropertyValue("OutputWorkspace", "SaveMD2Test_loaded"));
+    loader.execute();
+    TS_ASSERT(loader.isExecuted());
+    auto loaded = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+        "SaveMD2Test_loaded");
+    TS_ASSERT(loaded);
+    if (loaded) {
+      TS_ASSERT_EQUALS(loaded->getNPoints(), ws->getNPoints());
+      auto compare = FrameworkManager::Instance().exec(
+          "CompareMDWorkspaces", 8, "Workspace1", "SaveMD2Test_ws",
+          "Workspace2", "SaveMD2Test_loaded", "CheckEvents", "1",
+          "IgnoreBoxID", "1");
+      TS_ASSERT_EQUALS(compare->getPropertyValue("Equals"), "1");
+    }
+
+    AnalysisDataService::Instance().remove("SaveMD2Test_ws");
+    AnalysisDataService::Instance().remove("SaveMD2Test_loaded");
+    if (Poco::File(this_filename).exists())
+      Poco::File(this_filename).remove();
+  }
+
   void do_test_exec(size_t numPerBox, std::string filename,
                     bool MakeFileBacked = false,
                     bool UpdateFileBackEnd = false) {
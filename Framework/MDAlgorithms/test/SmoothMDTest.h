@@ -480,6 +480,37 @@ public:
       TS_ASSERT_DELTA(expected_error[i], out->getErrorAt(i), 0.001);
     }
   }
+
+  void test_smooth_gaussian_with_normalization_guidance() {
+    auto toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        2.0 /*signal*/, 2 /*numDims*/, 5 /*numBins in each dimension*/);
+    toSmooth->setSignalAt(12, 100.0);
+
+    auto normWs = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        1.0 /*signal*/, 2 /*numDims*/, 5 /*numBins in each dimension*/);
+    normWs->setSignalAt(12, 0);
+
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    WidthVector widthVector(1, 3);
+    alg.setProperty("WidthVector", widthVector);
+    alg.setProperty("InputWorkspace", toSmooth);
+    alg.setProperty("InputNormalizationWorkspace", normWs);
+    alg.setProperty("Function", "Gaussian");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+
+    // The unmeasured central bin is left out of the smoothing of the others
+    for (size_t i = 0; i < out->getNPoints(); ++i) {
+      if (i == 12) {
+        TS_ASSERT(std::isnan(out->getSignalAt(i)));
+      } else {
+        TS_ASSERT_DELTA(2.0, out->getSignalAt(i), 1e-10);
+      }
+    }
+  }
 };
 
 class SmoothMDTestPerformance : public CxxTest::TestSuite {
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "MantidParallel/DllConfig.h"
+#include "MantidTypes/Core/DateAndTime.h"
 
 namespace Mantid {
 namespace Types {
@@ -18,7 +19,7 @@ class Communicator;
 namespace IO {
 
 /** Loader for event data from Nexus files with parallelism based on multiple
-  processes (MPI) for performance.
+  processes (MPI), or multiple threads in a single process, for performance.
 
   @author Simon Heybrock
   @date 2017
@@ -53,7 +54,12 @@ MANTID_PARALLEL_DLL void
 load(const Communicator &communicator, const std::string &filename,
      const std::string &groupName, const std::vector<std::string> &bankNames,
      const std::vector<int32_t> &bankOffsets,
-     std::vector<std::vector<Types::Event::TofEvent> *> eventLists);
+     std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+     const int numThreads = 1,
+     const Types::Core::DateAndTime &pulseTimeStart =
+         Types::Core::DateAndTime::minimum(),
+     const Types::Core::DateAndTime &pulseTimeStop =
+         Types::Core::DateAndTime::maximum());
 }
 
 } // namespace IO
@@ -9,6 +9,8 @@
 #include "MantidParallel/IO/NXEventDataLoader.h"
 #include "MantidParallel/IO/PulseTimeGenerator.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace Parallel {
 namespace IO {
@@ -87,6 +89,7 @@ void load(const Chunker &chunker, NXEventDataSource<TimeOffsetType> &dataSource,
     }
     dataSource.readEventID(event_id.data() + bufferOffset, range.eventOffset,
                            range.eventCount);
+    dataSink.checkEventIds(event_id.data() + bufferOffset, range);
     dataSource.readEventTimeOffset(event_time_offset.data() + bufferOffset,
                                    range.eventOffset, range.eventCount);
     if (previousBank != -1)
@@ -106,7 +109,9 @@ template <class TimeOffsetType>
 void load(const Communicator &comm, const H5::Group &group,
           const std::vector<std::string> &bankNames,
           const std::vector<int32_t> &bankOffsets,
-          std::vector<std::vector<Types::Event::TofEvent> *> eventLists) {
+          std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+          const int numThreads, const Types::Core::DateAndTime &pulseTimeStart,
+          const Types::Core::DateAndTime &pulseTimeStop) {
   // In tests loading from a single SSD this chunk size seems close to the
   // optimum. May need to be adjusted in the future (potentially dynamically)
   // when loading from parallel file systems and running on a cluster.
@@ -117,9 +122,15 @@ void load(const Communicator &comm, const H5::Group &group,
   // required when accessing the parallel file system.
   const Chunker chunker(comm.size(), comm.rank(),
                         readBankSizes(group, bankNames), chunkSize);
-  NXEventDataLoader<TimeOffsetType> loader(comm.size(), group, bankNames);
+  // Without MPI the data is partitioned by spectrum for parsing by one thread
+  // per partition instead. Reading stays sequential since HDF5 is not
+  // thread-safe.
+  const int partitions =
+      comm.size() == 1 ? std::max(numThreads, 1) : comm.size();
+  NXEventDataLoader<TimeOffsetType> loader(partitions, group, bankNames);
   EventParser<TimeOffsetType> consumer(comm, chunker.makeWorkerGroups(),
                                        bankOffsets, eventLists);
+  consumer.setPulseTimeRange(pulseTimeStart, pulseTimeStop);
   load<TimeOffsetType>(chunker, loader, consumer);
 }
 
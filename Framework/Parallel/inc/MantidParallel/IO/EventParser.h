@@ -24,7 +24,8 @@ namespace IO {
 
 /** Distributed (MPI) parsing of Nexus events from a data stream. Data is
 distributed accross MPI ranks for writing to event lists on the correct target
-rank.
+rank. In a single process the partitions of the data are instead written to the
+event lists by the threads of an OpenMP loop.
 
 @author Lamar Moore
 @date 2017
@@ -54,6 +55,9 @@ namespace detail {
 void MANTID_PARALLEL_DLL eventIdToGlobalSpectrumIndex(int32_t *event_id_start,
                                                       size_t count,
                                                       const int32_t bankOffset);
+void MANTID_PARALLEL_DLL checkEventIds(const int32_t *event_id_start,
+                                       size_t count, const int32_t bankOffset,
+                                       const size_t numSpectra);
 }
 
 template <class TimeOffsetType> class EventParser {
@@ -67,10 +71,14 @@ public:
   void setEventDataPartitioner(std::unique_ptr<
       AbstractEventDataPartitioner<TimeOffsetType>> partitioner);
   void setEventTimeOffsetUnit(const std::string &unit);
+  void setPulseTimeRange(const Types::Core::DateAndTime &start,
+                         const Types::Core::DateAndTime &stop);
 
   void startAsync(int32_t *event_id_start,
                   const TimeOffsetType *event_time_offset_start,
                   const Chunker::LoadRange &range);
+  void checkEventIds(const int32_t *event_id_start,
+                     const Chunker::LoadRange &range) const;
 
   void wait();
 
@@ -81,9 +89,14 @@ private:
 
   void redistributeDataMPI();
   void populateEventLists();
+  void populateEventLists(const std::vector<Event> &events,
+                          const int32_t partition, const int32_t partitions);
 
   // Default to 0 such that failure to set unit is easily detected.
   double m_timeOffsetScale{0.0};
+  Types::Core::DateAndTime m_pulseTimeStart{
+      Types::Core::DateAndTime::minimum()};
+  Types::Core::DateAndTime m_pulseTimeStop{Types::Core::DateAndTime::maximum()};
   Communicator m_comm;
   std::vector<std::vector<int>> m_rankGroups;
   std::vector<int32_t> m_bankOffsets;
@@ -153,14 +166,22 @@ void EventParser<TimeOffsetType>::setEventTimeOffsetUnit(
                            "` for event_time_offset");
 }
 
+/** Set the range of pulse times of events that are appended to the event
+ * lists. Events with pulse times outside [start, stop] are dropped. */
+template <class TimeOffsetType>
+void EventParser<TimeOffsetType>::setPulseTimeRange(
+    const Types::Core::DateAndTime &start,
+    const Types::Core::DateAndTime &stop) {
+  m_pulseTimeStart = start;
+  m_pulseTimeStop = stop;
+}
+
 /// Convert m_allRankData into m_thisRankData by means of redistribution via
-/// MPI.
+/// MPI. Without MPI all partitions belong to this rank and are used in place.
 template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::redistributeDataMPI() {
-  if (m_comm.size() == 1) {
-    m_thisRankData = m_allRankData.front();
+  if (m_comm.size() == 1)
     return;
-  }
 
   std::vector<int> sizes(m_allRankData.size());
   std::transform(m_allRankData.cbegin(), m_allRankData.cend(), sizes.begin(),
@@ -199,22 +220,66 @@ void EventParser<TimeOffsetType>::redistributeDataMPI() {
   Parallel::wait_all(recv_requests.begin(), recv_requests.end());
 }
 
-/// Append events in m_thisRankData to m_eventLists.
+/// Append events in m_thisRankData to m_eventLists, or, without MPI, the
+/// events of all partitions in m_allRankData in an OpenMP loop over the
+/// partitions.
 template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::populateEventLists() {
-  for (const auto &event : m_thisRankData) {
-    m_eventLists[event.index]->emplace_back(
-        m_timeOffsetScale * static_cast<double>(event.tof), event.pulseTime);
+  if (m_comm.size() != 1)
+    return populateEventLists(m_thisRankData, 0, 1);
+
+  // Partitions contain disjoint sets of spectra so the threads need no locking
+  // and the order of events, i.e., pulse-time order, is kept in every list.
+  // The caller sized the partitions from the threads it may use, so the loop
+  // runs one thread per partition.
+  const auto partitions = static_cast<int32_t>(m_allRankData.size());
+#pragma omp parallel for num_threads(partitions)
+  for (int32_t partition = 0; partition < partitions; ++partition)
+    populateEventLists(m_allRankData[partition], partition, partitions);
+}
+
+/** Append events of a partition to m_eventLists.
+ *
+ * @param events Events with index local to the partition.
+ * @param partition Index of the partition.
+ * @param partitions Number of partitions the data was split into. The index
+ * of the event list is `partitions * event.index + partition`.
+ */
+template <class TimeOffsetType>
+void EventParser<TimeOffsetType>::populateEventLists(
+    const std::vector<Event> &events, const int32_t partition,
+    const int32_t partitions) {
+  for (const auto &event : events) {
+    if (event.pulseTime < m_pulseTimeStart || event.pulseTime > m_pulseTimeStop)
+      continue;
+    auto &eventList = *m_eventLists[partitions * event.index + partition];
+    eventList.emplace_back(m_timeOffsetScale * static_cast<double>(event.tof),
+                           event.pulseTime);
     // In general `index` is random so this loop suffers from frequent cache
     // misses (probably because the hardware prefetchers cannot keep up with the
     // number of different memory locations that are getting accessed). We
     // manually prefetch into L2 cache to reduce the amount of misses.
-    _mm_prefetch(
-        reinterpret_cast<char *>(&m_eventLists[event.index]->back() + 1),
-        _MM_HINT_T1);
+    _mm_prefetch(reinterpret_cast<char *>(&eventList.back() + 1), _MM_HINT_T1);
   }
 }
 
+/** Throw if any of the given event IDs has no matching event list.
+ *
+ * Must be called before passing the same data to `startAsync`, since errors in
+ * the parsing thread cannot be reported. With MPI the event lists of other
+ * ranks are not known, so only single-process parsing is checked.
+ * @param event_id_start Buffer containing event IDs.
+ * @param range Bank and number of elements of the data in the buffer.
+ */
+template <class TimeOffsetType>
+void EventParser<TimeOffsetType>::checkEventIds(
+    const int32_t *event_id_start, const Chunker::LoadRange &range) const {
+  if (m_comm.size() != 1)
+    return;
+  detail::checkEventIds(event_id_start, range.eventCount,
+                        m_bankOffsets[range.bankIndex], m_eventLists.size());
+}
+
 /** Accepts raw data from file which has been pre-treated and sorted into chunks
  * for parsing. The parser extracts event data from the provided buffers,
  * separates then according to MPI ranks and then appends them to the workspace
@@ -33,16 +33,25 @@ makeAnyEventIdToBankMap(const std::string &filename,
   return idToBank;
 }
 
-/// Load events from given banks into event lists.
+/** Load events from given banks into event lists.
+ *
+ * In a single process (`comm.size() == 1`) the events are parsed and appended
+ * to the event lists by `numThreads` threads. With MPI every rank uses a single
+ * parsing thread. Only events with pulse times in [pulseTimeStart,
+ * pulseTimeStop] are appended to the event lists.
+ */
 void load(const Communicator &comm, const std::string &filename,
           const std::string &groupName,
           const std::vector<std::string> &bankNames,
           const std::vector<int32_t> &bankOffsets,
-          std::vector<std::vector<Types::Event::TofEvent> *> eventLists) {
+          std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+          const int numThreads, const Types::Core::DateAndTime &pulseTimeStart,
+          const Types::Core::DateAndTime &pulseTimeStop) {
   H5::H5File file(filename, H5F_ACC_RDONLY);
   H5::Group group = file.openGroup(groupName);
   load(readDataType(group, bankNames, "event_time_offset"), comm, group,
-       bankNames, bankOffsets, std::move(eventLists));
+       bankNames, bankOffsets, std::move(eventLists), numThreads,
+       pulseTimeStart, pulseTimeStop);
 }
 }
 
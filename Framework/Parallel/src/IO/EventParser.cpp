@@ -1,5 +1,9 @@
 #include "MantidParallel/IO/EventParser.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
 namespace Mantid {
 namespace Parallel {
 namespace IO {
@@ -21,6 +25,29 @@ void eventIdToGlobalSpectrumIndex(int32_t *event_id_start, size_t count,
     event_id_start[i] -= bankOffset;
 }
 
+/** Throw if event IDs would be transformed into invalid spectrum indices.
+ *
+ * @param event_id_start Starting position of chunk of data containing event
+ * IDs.
+ * @param count Number of items in data chunk
+ * @param bankOffset Offset between event ID and global spectrum index.
+ * @param numSpectra Number of spectra, i.e., the bound for spectrum indices.
+ */
+void checkEventIds(const int32_t *event_id_start, size_t count,
+                   const int32_t bankOffset, const size_t numSpectra) {
+  if (count == 0)
+    return;
+  const auto minmax =
+      std::minmax_element(event_id_start, event_id_start + count);
+  const int64_t min = static_cast<int64_t>(*minmax.first) - bankOffset;
+  const int64_t max = static_cast<int64_t>(*minmax.second) - bankOffset;
+  if (min < 0 || max >= static_cast<int64_t>(numSpectra))
+    throw std::runtime_error(
+        "EventParser: event ID " +
+        std::to_string(min < 0 ? *minmax.first : *minmax.second) +
+        " does not correspond to any spectrum");
+}
+
 } // namespace detail
 } // namespace IO
 } // namespace Parallel
@@ -84,12 +84,14 @@ private:
   size_t m_bank{0};
 };
 
-void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize) {
+void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize,
+                  const int numThreads) {
   const std::vector<size_t> bankSizes{111, 1111, 11111};
   Chunker chunker(comm.size(), comm.rank(), bankSizes, chunkSize);
   // FakeDataSource encodes information on bank and position in file into TOF
-  // and pulse times, such that we can verify correct mapping.
-  FakeDataSource dataSource(comm.size());
+  // and pulse times, such that we can verify correct mapping. Without MPI the
+  // data is partitioned for parsing by multiple threads.
+  FakeDataSource dataSource(comm.size() == 1 ? numThreads : comm.size());
   const std::vector<int32_t> bankOffsets{0, 12 * 77, 24 * 77};
   std::vector<std::vector<Types::Event::TofEvent>> eventLists(
       (3 * 77 + comm.size() - 1 - comm.rank()) / comm.size());
@@ -189,10 +191,35 @@ public:
     for (const size_t chunkSize : {37, 123, 1111}) {
       for (const auto threads : {1, 2, 3, 5, 7, 13}) {
         ParallelTestHelpers::ParallelRunner runner(threads);
-        runner.run(do_test_load, chunkSize);
+        runner.run(do_test_load, chunkSize, 1);
       }
     }
   }
+
+  void test_load_threads() {
+    for (const size_t chunkSize : {37, 123, 1111})
+      for (const auto threads : {2, 3, 5, 7, 13})
+        do_test_load(Communicator{}, chunkSize, threads);
+  }
+
+  void test_load_throws_for_event_id_without_event_list() {
+    const std::vector<size_t> bankSizes{111, 1111, 11111};
+    Communicator comm;
+    Chunker chunker(comm.size(), comm.rank(), bankSizes, 123);
+    FakeDataSource dataSource(2);
+    // The second bank has IDs beyond the last event list.
+    const std::vector<int32_t> bankOffsets{0, 0, 24 * 77};
+    std::vector<std::vector<Types::Event::TofEvent>> eventLists(3 * 77);
+    std::vector<std::vector<Types::Event::TofEvent> *> eventListPtrs;
+    for (auto &eventList : eventLists)
+      eventListPtrs.emplace_back(&eventList);
+    EventParser<int32_t> dataSink(comm, chunker.makeWorkerGroups(), bankOffsets,
+                                  eventListPtrs);
+    TS_ASSERT_THROWS_EQUALS(
+        (EventLoader::load<int32_t>(chunker, dataSource, dataSink)),
+        const std::runtime_error &e, std::string(e.what()),
+        "EventParser: event ID 1077 does not correspond to any spectrum");
+  }
 };
 
 #endif /* MANTID_PARALLEL_EVENTLOADERTEST_H_ */
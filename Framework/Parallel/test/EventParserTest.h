@@ -162,6 +162,78 @@ public:
     TS_ASSERT_EQUALS(eventId[3], eventIdCopy[3] - bankOffsets[0]);
   }
 
+  void testCheckEventIds() {
+    std::vector<int32_t> eventId{1001, 1002, 1004, 1004};
+    TS_ASSERT_THROWS_NOTHING(
+        detail::checkEventIds(eventId.data(), eventId.size(), 1000, 5));
+    TS_ASSERT_THROWS(
+        detail::checkEventIds(eventId.data(), eventId.size(), 1000, 4),
+        const std::runtime_error &);
+    TS_ASSERT_THROWS(
+        detail::checkEventIds(eventId.data(), eventId.size(), 1002, 5),
+        const std::runtime_error &);
+  }
+
+  void testPopulateEventListsWithThreads() {
+    std::vector<std::vector<TofEvent>> eventLists(10);
+    std::vector<std::vector<TofEvent> *> eventListPtrs;
+    for (auto &eventList : eventLists)
+      eventListPtrs.emplace_back(&eventList);
+    Parallel::Communicator comm;
+    EventParser<double> parser(comm, {}, {0}, eventListPtrs);
+    parser.setEventTimeOffsetUnit("microsecond");
+    // Three partitions, each populated by a separate thread.
+    PulseTimeGenerator<int32_t, int32_t> pulseTimes({0, 10}, {0, 1},
+                                                    "nanosecond", 0);
+    parser.setEventDataPartitioner(
+        Kernel::make_unique<EventDataPartitioner<int32_t, int32_t, double>>(
+            3, std::move(pulseTimes)));
+
+    std::vector<int32_t> eventId(20);
+    std::vector<double> eventTimeOffset(20);
+    for (size_t i = 0; i < eventId.size(); ++i) {
+      eventId[i] = static_cast<int32_t>((7 * i) % 10);
+      eventTimeOffset[i] = static_cast<double>(i);
+    }
+    const Chunker::LoadRange range{0, 0, eventId.size()};
+    parser.checkEventIds(eventId.data(), range);
+    parser.startAsync(eventId.data(), eventTimeOffset.data(), range);
+    parser.wait();
+
+    for (size_t index = 0; index < eventLists.size(); ++index) {
+      TS_ASSERT_EQUALS(eventLists[index].size(), 2);
+      for (const auto &event : eventLists[index])
+        TS_ASSERT_EQUALS(eventId[static_cast<size_t>(event.tof())],
+                         static_cast<int32_t>(index));
+      // Events are appended in order, with pulse times from event_index.
+      TS_ASSERT(eventLists[index][0].tof() < eventLists[index][1].tof());
+      TS_ASSERT_EQUALS(eventLists[index][0].pulseTime().totalNanoseconds(), 0);
+      TS_ASSERT_EQUALS(eventLists[index][1].pulseTime().totalNanoseconds(), 1);
+    }
+  }
+
+  void testSetPulseTimeRange() {
+    std::vector<TofEvent> eventList;
+    std::vector<std::vector<TofEvent> *> eventLists{&eventList};
+    Parallel::Communicator comm;
+    EventParser<double> parser(comm, {}, {0}, eventLists);
+    parser.setEventTimeOffsetUnit("microsecond");
+    PulseTimeGenerator<int32_t, int32_t> pulseTimes({0, 1, 2}, {0, 1, 2},
+                                                    "nanosecond", 0);
+    parser.setEventDataPartitioner(
+        Kernel::make_unique<EventDataPartitioner<int32_t, int32_t, double>>(
+            1, std::move(pulseTimes)));
+    parser.setPulseTimeRange(DateAndTime(1), DateAndTime(1));
+
+    std::vector<int32_t> eventId{0, 0, 0};
+    const std::vector<double> eventTimeOffset{0.5, 1.5, 2.5};
+    const Chunker::LoadRange range{0, 0, eventId.size()};
+    parser.startAsync(eventId.data(), eventTimeOffset.data(), range);
+    parser.wait();
+    TS_ASSERT_EQUALS(eventList.size(), 1);
+    TS_ASSERT_EQUALS(eventList[0].tof(), 1.5);
+  }
+
   void testExtractEventsFull() {
     anonymous::FakeParserDataGenerator<int32_t, int64_t, double> gen(1, 10, 5);
     auto event_id = gen.eventId(0);
@@ -51,6 +51,7 @@ protected:
 
 private:
   void init() override;
+  std::map<std::string, std::string> validateInputs() override;
   void exec() override;
 
   API::ITableWorkspace_sptr m_chunkingTable;
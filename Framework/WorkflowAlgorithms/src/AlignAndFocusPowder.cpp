@@ -10,6 +10,7 @@
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/InstrumentInfo.h"
@@ -39,8 +40,21 @@ DECLARE_ALGORITHM(AlignAndFocusPowder)
  */
 void AlignAndFocusPowder::init() {
   declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
-                      "InputWorkspace", "", Direction::Input),
-                  "The input workspace");
+                      "InputWorkspace", "", Direction::Input,
+                      PropertyMode::Optional),
+                  "The input workspace. Either this or Filename is required.");
+  declareProperty(Kernel::make_unique<FileProperty>(
+                      "Filename", "", FileProperty::OptionalLoad,
+                      std::vector<std::string>{"_event.nxs", ".nxs.h5",
+                                               ".nxs"}),
+                  "Event NeXus file to load and focus instead of "
+                  "InputWorkspace. It is loaded and focussed in chunks if "
+                  "MaxChunkSize is set.");
+  auto mustBePositive = boost::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("MaxChunkSize", EMPTY_DBL(), mustBePositive,
+                  "Memory for the events of a chunk of Filename, in GiB. The "
+                  "focussed chunks are summed.");
   declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
                       "OutputWorkspace", "", Direction::Output),
                   "The result of diffraction focussing of InputWorkspace");
@@ -207,6 +221,71 @@ AlignAndFocusPowder::getVecPropertyFromPmOrSelf(const std::string &name,
   return 0.0;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Validate the combination of properties
+ * @return map of property names to problems with them
+ */
+std::map<std::string, std::string> AlignAndFocusPowder::validateInputs() {
+  std::map<std::string, std::string> result;
+  if (isDefault("InputWorkspace") == isDefault("Filename"))
+    result["InputWorkspace"] = "Specify either InputWorkspace or Filename.";
+  if (!isDefault("MaxChunkSize") && isDefault("Filename"))
+    result["MaxChunkSize"] = "Can only be used together with Filename.";
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Load Filename in chunks of pulses with LoadEventNexus, focus each chunk
+ * with a child AlignAndFocusPowder and sum the results. Each chunk has the
+ * logs of its own pulses, so Plus also sums the proton charge and merges the
+ * time series logs. Only one chunk of events is held in memory at a time.
+ */
+void AlignAndFocusPowder::focusChunks() {
+  MatrixWorkspace_sptr result;
+  bool lastChunk = false;
+  for (int chunkNumber = 1; !lastChunk; ++chunkNumber) {
+    auto loader = createChildAlgorithm("LoadEventNexus");
+    loader->setPropertyValue("Filename", getPropertyValue("Filename"));
+    if (!isDefault("MaxChunkSize")) {
+      loader->setPropertyValue("MaxChunkSize",
+                               getPropertyValue("MaxChunkSize"));
+      loader->setProperty("ChunkNumber", chunkNumber);
+    }
+    loader->executeAsChildAlg();
+    lastChunk = loader->getProperty("LastChunk");
+    Workspace_sptr chunk = loader->getProperty("OutputWorkspace");
+
+    auto focus = createChildAlgorithm("AlignAndFocusPowder");
+    for (const auto property : getProperties()) {
+      const auto &name = property->name();
+      if (property->isDefault() || name == "InputWorkspace" ||
+          name == "OutputWorkspace" || name == "Filename" ||
+          name == "MaxChunkSize")
+        continue;
+      if (auto wsProperty = dynamic_cast<IWorkspaceProperty *>(property))
+        focus->setProperty(name, wsProperty->getWorkspace());
+      else
+        focus->setPropertyValue(name, property->value());
+    }
+    focus->setProperty("InputWorkspace", chunk);
+    focus->executeAsChildAlg();
+    MatrixWorkspace_sptr focussed = focus->getProperty("OutputWorkspace");
+
+    if (!result) {
+      result = focussed;
+      continue;
+    }
+    auto plusAlg = createChildAlgorithm("Plus");
+    plusAlg->setProperty("LHSWorkspace", result);
+    plusAlg->setProperty("RHSWorkspace", focussed);
+    plusAlg->setProperty("OutputWorkspace", result);
+    plusAlg->setProperty("ClearRHSWorkspace", true);
+    plusAlg->executeAsChildAlg();
+    result = plusAlg->getProperty("OutputWorkspace");
+  }
+  setProperty("OutputWorkspace", result);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Executes the algorithm
  *  @throw Exception::FileError If the grouping file cannot be opened or read
@@ -215,6 +294,11 @@ AlignAndFocusPowder::getVecPropertyFromPmOrSelf(const std::string &name,
  * successfully
  */
 void AlignAndFocusPowder::exec() {
+  if (!isDefault("Filename")) {
+    focusChunks();
+    return;
+  }
+
   // retrieve the properties
   m_inputW = getProperty("InputWorkspace");
   m_inputEW = boost::dynamic_pointer_cast<EventWorkspace>(m_inputW);
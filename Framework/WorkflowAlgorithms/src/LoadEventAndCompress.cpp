@@ -57,6 +57,11 @@ void LoadEventAndCompress::init() {
   copyProperty(algLoadEventNexus, "OutputWorkspace");
   copyProperty(algDetermineChunking, "MaxChunkSize");
   declareProperty("CompressTOFTolerance", .01);
+  declareProperty("CompressWhileLoading", false,
+                  "Compress the events of each bank while they are loaded "
+                  "instead of after loading each chunk. This needs much less "
+                  "memory, but the pulse times are lost before FilterBadPulses "
+                  "could use them, so it must be 0.");
 
   copyProperty(algLoadEventNexus, "FilterByTofMin");
   copyProperty(algLoadEventNexus, "FilterByTofMax");
@@ -103,6 +108,19 @@ void LoadEventAndCompress::init() {
   declareProperty("FilterBadPulses", 95., range);
 }
 
+/** Validate the combination of properties
+ * @return map of property names to problems with them
+ */
+std::map<std::string, std::string> LoadEventAndCompress::validateInputs() {
+  std::map<std::string, std::string> result;
+  const bool compressWhileLoading = getProperty("CompressWhileLoading");
+  const double filterBadPulses = getProperty("FilterBadPulses");
+  if (compressWhileLoading && filterBadPulses > 0.)
+    result["FilterBadPulses"] =
+        "Must be 0 with CompressWhileLoading, which drops the pulse times.";
+  return result;
+}
+
 /// @see DataProcessorAlgorithm::determineChunk(const std::string &)
 ITableWorkspace_sptr
 LoadEventAndCompress::determineChunk(const std::string &filename) {
@@ -150,6 +168,10 @@ MatrixWorkspace_sptr LoadEventAndCompress::loadChunk(const size_t rowIndex) {
                            getProperty("FilterMonByTimeStart"));
   alg->setProperty<double>("FilterMonByTimeStop",
                            getProperty("FilterMonByTimeStop"));
+  const bool compressWhileLoading = getProperty("CompressWhileLoading");
+  if (compressWhileLoading)
+    alg->setProperty<double>("CompressTolerance",
+                             getProperty("CompressTOFTolerance"));
 
   // set chunking information
   if (rowCount > 0.) {
@@ -185,6 +207,11 @@ LoadEventAndCompress::processChunk(API::MatrixWorkspace_sptr &wksp,
     eventWS = filterBadPulsesAlgo->getProperty("OutputWorkspace");
   }
 
+  // The events were compressed while they were loaded
+  const bool compressWhileLoading = getProperty("CompressWhileLoading");
+  if (compressWhileLoading)
+    return eventWS;
+
   auto compressEvents = createChildAlgorithm("CompressEvents");
   compressEvents->setProperty("InputWorkspace", eventWS);
   compressEvents->setProperty("OutputWorkspace", eventWS);
@@ -0,0 +1,76 @@
+#ifndef MANTID_WORKFLOWALGORITHMS_ALIGNANDFOCUSPOWDERTEST_H_
+#define MANTID_WORKFLOWALGORITHMS_ALIGNANDFOCUSPOWDERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Run.h"
+#include "MantidWorkflowAlgorithms/AlignAndFocusPowder.h"
+
+using Mantid::WorkflowAlgorithms::AlignAndFocusPowder;
+using namespace Mantid::API;
+
+class AlignAndFocusPowderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlignAndFocusPowderTest *createSuite() {
+    return new AlignAndFocusPowderTest();
+  }
+  static void destroySuite(AlignAndFocusPowderTest *suite) { delete suite; }
+
+  AlignAndFocusPowderTest() { FrameworkManager::Instance(); }
+
+  void test_Init() {
+    AlignAndFocusPowder alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT(alg.isInitialized());
+  }
+
+  void test_focus_in_chunks_keeps_the_logs_of_the_run() {
+    MatrixWorkspace_sptr single = focusFile(0.);
+    // 112266 events need about 0.005 GiB, so there are 3 chunks
+    MatrixWorkspace_sptr chunked = focusFile(0.002);
+    TS_ASSERT(single);
+    TS_ASSERT(chunked);
+    if (!single || !chunked)
+      return;
+
+    TS_ASSERT_DELTA(chunked->run().getProtonCharge(),
+                    single->run().getProtonCharge(), 1e-10);
+    TS_ASSERT_EQUALS(chunked->run().getLogData("proton_charge")->size(),
+                     single->run().getLogData("proton_charge")->size());
+
+    // The counts are summed over the chunks
+    double singleCounts = 0.;
+    double chunkedCounts = 0.;
+    for (size_t i = 0; i < single->getNumberHistograms(); ++i) {
+      for (const auto y : single->y(i))
+        singleCounts += y;
+      for (const auto y : chunked->y(i))
+        chunkedCounts += y;
+    }
+    TS_ASSERT_DELTA(chunkedCounts, singleCounts, 1e-6);
+  }
+
+private:
+  /// Focus CNCS_7860_event.nxs in chunks of maxChunkSize GiB, or in one pass
+  MatrixWorkspace_sptr focusFile(const double maxChunkSize) {
+    AlignAndFocusPowder alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    if (maxChunkSize > 0.)
+      alg.setProperty("MaxChunkSize", maxChunkSize);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setProperty("Dspacing", false);
+    alg.setPropertyValue("Params", "40000,100,70000");
+    alg.setProperty("PreserveEvents", false);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    return alg.getProperty("OutputWorkspace");
+  }
+};
+
+#endif /* MANTID_WORKFLOWALGORITHMS_ALIGNANDFOCUSPOWDERTEST_H_ */
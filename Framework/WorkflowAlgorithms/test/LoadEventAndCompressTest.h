@@ -91,6 +91,55 @@ public:
     AnalysisDataService::Instance().remove(WS_NAME_NO_CHUNKS);
     AnalysisDataService::Instance().remove(WS_NAME_CHUNKS);
   }
+
+  void test_compress_while_loading() {
+    const std::string FILENAME("ARCS_sim_event.nxs");
+    const std::string WS_NAME("LoadEventAndCompress_after_loading");
+    const std::string WS_NAME_WHILE_LOADING(
+        "LoadEventAndCompress_while_loading");
+
+    LoadEventAndCompress algAfterLoading;
+    algAfterLoading.initialize();
+    algAfterLoading.setPropertyValue("Filename", FILENAME);
+    algAfterLoading.setPropertyValue("OutputWorkspace", WS_NAME);
+    algAfterLoading.setProperty("FilterBadPulses", 0.);
+    TS_ASSERT_THROWS_NOTHING(algAfterLoading.execute());
+
+    LoadEventAndCompress algWhileLoading;
+    algWhileLoading.initialize();
+    algWhileLoading.setPropertyValue("Filename", FILENAME);
+    algWhileLoading.setPropertyValue("OutputWorkspace", WS_NAME_WHILE_LOADING);
+    algWhileLoading.setProperty("FilterBadPulses", 0.);
+    algWhileLoading.setProperty("CompressWhileLoading", true);
+    TS_ASSERT_THROWS_NOTHING(algWhileLoading.execute());
+
+    auto ws =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(WS_NAME);
+    auto wsWhileLoading =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            WS_NAME_WHILE_LOADING);
+    TS_ASSERT_EQUALS(wsWhileLoading->getEventType(),
+                     EventType::WEIGHTED_NOTIME);
+    TS_ASSERT_EQUALS(wsWhileLoading->getNumberEvents(),
+                     ws->getNumberEvents());
+    auto checkAlg = AlgorithmManager::Instance().create("CompareWorkspaces");
+    checkAlg->setPropertyValue("Workspace1", WS_NAME);
+    checkAlg->setPropertyValue("Workspace2", WS_NAME_WHILE_LOADING);
+    checkAlg->execute();
+    TS_ASSERT(checkAlg->getProperty("Result"));
+
+    AnalysisDataService::Instance().remove(WS_NAME);
+    AnalysisDataService::Instance().remove(WS_NAME_WHILE_LOADING);
+  }
+
+  void test_compress_while_loading_needs_no_pulse_filter() {
+    LoadEventAndCompress alg;
+    alg.initialize();
+    alg.setPropertyValue("Filename", "ARCS_sim_event.nxs");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.setProperty("CompressWhileLoading", true);
+    TS_ASSERT_THROWS(alg.execute(), std::runtime_error);
+  }
 };
 
 #endif /* MANTID_WORKFLOWALGORITHMS_LOADEVENTANDCOMPRESSTEST_H_ */